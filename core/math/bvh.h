@@ -47,9 +47,13 @@
 // implemented in GLES3 but not GLES2. Layer masks are not yet implemented for directional lights.
 
 #include "bvh_tree.h"
+#include "core/templates/thread_work_pool.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, 2, MAX_ITEMS, USE_PAIRS, Bounds, Point>
 
+// below this amount of changed items, threading the pair finding costs more than it saves
+#define BVH_THREADED_PAIRING_THRESHOLD 256
+
 template <class T, bool USE_PAIRS = false, int MAX_ITEMS = 32, class Bounds = AABB, class Point = Vector3>
 class BVH_Manager {
 public:
@@ -129,6 +133,23 @@ public:
 		move(h, p_aabb);
 	}
 
+	// moves a batch of items at once. Unlike calling move() for each item, the tree is
+	// refit only once at the end of the batch, which is much cheaper when lots of items move.
+	void move_bulk(const uint32_t *p_handles, const Bounds *p_aabbs, uint32_t p_count) {
+		for (uint32_t n = 0; n < p_count; n++) {
+			BVHHandle h;
+			h.set(p_handles[n]);
+
+			if (tree.item_move(h, p_aabbs[n], true)) {
+				if (USE_PAIRS) {
+					_add_changed_item(h, p_aabbs[n]);
+				}
+			}
+		}
+
+		tree.refit_deferred();
+	}
+
 	void erase(uint32_t p_handle) {
 		BVHHandle h;
 		h.set(p_handle);
@@ -218,6 +239,24 @@ public:
 	// these should be read as set_visible for render trees,
 	// but generically this makes items add or remove from the
 	// tree internally, to speed things up by ignoring inactive items
+	// recheck the pairs of every active item as if they had all just moved.
+	// This also resets the expanded pairing aabbs, so afterwards the pairs only
+	// depend on the current aabbs and not on how the items got there.
+	void force_collision_check_all(ThreadWorkPool *p_work_pool = nullptr) {
+		if (USE_PAIRS) {
+			for (uint32_t n = 0; n < tree._active_refs.size(); n++) {
+				BVHHandle h;
+				h.set_id(tree._active_refs[n]);
+
+				Bounds aabb;
+				item_get_AABB(h, aabb);
+				_add_changed_item(h, aabb, false);
+			}
+
+			_check_for_collisions(true, p_work_pool);
+		}
+	}
+
 	bool activate(BVHHandle p_handle, const Bounds &p_aabb, bool p_delay_collision_check = false) {
 		// sending the aabb here prevents the need for the BVH to maintain
 		// a redundant copy of the aabb.
@@ -263,9 +302,10 @@ public:
 	}
 
 	// call e.g. once per frame (this does a trickle optimize)
-	void update() {
+	// if a work pool is passed, the culling part of the pair finding is done on it
+	void update(ThreadWorkPool *p_work_pool = nullptr) {
 		tree.update();
-		_check_for_collisions();
+		_check_for_collisions(false, p_work_pool);
 #ifdef BVH_INTEGRITY_CHECKS
 		tree.integrity_check_all();
 #endif
@@ -388,13 +428,22 @@ public:
 
 private:
 	// do this after moving etc.
-	void _check_for_collisions(bool p_full_check = false) {
+	void _check_for_collisions(bool p_full_check = false, ThreadWorkPool *p_work_pool = nullptr) {
 		if (!changed_items.size()) {
 			// noop
 			return;
 		}
 
-		Bounds bb;
+		// culling only reads the tree, so with enough changed items it is done up front
+		// on the work pool. Pairing and callbacks are not thread safe and stay serial, in the
+		// same order as the single threaded path, so the results are identical.
+		bool threaded = USE_PAIRS && p_work_pool && (changed_items.size() >= BVH_THREADED_PAIRING_THRESHOLD);
+		if (threaded) {
+			if (_changed_item_hits.size() < changed_items.size()) {
+				_changed_item_hits.resize(changed_items.size());
+			}
+			p_work_pool->do_work(changed_items.size(), this, &BVH_Manager::_cull_changed_item, nullptr);
+		}
 
 		typename BVHTREE_CLASS::CullParams params;
 
@@ -419,18 +468,26 @@ private:
 
 			uint32_t changed_item_ref_id = h.id();
 
-			// set up the test from this item.
-			// this includes whether to test the non pairable tree,
-			// and the item mask.
-			tree.item_fill_cullparams(h, params);
+			const LocalVector<uint32_t, uint32_t, true> *hits;
+
+			if (threaded) {
+				hits = &_changed_item_hits[n];
+			} else {
+				// set up the test from this item.
+				// this includes whether to test the non pairable tree,
+				// and the item mask.
+				tree.item_fill_cullparams(h, params);
 
-			params.abb = abb;
+				params.abb = abb;
 
-			params.result_count_overall = 0; // might not be needed
-			tree.cull_aabb(params, false);
+				params.result_count_overall = 0; // might not be needed
+				tree.cull_aabb(params, false);
+
+				hits = &tree._cull_hits;
+			}
 
-			for (unsigned int i = 0; i < tree._cull_hits.size(); i++) {
-				uint32_t ref_id = tree._cull_hits[i];
+			for (unsigned int i = 0; i < hits->size(); i++) {
+				uint32_t ref_id = (*hits)[i];
 
 				// don't collide against ourself
 				if (ref_id == changed_item_ref_id) {
@@ -455,6 +512,23 @@ private:
 		_reset();
 	}
 
+	// called on the work pool, one changed item at a time
+	void _cull_changed_item(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_threadsafe(params, _changed_item_hits[p_index]);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, Bounds &r_aabb) {
 		BVHABB_CLASS abb;
@@ -680,6 +754,9 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick;
 
+	// hits of each changed item, when culling for pairs on a work pool
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _changed_item_hits;
+
 public:
 	BVH_Manager() {
 		_tick = 1; // start from 1 so items with 0 indicate never updated
@@ -31,7 +31,9 @@
 #include "rendering_device_vulkan.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "core/os/os.h"
 #include "core/templates/hashfuncs.h"
 #include "drivers/vulkan/vulkan_context.h"
@@ -4900,7 +4902,7 @@ RID RenderingDeviceVulkan::storage_buffer_create(uint32_t p_size_bytes, const Ve
 	Buffer buffer;
 	buffer.usage = p_usage;
 	uint32_t flags = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-	if (p_usage & STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT) {
+	if (p_usage & (STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT | STORAGE_BUFFER_USAGE_DRAW_INDIRECT)) {
 		flags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
 	}
 	Error err = _buffer_allocate(&buffer, p_size_bytes, flags, VMA_MEMORY_USAGE_GPU_ONLY);
@@ -6026,7 +6028,10 @@ RID RenderingDeviceVulkan::render_pipeline_create(RID p_shader, FramebufferForma
 	graphics_pipeline_create_info.pNext = nullptr;
 	graphics_pipeline_create_info.flags = 0;
 
-	Vector<VkPipelineShaderStageCreateInfo> pipeline_stages = shader->pipeline_stages;
+	// Copied into a buffer owned by this function (not shared with the shader), the lock is released
+	// while the pipeline is created and the shader may be freed meanwhile.
+	Vector<VkPipelineShaderStageCreateInfo> pipeline_stages;
+	pipeline_stages.append_array(shader->pipeline_stages);
 	Vector<VkSpecializationInfo> specialization_info;
 	Vector<Vector<VkSpecializationMapEntry>> specialization_map_entries;
 	Vector<uint32_t> specialization_constant_data;
@@ -6100,9 +6105,25 @@ RID RenderingDeviceVulkan::render_pipeline_create(RID p_shader, FramebufferForma
 	graphics_pipeline_create_info.basePipelineIndex = 0;
 
 	RenderPipeline pipeline;
-	VkResult err = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &graphics_pipeline_create_info, nullptr, &pipeline.pipeline);
+
+	// Creating a pipeline can take a long time and does not need external synchronization,
+	// so don't block other threads meanwhile (pipelines may be compiled in the background).
+	// The create info only references local data, and the shader modules and pipeline layout
+	// are not destroyed while render_pipelines_compiling is set (see _free_pending_resources()).
+	// The mutex is recursive, so this only lets other threads in if the caller doesn't hold it.
+	render_pipelines_compiling++;
+	_THREAD_SAFE_UNLOCK_
+	VkResult err = vkCreateGraphicsPipelines(device, pipeline_cache, 1, &graphics_pipeline_create_info, nullptr, &pipeline.pipeline);
+	_THREAD_SAFE_LOCK_
+	render_pipelines_compiling--;
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateGraphicsPipelines failed with error " + itos(err) + ".");
 
+	shader = shader_owner.getornull(p_shader);
+	if (!shader) {
+		vkDestroyPipeline(device, pipeline.pipeline, nullptr);
+		ERR_FAIL_V_MSG(RID(), "Shader was freed while creating the render pipeline.");
+	}
+
 	pipeline.set_formats = shader->set_formats;
 	pipeline.push_constant_stages = shader->push_constant.push_constants_vk_stage;
 	pipeline.pipeline_layout = shader->pipeline_layout;
@@ -6212,7 +6233,7 @@ RID RenderingDeviceVulkan::compute_pipeline_create(RID p_shader, const Vector<Pi
 	}
 
 	ComputePipeline pipeline;
-	VkResult err = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &compute_pipeline_create_info, nullptr, &pipeline.pipeline);
+	VkResult err = vkCreateComputePipelines(device, pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &pipeline.pipeline);
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateComputePipelines failed with error " + itos(err) + ".");
 
 	pipeline.set_formats = shader->set_formats;
@@ -7082,6 +7103,90 @@ void RenderingDeviceVulkan::draw_list_draw(DrawListID p_list, bool p_use_indices
 	}
 }
 
+void RenderingDeviceVulkan::draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	DrawList *dl = _get_draw_list_ptr(p_list);
+	ERR_FAIL_COND(!dl);
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(!dl->validation.active, "Submitted Draw Lists can no longer be modified.");
+#endif
+
+	Buffer *buffer = storage_buffer_owner.getornull(p_buffer);
+	ERR_FAIL_COND(!buffer);
+
+	ERR_FAIL_COND_MSG(!(buffer->usage & STORAGE_BUFFER_USAGE_DRAW_INDIRECT), "Buffer provided was not created to do indirect draws.");
+	ERR_FAIL_COND(p_draw_count == 0);
+
+	//arguments are VkDrawIndexedIndirectCommand (5 uints) or VkDrawIndirectCommand (4 uints)
+	uint32_t command_size = p_use_indices ? 20 : 16;
+	uint32_t stride = p_stride ? p_stride : command_size;
+	ERR_FAIL_COND_MSG(p_draw_count > 1 && (stride < command_size || (stride % 4) != 0), "Stride (" + itos(stride) + ") must be a multiple of 4 and at least the size of an indirect draw command (" + itos(command_size) + ").");
+	ERR_FAIL_COND_MSG(p_offset % 4 != 0, "Offset provided must be a multiple of 4.");
+	ERR_FAIL_COND_MSG(uint64_t(p_offset) + uint64_t(stride) * (p_draw_count - 1) + command_size > buffer->size, "Offset and draw count provided read past the end of buffer.");
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(!dl->validation.pipeline_active,
+			"No render pipeline was set before attempting to draw.");
+	if (dl->validation.pipeline_vertex_format != INVALID_ID) {
+		//pipeline uses vertices, validate format
+		ERR_FAIL_COND_MSG(dl->validation.vertex_format == INVALID_ID,
+				"No vertex array was bound, and render pipeline expects vertices.");
+		//make sure format is right
+		ERR_FAIL_COND_MSG(dl->validation.pipeline_vertex_format != dl->validation.vertex_format,
+				"The vertex format used to create the pipeline does not match the vertex format bound.");
+	}
+
+	if (dl->validation.pipeline_push_constant_size > 0) {
+		//using push constants, check that they were supplied
+		ERR_FAIL_COND_MSG(!dl->validation.pipeline_push_constant_supplied,
+				"The shader in this pipeline requires a push constant to be set before drawing, but it's not present.");
+	}
+
+#endif
+
+	//Bind descriptor sets
+
+	for (uint32_t i = 0; i < dl->state.set_count; i++) {
+		if (dl->state.sets[i].pipeline_expected_format == 0) {
+			continue; //nothing expected by this pipeline
+		}
+#ifdef DEBUG_ENABLED
+		if (dl->state.sets[i].pipeline_expected_format != dl->state.sets[i].uniform_set_format) {
+			if (dl->state.sets[i].uniform_set_format == 0) {
+				ERR_FAIL_MSG("Uniforms were never supplied for set (" + itos(i) + ") at the time of drawing, which are required by the pipeline");
+			} else if (uniform_set_owner.owns(dl->state.sets[i].uniform_set)) {
+				UniformSet *us = uniform_set_owner.getornull(dl->state.sets[i].uniform_set);
+				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + "):\n" + _shader_uniform_debug(us->shader_id, us->shader_set) + "\nare not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
+			} else {
+				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + ", which was was just freed) are not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
+			}
+		}
+#endif
+		if (!dl->state.sets[i].bound) {
+			//All good, see if this requires re-binding
+			vkCmdBindDescriptorSets(dl->command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dl->state.pipeline_layout, i, 1, &dl->state.sets[i].descriptor_set, 0, nullptr);
+			dl->state.sets[i].bound = true;
+		}
+	}
+
+	if (p_use_indices) {
+#ifdef DEBUG_ENABLED
+		ERR_FAIL_COND_MSG(!dl->validation.index_array_size,
+				"Draw command requested indices, but no index buffer was set.");
+
+		ERR_FAIL_COND_MSG(dl->validation.pipeline_uses_restart_indices != dl->validation.index_buffer_uses_restart_indices,
+				"The usage of restart indices in index buffer does not match the render primitive in the pipeline.");
+#endif
+		//index and instance counts come from the buffer, so they can't be validated here
+		vkCmdDrawIndexedIndirect(dl->command_buffer, buffer->buffer, p_offset, p_draw_count, stride);
+	} else {
+#ifdef DEBUG_ENABLED
+		ERR_FAIL_COND_MSG(dl->validation.pipeline_vertex_format == INVALID_ID,
+				"Draw command lacks indices, but pipeline format does not use vertices.");
+#endif
+		vkCmdDrawIndirect(dl->command_buffer, buffer->buffer, p_offset, p_draw_count, stride);
+	}
+}
+
 void RenderingDeviceVulkan::draw_list_enable_scissor(DrawListID p_list, const Rect2 &p_rect) {
 	DrawList *dl = _get_draw_list_ptr(p_list);
 
@@ -8237,8 +8342,8 @@ void RenderingDeviceVulkan::_free_pending_resources(int p_frame) {
 		frames[p_frame].buffer_views_to_dispose_of.pop_front();
 	}
 
-	//shaders
-	while (frames[p_frame].shaders_to_dispose_of.front()) {
+	//shaders, kept for a later frame if a pipeline may still be created from them (see render_pipeline_create())
+	while (render_pipelines_compiling == 0 && frames[p_frame].shaders_to_dispose_of.front()) {
 		Shader *shader = &frames[p_frame].shaders_to_dispose_of.front()->get();
 
 		//descriptor set layout for each set
@@ -8522,6 +8627,10 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context, bool p_local_de
 
 	max_descriptors_per_pool = GLOBAL_DEF("rendering/vulkan/descriptor_pools/max_descriptors_per_pool", 64);
 
+	if (local_device.is_null() && GLOBAL_DEF("rendering/vulkan/pipeline_cache/enable", true)) {
+		_load_pipeline_cache();
+	}
+
 	//check to make sure DescriptorPoolKey is good
 	static_assert(sizeof(uint64_t) * 3 >= UNIFORM_TYPE_MAX * sizeof(uint16_t));
 
@@ -8532,6 +8641,67 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context, bool p_local_de
 	compute_list = nullptr;
 }
 
+void RenderingDeviceVulkan::_load_pipeline_cache() {
+	VkPhysicalDeviceProperties props;
+	vkGetPhysicalDeviceProperties(context->get_physical_device(), &props);
+
+	// Pipelines created in previous runs, so they don't have to be compiled again.
+	pipeline_cache_path = "user://vulkan/pipelines." + String::hex_encode_buffer(props.pipelineCacheUUID, VK_UUID_SIZE) + ".cache";
+
+	Vector<uint8_t> data;
+	if (FileAccess::exists(pipeline_cache_path)) {
+		data = FileAccess::get_file_as_array(pipeline_cache_path);
+
+		// The header is validated by drivers as well, but some are known to crash on mismatching data.
+		bool valid = data.size() >= int(16 + VK_UUID_SIZE);
+		if (valid) {
+			const uint8_t *r = data.ptr();
+			valid = decode_uint32(r) >= 16 + VK_UUID_SIZE &&
+					decode_uint32(r + 4) == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+					decode_uint32(r + 8) == props.vendorID &&
+					decode_uint32(r + 12) == props.deviceID &&
+					memcmp(r + 16, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+		}
+		if (!valid) {
+			print_verbose("Ignoring invalid Vulkan pipeline cache: " + pipeline_cache_path);
+			data.clear();
+		}
+	}
+
+	VkPipelineCacheCreateInfo cache_info;
+	cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cache_info.pNext = nullptr;
+	cache_info.flags = 0;
+	cache_info.initialDataSize = data.size();
+	cache_info.pInitialData = data.ptr();
+
+	VkResult err = vkCreatePipelineCache(device, &cache_info, nullptr, &pipeline_cache);
+	if (err != VK_SUCCESS) {
+		pipeline_cache = VK_NULL_HANDLE;
+		ERR_FAIL_MSG("vkCreatePipelineCache failed with error " + itos(err) + ".");
+	}
+
+	print_verbose("Vulkan pipeline cache loaded " + itos(data.size()) + " bytes from: " + pipeline_cache_path);
+}
+
+void RenderingDeviceVulkan::_save_pipeline_cache() {
+	size_t size = 0;
+	VkResult err = vkGetPipelineCacheData(device, pipeline_cache, &size, nullptr);
+	ERR_FAIL_COND_MSG(err != VK_SUCCESS, "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+
+	Vector<uint8_t> data;
+	data.resize(size);
+	err = vkGetPipelineCacheData(device, pipeline_cache, &size, data.ptrw());
+	ERR_FAIL_COND_MSG(err != VK_SUCCESS, "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->make_dir_recursive(pipeline_cache_path.get_base_dir());
+
+	FileAccessRef f = FileAccess::open(pipeline_cache_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't save Vulkan pipeline cache to: " + pipeline_cache_path);
+	f->store_buffer(data.ptr(), size);
+}
+
 template <class T>
 void RenderingDeviceVulkan::_free_rids(T &p_owner, const char *p_type) {
 	List<RID> owned;
@@ -8736,6 +8906,12 @@ void RenderingDeviceVulkan::finalize() {
 
 	_flush(false);
 
+	if (pipeline_cache) {
+		_save_pipeline_cache();
+		vkDestroyPipelineCache(device, pipeline_cache, nullptr);
+		pipeline_cache = VK_NULL_HANDLE;
+	}
+
 	_free_rids(render_pipeline_owner, "Pipeline");
 	_free_rids(compute_pipeline_owner, "Compute");
 	_free_rids(uniform_set_owner, "UniformSet");
@@ -1014,6 +1014,13 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	VulkanContext *context = nullptr;
 
+	VkPipelineCache pipeline_cache = VK_NULL_HANDLE;
+	String pipeline_cache_path;
+	uint32_t render_pipelines_compiling = 0; // Pipelines being created without the lock held.
+
+	void _load_pipeline_cache();
+	void _save_pipeline_cache();
+
 	uint64_t image_memory = 0;
 	uint64_t buffer_memory = 0;
 
@@ -1141,6 +1148,7 @@ public:
 	virtual void draw_list_set_push_constant(DrawListID p_list, const void *p_data, uint32_t p_data_size);
 
 	virtual void draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances = 1, uint32_t p_procedural_vertices = 0);
+	virtual void draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset = 0, uint32_t p_draw_count = 1, uint32_t p_stride = 0);
 
 	virtual void draw_list_enable_scissor(DrawListID p_list, const Rect2 &p_rect);
 	virtual void draw_list_disable_scissor(DrawListID p_list);
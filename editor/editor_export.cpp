@@ -47,6 +47,7 @@
 #include "editor_node.h"
 #include "editor_settings.h"
 #include "scene/resources/resource_format_text.h"
+#include "servers/rendering/renderer_rd/shader_rd.h"
 
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
@@ -2002,3 +2003,22 @@ void EditorExportTextSceneToBinaryPlugin::_export_file(const String &p_path, con
 EditorExportTextSceneToBinaryPlugin::EditorExportTextSceneToBinaryPlugin() {
 	GLOBAL_DEF("editor/export/convert_text_resources_to_binary", false);
 }
+
+///////////////////////
+
+void EditorExportShaderCachePlugin::_export_begin(const Set<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+	bool export_pack = GLOBAL_GET("rendering/shader_compiler/shader_cache/export_prebuilt_pack");
+	if (!export_pack) {
+		return;
+	}
+
+	String shader_cache_dir = Engine::get_singleton()->get_shader_cache_path().plus_file("shader_cache");
+	if (!DirAccess::exists(shader_cache_dir)) {
+		return;
+	}
+
+	Vector<uint8_t> pack = ShaderRD::build_shader_cache_pack(shader_cache_dir);
+	if (pack.size()) {
+		add_file("res://.godot/shader_cache.pack", pack, false);
+	}
+}
@@ -475,4 +475,11 @@ public:
 	EditorExportTextSceneToBinaryPlugin();
 };
 
+class EditorExportShaderCachePlugin : public EditorExportPlugin {
+	GDCLASS(EditorExportShaderCachePlugin, EditorExportPlugin);
+
+public:
+	virtual void _export_begin(const Set<String> &p_features, bool p_debug, const String &p_path, int p_flags) override;
+};
+
 #endif // EDITOR_IMPORT_EXPORT_H
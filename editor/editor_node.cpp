@@ -6920,6 +6920,11 @@ EditorNode::EditorNode() {
 
 	EditorExport::get_singleton()->add_export_plugin(export_text_to_binary_plugin);
 
+	Ref<EditorExportShaderCachePlugin> export_shader_cache_plugin;
+	export_shader_cache_plugin.instantiate();
+
+	EditorExport::get_singleton()->add_export_plugin(export_shader_cache_plugin);
+
 	Ref<PackedSceneEditorTranslationParserPlugin> packed_scene_translation_parser_plugin;
 	packed_scene_translation_parser_plugin.instantiate();
 	EditorTranslationParser::get_singleton()->add_parser(packed_scene_translation_parser_plugin, EditorTranslationParser::STANDARD);
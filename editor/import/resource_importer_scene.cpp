@@ -180,6 +180,10 @@ bool ResourceImporterScene::get_option_visibility(const String &p_option, const
 		return false;
 	}
 
+	if ((p_option == "meshes/hlod/cluster_size" || p_option == "meshes/hlod/max_error") && !bool(p_options["meshes/hlod/generate"])) {
+		return false;
+	}
+
 	return true;
 }
 
@@ -1057,6 +1061,9 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/ensure_tangents"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/generate_lods"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/create_shadow_meshes"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/hlod/generate", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), false));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/hlod/cluster_size", PROPERTY_HINT_RANGE, "1,4096,0.1"), 64.0));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/hlod/max_error", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 0.1));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/light_baking", PROPERTY_HINT_ENUM, "Disabled,Dynamic,Static,Static Lightmaps", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 2));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/lightmap_texel_size", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 0.1));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "skins/use_named_skins"), true));
@@ -1145,6 +1152,7 @@ void ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_m
 		mesh_node->set_transform(src_mesh_node->get_transform());
 		mesh_node->set_skin(src_mesh_node->get_skin());
 		mesh_node->set_skeleton_path(src_mesh_node->get_skeleton_path());
+		mesh_node->set_visibility_parent(src_mesh_node->get_visibility_parent());
 		if (src_mesh_node->get_mesh().is_valid()) {
 			Ref<ArrayMesh> mesh;
 			if (!src_mesh_node->get_mesh()->has_mesh()) {
@@ -1290,6 +1298,284 @@ void ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_m
 	}
 }
 
+void ResourceImporterScene::_generate_hlods(Node *p_scene, float p_cluster_size, float p_max_error, bool p_generate_lods) {
+	if (!SurfaceTool::simplify_func || !SurfaceTool::simplify_scale_func) {
+		return;
+	}
+
+	struct Source {
+		EditorSceneImporterMeshNode3D *node = nullptr;
+		Transform3D xform; // Relative to the scene root.
+	};
+
+	// Nodes targeted by the imported animations move (or move their children), they can't be merged into a static proxy.
+	Set<Node *> animated_nodes;
+
+	List<Node *> queue;
+	queue.push_back(p_scene);
+	while (queue.size()) {
+		Node *node = queue.front()->get();
+		queue.pop_front();
+		for (int i = 0; i < node->get_child_count(); i++) {
+			queue.push_back(node->get_child(i));
+		}
+
+		AnimationPlayer *ap = Object::cast_to<AnimationPlayer>(node);
+		if (!ap) {
+			continue;
+		}
+		Node *anim_root = ap->get_node_or_null(ap->get_root());
+		if (!anim_root) {
+			continue;
+		}
+
+		List<StringName> anims;
+		ap->get_animation_list(&anims);
+		for (List<StringName>::Element *E = anims.front(); E; E = E->next()) {
+			Ref<Animation> anim = ap->get_animation(E->get());
+			for (int i = 0; i < anim->get_track_count(); i++) {
+				Node *target = anim_root->get_node_or_null(anim->track_get_path(i));
+				if (target) {
+					animated_nodes.insert(target);
+				}
+			}
+		}
+	}
+
+	// Bucket static meshes into a grid of clusters, by the center of their bounds.
+	Map<Vector3i, Vector<Source>> clusters;
+
+	queue.push_back(p_scene);
+	while (queue.size()) {
+		Node *node = queue.front()->get();
+		queue.pop_front();
+		for (int i = 0; i < node->get_child_count(); i++) {
+			queue.push_back(node->get_child(i));
+		}
+
+		EditorSceneImporterMeshNode3D *mesh_node = Object::cast_to<EditorSceneImporterMeshNode3D>(node);
+		if (!mesh_node || mesh_node->get_mesh().is_null() || mesh_node->get_skin().is_valid() || !mesh_node->get_skeleton_path().is_empty()) {
+			continue;
+		}
+
+		Ref<EditorSceneImporterMesh> mesh = mesh_node->get_mesh();
+		if (mesh->get_surface_count() == 0 || mesh->get_blend_shape_count() > 0) {
+			continue;
+		}
+
+		bool triangles = true;
+		AABB aabb;
+		for (int i = 0; i < mesh->get_surface_count(); i++) {
+			Array arrays = mesh->get_surface_arrays(i);
+			Vector<Vector3> vertices = arrays[Mesh::ARRAY_VERTEX];
+			Vector<int> indices = arrays[Mesh::ARRAY_INDEX];
+			if (mesh->get_surface_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES || indices.is_empty()) {
+				triangles = false;
+				break;
+			}
+			for (int j = 0; j < vertices.size(); j++) {
+				if (i == 0 && j == 0) {
+					aabb.position = vertices[j];
+				} else {
+					aabb.expand_to(vertices[j]);
+				}
+			}
+		}
+		if (!triangles) {
+			continue;
+		}
+
+		Source source;
+		source.node = mesh_node;
+		bool animated = false;
+		Node3D *n = mesh_node;
+		while (n && n != p_scene) {
+			if (animated_nodes.has(n)) {
+				animated = true;
+				break;
+			}
+			source.xform = n->get_transform() * source.xform;
+			n = n->get_parent_node_3d();
+		}
+		if (animated) {
+			continue;
+		}
+
+		Vector3 center = source.xform.xform(aabb.position + aabb.size * 0.5);
+		Vector3i cell = Vector3i((center / p_cluster_size).floor());
+		if (!clusters.has(cell)) {
+			clusters[cell] = Vector<Source>();
+		}
+		clusters[cell].push_back(source);
+	}
+
+	int proxy_count = 0;
+	for (Map<Vector3i, Vector<Source>>::Element *E = clusters.front(); E; E = E->next()) {
+		const Vector<Source> &sources = E->get();
+		if (sources.size() < 2) {
+			continue; // Nothing to merge.
+		}
+
+		Transform3D proxy_xform;
+		proxy_xform.origin = (Vector3(E->key()) + Vector3(0.5, 0.5, 0.5)) * p_cluster_size;
+		Transform3D proxy_xform_inv = proxy_xform.affine_inverse();
+
+		// One merged surface per material.
+		struct MergedSurface {
+			Ref<Material> material;
+			Vector<Vector3> vertices;
+			Vector<Vector3> normals;
+			Vector<float> tangents;
+			Vector<Vector2> uvs;
+			Vector<Vector2> uv2s;
+			Vector<Color> colors;
+			Vector<int> indices;
+			bool has_normals = true;
+			bool has_tangents = true;
+			bool has_uvs = true;
+			bool has_uv2s = true;
+			bool has_colors = true;
+		};
+		Vector<MergedSurface> merged;
+
+		for (int i = 0; i < sources.size(); i++) {
+			const Source &source = sources[i];
+			Ref<EditorSceneImporterMesh> mesh = source.node->get_mesh();
+			Transform3D xform = proxy_xform_inv * source.xform;
+			Basis normal_basis = xform.basis.inverse().transposed();
+
+			for (int j = 0; j < mesh->get_surface_count(); j++) {
+				Ref<Material> material = source.node->get_surface_material(j);
+				if (material.is_null()) {
+					material = mesh->get_surface_material(j);
+				}
+
+				int idx = -1;
+				for (int k = 0; k < merged.size(); k++) {
+					if (merged[k].material == material) {
+						idx = k;
+						break;
+					}
+				}
+				if (idx == -1) {
+					MergedSurface ms;
+					ms.material = material;
+					merged.push_back(ms);
+					idx = merged.size() - 1;
+				}
+				MergedSurface &ms = merged.write[idx];
+
+				Array arrays = mesh->get_surface_arrays(j);
+				Vector<Vector3> vertices = arrays[Mesh::ARRAY_VERTEX];
+				Vector<Vector3> normals = arrays[Mesh::ARRAY_NORMAL];
+				Vector<float> tangents = arrays[Mesh::ARRAY_TANGENT];
+				Vector<Vector2> uvs = arrays[Mesh::ARRAY_TEX_UV];
+				Vector<Vector2> uv2s = arrays[Mesh::ARRAY_TEX_UV2];
+				Vector<Color> colors = arrays[Mesh::ARRAY_COLOR];
+				Vector<int> indices = arrays[Mesh::ARRAY_INDEX];
+
+				int base = ms.vertices.size();
+				// Attributes missing from any source are dropped from the whole merged surface.
+				ms.has_normals = ms.has_normals && normals.size() == vertices.size();
+				ms.has_tangents = ms.has_tangents && tangents.size() == vertices.size() * 4;
+				ms.has_uvs = ms.has_uvs && uvs.size() == vertices.size();
+				ms.has_uv2s = ms.has_uv2s && uv2s.size() == vertices.size();
+				ms.has_colors = ms.has_colors && colors.size() == vertices.size();
+
+				for (int k = 0; k < vertices.size(); k++) {
+					ms.vertices.push_back(xform.xform(vertices[k]));
+					if (ms.has_normals) {
+						ms.normals.push_back(normal_basis.xform(normals[k]).normalized());
+					}
+					if (ms.has_tangents) {
+						Vector3 t = xform.basis.xform(Vector3(tangents[k * 4 + 0], tangents[k * 4 + 1], tangents[k * 4 + 2])).normalized();
+						ms.tangents.push_back(t.x);
+						ms.tangents.push_back(t.y);
+						ms.tangents.push_back(t.z);
+						ms.tangents.push_back(tangents[k * 4 + 3]);
+					}
+					if (ms.has_uvs) {
+						ms.uvs.push_back(uvs[k]);
+					}
+					if (ms.has_uv2s) {
+						ms.uv2s.push_back(uv2s[k]);
+					}
+					if (ms.has_colors) {
+						ms.colors.push_back(colors[k]);
+					}
+				}
+				for (int k = 0; k < indices.size(); k++) {
+					ms.indices.push_back(base + indices[k]);
+				}
+			}
+		}
+
+		Ref<EditorSceneImporterMesh> proxy_mesh;
+		proxy_mesh.instantiate();
+		float proxy_error = 0.0;
+
+		for (int i = 0; i < merged.size(); i++) {
+			const MergedSurface &ms = merged[i];
+			const Vector3 *vertices_ptr = ms.vertices.ptr();
+
+			// Simplify as far as the error budget allows, the proxy inherits the error actually reached.
+			float scale = SurfaceTool::simplify_scale_func((const float *)vertices_ptr, ms.vertices.size(), sizeof(Vector3));
+			float error = 0.0;
+			Vector<int> indices;
+			indices.resize(ms.indices.size());
+			size_t index_count = SurfaceTool::simplify_func((unsigned int *)indices.ptrw(), (const unsigned int *)ms.indices.ptr(), ms.indices.size(), (const float *)vertices_ptr, ms.vertices.size(), sizeof(Vector3), 0, p_max_error / scale, &error);
+			if (index_count == 0) {
+				continue;
+			}
+			indices.resize(index_count);
+			proxy_error = MAX(proxy_error, error * scale);
+
+			Array arrays;
+			arrays.resize(Mesh::ARRAY_MAX);
+			arrays[Mesh::ARRAY_VERTEX] = ms.vertices;
+			if (ms.has_normals) {
+				arrays[Mesh::ARRAY_NORMAL] = ms.normals;
+			}
+			if (ms.has_tangents) {
+				arrays[Mesh::ARRAY_TANGENT] = ms.tangents;
+			}
+			if (ms.has_uvs) {
+				arrays[Mesh::ARRAY_TEX_UV] = ms.uvs;
+			}
+			if (ms.has_uv2s) {
+				arrays[Mesh::ARRAY_TEX_UV2] = ms.uv2s;
+			}
+			if (ms.has_colors) {
+				arrays[Mesh::ARRAY_COLOR] = ms.colors;
+			}
+			arrays[Mesh::ARRAY_INDEX] = indices;
+
+			proxy_mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, arrays, Array(), Dictionary(), ms.material);
+		}
+
+		if (proxy_mesh->get_surface_count() == 0) {
+			continue;
+		}
+
+		if (p_generate_lods) {
+			proxy_mesh->generate_lods();
+		}
+
+		MeshInstance3D *proxy = memnew(MeshInstance3D);
+		proxy->set_name("HLOD" + itos(proxy_count++));
+		proxy->set_transform(proxy_xform);
+		proxy->set_mesh(proxy_mesh->get_mesh());
+		// A proxy that could not be simplified is exact, so it can take over right away.
+		proxy->set_visibility_range_hlod_error(MAX(proxy_error, CMP_EPSILON));
+		p_scene->add_child(proxy);
+		proxy->set_owner(p_scene);
+
+		for (int i = 0; i < sources.size(); i++) {
+			sources[i].node->set_visibility_parent(sources[i].node->get_path_to(proxy));
+		}
+	}
+}
+
 void ResourceImporterScene::_add_shapes(Node *p_node, const List<Ref<Shape3D>> &p_shapes) {
 	for (const List<Ref<Shape3D>>::Element *E = p_shapes.front(); E; E = E->next()) {
 		CollisionShape3D *cshape = memnew(CollisionShape3D);
@@ -1467,6 +1753,12 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 	if (subresources.has("meshes")) {
 		mesh_data = subresources["meshes"];
 	}
+	if (bool(p_options["meshes/hlod/generate"])) {
+		float cluster_size = p_options["meshes/hlod/cluster_size"];
+		float max_error = p_options["meshes/hlod/max_error"];
+		_generate_hlods(scene, MAX(cluster_size, 0.001f), MAX(max_error, 0.001f), gen_lods);
+	}
+
 	_generate_meshes(scene, mesh_data, gen_lods, create_shadow_meshes, LightBakeMode(light_bake_mode), lightmap_texel_size, src_lightmap_cache, mesh_lightmap_caches);
 
 	if (mesh_lightmap_caches.size()) {
@@ -231,6 +231,14 @@ int BulletPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> BulletPhysicsServer3D::space_save_state(RID p_space) const {
+	ERR_FAIL_V_MSG(Vector<uint8_t>(), "Saving the space state is not supported by Bullet.");
+}
+
+Error BulletPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Restoring the space state is not supported by Bullet.");
+}
+
 RID BulletPhysicsServer3D::area_create() {
 	AreaBullet *area = bulletnew(AreaBullet);
 	area->set_collision_layer(1);
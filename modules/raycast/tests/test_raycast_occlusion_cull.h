@@ -0,0 +1,113 @@
+/*************************************************************************/
+/*  test_raycast_occlusion_cull.h                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RAYCAST_OCCLUSION_CULL_H
+#define TEST_RAYCAST_OCCLUSION_CULL_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "modules/raycast/raycast_occlusion_cull.h"
+#include "servers/rendering/renderer_scene_occlusion_cull_raster.h"
+#include "tests/test_occlusion_cull_raster.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRaycastOcclusionCull {
+
+// City blocks seen from street level, with small objects scattered between them.
+static void benchmark_occlusion_cull(RendererSceneOcclusionCull *p_occlusion_cull, const char *p_name) {
+	TestOcclusionCullRaster::OcclusionTestScene scene(p_occlusion_cull, Size2i(256, 144));
+	RandomPCG rng(1234);
+
+	PackedVector3Array vertices;
+	for (int i = 0; i < 8; i++) {
+		vertices.push_back(Vector3((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5));
+	}
+	const int faces[6][4] = { { 0, 2, 6, 4 }, { 1, 5, 7, 3 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 1, 3, 2 }, { 4, 6, 7, 5 } };
+	PackedInt32Array indices;
+	for (int i = 0; i < 6; i++) {
+		const int quad[6] = { faces[i][0], faces[i][1], faces[i][2], faces[i][0], faces[i][2], faces[i][3] };
+		for (int j = 0; j < 6; j++) {
+			indices.push_back(quad[j]);
+		}
+	}
+
+	for (int x = -20; x <= 20; x++) {
+		for (int z = -40; z < 0; z++) {
+			Vector3 size = Vector3(4, 5 + rng.randf() * 15, 4);
+			scene.add_occluder(vertices, indices, Transform3D(Basis().scaled(size), Vector3(x * 10, size.y * 0.5, z * 10)));
+		}
+	}
+
+	LocalVector<AABB> objects;
+	for (int i = 0; i < 10000; i++) {
+		objects.push_back(AABB(Vector3(rng.randf() * 400 - 200, rng.randf() * 3, -rng.randf() * 400), Vector3(1, 1, 1)));
+	}
+
+	scene.cam_transform.origin = Vector3(0, 2, 5);
+
+	// The raycast implementation builds its BVH on a thread, give it time to finish before measuring.
+	for (int i = 0; i < 10; i++) {
+		scene.update();
+		OS::get_singleton()->delay_usec(100000);
+	}
+
+	const int frames = 60;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames; i++) {
+		scene.update();
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int occluded = 0;
+	for (uint32_t i = 0; i < objects.size(); i++) {
+		if (scene.is_occluded(objects[i])) {
+			occluded++;
+		}
+	}
+
+	MESSAGE(p_name, ": ", scene.occluders.size(), " occluders, ", occluded, " of ", objects.size(), " objects occluded, ", elapsed / frames, " usec per buffer update.");
+}
+
+// Benchmarks, run them with `--test --no-skip`.
+TEST_CASE_PENDING("[RaycastOcclusionCull] Benchmark against the software rasterizer") {
+	{
+		RaycastOcclusionCull occlusion_cull;
+		benchmark_occlusion_cull(&occlusion_cull, "Embree raycast");
+	}
+	{
+		RendererSceneOcclusionCullRaster occlusion_cull;
+		benchmark_occlusion_cull(&occlusion_cull, "Software rasterizer");
+	}
+}
+
+} // namespace TestRaycastOcclusionCull
+
+#endif // TEST_RAYCAST_OCCLUSION_CULL_H
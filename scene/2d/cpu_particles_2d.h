@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_2D_H
 #define CPU_PARTICLES_2D_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "scene/2d/node_2d.h"
 #include "scene/resources/texture.h"
@@ -111,6 +112,29 @@ private:
 	Vector<float> particle_data;
 	Vector<int> particle_order;
 
+	enum {
+		PARALLEL_PROCESS_MIN_PARTICLES = 2048, // Smaller systems are cheaper to process on the calling thread.
+		PROCESS_CHUNK_SIZE = 256,
+	};
+
+	enum ParticleStep {
+		PARTICLE_STEP_NONE,
+		PARTICLE_STEP_EMIT,
+		PARTICLE_STEP_EXPIRE,
+		PARTICLE_STEP_UPDATE,
+	};
+
+	// What each particle does in the current process step, decided before processing them in parallel.
+	LocalVector<uint8_t> particle_steps;
+	LocalVector<float> particle_deltas;
+	Transform2D process_emission_xform;
+
+	struct ParticleDataFill {
+		const Particle *particles = nullptr;
+		const int *order = nullptr;
+		float *data = nullptr;
+	};
+
 	struct SortLifetime {
 		const Particle *particles = nullptr;
 
@@ -173,7 +197,10 @@ private:
 
 	void _update_internal();
 	void _particles_process(float p_delta);
+	void _particles_process_chunk(uint32_t p_chunk, Particle *p_particles);
+	void _particle_process(Particle &p, uint8_t p_step, float p_delta);
 	void _update_particle_data_buffer();
+	void _fill_particle_data_chunk(uint32_t p_chunk, const ParticleDataFill *p_fill);
 
 	Mutex update_mutex;
 
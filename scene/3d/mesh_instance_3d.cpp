@@ -33,6 +33,7 @@
 #include "collision_shape_3d.h"
 #include "core/core_string_names.h"
 #include "physics_body_3d.h"
+#include "scene/main/scene_tree.h"
 #include "scene/resources/material.h"
 #include "skeleton_3d.h"
 
@@ -436,6 +437,153 @@ void MeshInstance3D::create_debug_tangents() {
 	}
 }
 
+void MeshInstance3D::_skin_vertices_chunk(uint32_t p_chunk, const SkinningData *p_data) {
+	uint32_t from = p_chunk * SKINNING_CHUNK_SIZE;
+	uint32_t to = MIN(from + SKINNING_CHUNK_SIZE, p_data->vertex_count);
+	uint32_t bpv = p_data->bones_per_vertex;
+
+	for (uint32_t i = from; i < to; i++) {
+		const int *bones = &p_data->bones[i * bpv];
+		const float *weights = &p_data->weights[i * bpv];
+
+		Transform3D xform;
+		xform.basis = Basis(Vector3(), Vector3(), Vector3());
+		for (uint32_t j = 0; j < bpv; j++) {
+			if (weights[j] == 0.0 || uint32_t(bones[j]) >= p_data->transform_count) {
+				continue;
+			}
+			const Transform3D &bone_xform = p_data->transforms[bones[j]];
+			xform.basis.elements[0] += bone_xform.basis.elements[0] * weights[j];
+			xform.basis.elements[1] += bone_xform.basis.elements[1] * weights[j];
+			xform.basis.elements[2] += bone_xform.basis.elements[2] * weights[j];
+			xform.origin += bone_xform.origin * weights[j];
+		}
+
+		p_data->vertices[i] = xform.xform(p_data->src_vertices[i]);
+		if (p_data->normals) {
+			p_data->normals[i] = xform.basis.xform(p_data->src_normals[i]).normalized();
+		}
+		if (p_data->tangents) {
+			const float *src = &p_data->src_tangents[i * 4];
+			Vector3 tangent = xform.basis.xform(Vector3(src[0], src[1], src[2])).normalized();
+			float *dst = &p_data->tangents[i * 4];
+			dst[0] = tangent.x;
+			dst[1] = tangent.y;
+			dst[2] = tangent.z;
+			dst[3] = src[3];
+		}
+	}
+}
+
+Ref<ArrayMesh> MeshInstance3D::bake_mesh_from_current_skeleton_pose(const Ref<ArrayMesh> &p_existing) {
+	ERR_FAIL_COND_V_MSG(mesh.is_null(), Ref<ArrayMesh>(), "Mesh is null.");
+	ERR_FAIL_COND_V_MSG(skin_ref.is_null(), Ref<ArrayMesh>(), "Skin is not set up, make sure the node is inside the tree and has a valid skeleton.");
+
+	Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(get_node_or_null(skeleton_path));
+	ERR_FAIL_COND_V_MSG(!skeleton, Ref<ArrayMesh>(), "Skeleton not found.");
+
+	Ref<Skin> skin_res = skin_ref->get_skin();
+	ERR_FAIL_COND_V(skin_res.is_null(), Ref<ArrayMesh>());
+
+	// Same bind resolution as the skeleton uses for the RenderingServer skin.
+	int bind_count = skin_res->get_bind_count();
+	Vector<Transform3D> transforms;
+	transforms.resize(bind_count);
+	Transform3D *transformsw = transforms.ptrw();
+	for (int i = 0; i < bind_count; i++) {
+		int bone = -1;
+		StringName bind_name = skin_res->get_bind_name(i);
+		if (bind_name != StringName()) {
+			bone = skeleton->find_bone(bind_name);
+		} else {
+			bone = skin_res->get_bind_bone(i);
+		}
+
+		if (bone < 0 || bone >= skeleton->get_bone_count()) {
+			transformsw[i] = Transform3D();
+		} else {
+			transformsw[i] = skeleton->get_bone_global_pose(bone) * skin_res->get_bind_pose(i);
+		}
+	}
+
+	Ref<ArrayMesh> baked = p_existing;
+	if (baked.is_valid()) {
+		baked->clear_surfaces();
+	} else {
+		baked.instantiate();
+	}
+
+	for (int s = 0; s < mesh->get_surface_count(); s++) {
+		Array arrays = mesh->surface_get_arrays(s);
+		Vector<int> bones = arrays[Mesh::ARRAY_BONES];
+		Vector<float> weights = arrays[Mesh::ARRAY_WEIGHTS];
+		Vector<Vector3> src_vertices = arrays[Mesh::ARRAY_VERTEX];
+
+		uint32_t bones_per_vertex = (mesh->surface_get_format(s) & Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS) ? 8 : 4;
+		uint32_t vertex_count = src_vertices.size();
+
+		if (vertex_count > 0 && bones.size() == int(vertex_count * bones_per_vertex) && weights.size() == bones.size()) {
+			Vector<Vector3> src_normals = arrays[Mesh::ARRAY_NORMAL];
+			Vector<float> src_tangents = arrays[Mesh::ARRAY_TANGENT];
+			Vector<Vector3> vertices;
+			Vector<Vector3> normals;
+			Vector<float> tangents;
+			vertices.resize(vertex_count);
+
+			SkinningData data;
+			data.transforms = transforms.ptr();
+			data.transform_count = bind_count;
+			data.bones_per_vertex = bones_per_vertex;
+			data.vertex_count = vertex_count;
+			data.bones = bones.ptr();
+			data.weights = weights.ptr();
+			data.src_vertices = src_vertices.ptr();
+			data.vertices = vertices.ptrw();
+			if (src_normals.size() == int(vertex_count)) {
+				normals.resize(vertex_count);
+				data.src_normals = src_normals.ptr();
+				data.normals = normals.ptrw();
+			}
+			if (src_tangents.size() == int(vertex_count * 4)) {
+				tangents.resize(vertex_count * 4);
+				data.src_tangents = src_tangents.ptr();
+				data.tangents = tangents.ptrw();
+			}
+
+			uint32_t chunk_count = (vertex_count + SKINNING_CHUNK_SIZE - 1) / SKINNING_CHUNK_SIZE;
+			ThreadWorkPool *work_pool = nullptr;
+			if (vertex_count >= PARALLEL_SKINNING_MIN_VERTICES && is_inside_tree()) {
+				work_pool = get_tree()->get_thread_work_pool();
+			}
+
+			if (work_pool) {
+				work_pool->do_work(chunk_count, this, &MeshInstance3D::_skin_vertices_chunk, (const SkinningData *)&data);
+			} else {
+				for (uint32_t i = 0; i < chunk_count; i++) {
+					_skin_vertices_chunk(i, &data);
+				}
+			}
+
+			arrays[Mesh::ARRAY_VERTEX] = vertices;
+			if (data.normals) {
+				arrays[Mesh::ARRAY_NORMAL] = normals;
+			}
+			if (data.tangents) {
+				arrays[Mesh::ARRAY_TANGENT] = tangents;
+			}
+		}
+
+		// The result is already posed, so it must not be skinned again.
+		arrays[Mesh::ARRAY_BONES] = Variant();
+		arrays[Mesh::ARRAY_WEIGHTS] = Variant();
+
+		baked->add_surface_from_arrays(mesh->surface_get_primitive_type(s), arrays);
+		baked->surface_set_material(s, get_active_material(s));
+	}
+
+	return baked;
+}
+
 void MeshInstance3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_mesh", "mesh"), &MeshInstance3D::set_mesh);
 	ClassDB::bind_method(D_METHOD("get_mesh"), &MeshInstance3D::get_mesh);
@@ -459,6 +607,8 @@ void MeshInstance3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_debug_tangents"), &MeshInstance3D::create_debug_tangents);
 	ClassDB::set_method_flags("MeshInstance3D", "create_debug_tangents", METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 
+	ClassDB::bind_method(D_METHOD("bake_mesh_from_current_skeleton_pose", "existing"), &MeshInstance3D::bake_mesh_from_current_skeleton_pose, DEFVAL(Ref<ArrayMesh>()));
+
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "mesh", PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_mesh", "get_mesh");
 	ADD_GROUP("Skeleton", "");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "skin", PROPERTY_HINT_RESOURCE_TYPE, "Skin"), "set_skin", "get_skin");
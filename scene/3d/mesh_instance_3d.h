@@ -57,6 +57,30 @@ protected:
 	void _mesh_changed();
 	void _resolve_skeleton_path();
 
+	enum {
+		PARALLEL_SKINNING_MIN_VERTICES = 4096, // Smaller surfaces are cheaper to skin on the calling thread.
+		SKINNING_CHUNK_SIZE = 1024,
+	};
+
+	struct SkinningData {
+		const Transform3D *transforms = nullptr;
+		uint32_t transform_count = 0;
+		uint32_t bones_per_vertex = 4;
+		uint32_t vertex_count = 0;
+
+		const int *bones = nullptr;
+		const float *weights = nullptr;
+		const Vector3 *src_vertices = nullptr;
+		const Vector3 *src_normals = nullptr;
+		const float *src_tangents = nullptr;
+
+		Vector3 *vertices = nullptr;
+		Vector3 *normals = nullptr;
+		float *tangents = nullptr;
+	};
+
+	void _skin_vertices_chunk(uint32_t p_chunk, const SkinningData *p_data);
+
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
 	bool _get(const StringName &p_name, Variant &r_ret) const;
@@ -91,6 +115,8 @@ public:
 
 	void create_debug_tangents();
 
+	Ref<ArrayMesh> bake_mesh_from_current_skeleton_pose(const Ref<ArrayMesh> &p_existing = Ref<ArrayMesh>());
+
 	virtual AABB get_aabb() const override;
 	virtual Vector<Face3> get_faces(uint32_t p_usage_flags) const override;
 
@@ -76,13 +76,21 @@ Node3DGizmo::Node3DGizmo() {
 
 void Node3D::_notify_dirty() {
 #ifdef TOOLS_ENABLED
-	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
+	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification) {
 #else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
-
+	if (data.notify_transform && !data.ignore_notification) {
 #endif
-		get_tree()->xform_change_list.add(&xform_change);
+		_add_to_xform_change_list(get_tree());
+	}
+}
+
+void Node3D::_add_to_xform_change_list(SceneTree *p_tree) {
+	// The list is shared by every sub-thread process group, so membership must be checked under the lock.
+	p_tree->xform_change_lock.lock();
+	if (!xform_change.in_list()) {
+		p_tree->xform_change_list.add(&xform_change);
 	}
+	p_tree->xform_change_lock.unlock();
 }
 
 void Node3D::_update_local_transform() const {
@@ -96,27 +104,32 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		return;
 	}
 
-	/*
-	if (data.dirty&DIRTY_GLOBAL)
-		return; //already dirty
-	*/
+	SceneTree *tree = get_tree();
+
+	// If the global transform is already dirty since the last transform flush, the whole subtree
+	// was already invalidated and queued, so there is no need to walk it again. Delivering
+	// NOTIFICATION_TRANSFORM_CHANGED to a descendant resets the pass, so it gets queued again.
+	bool subtree_dirty = (data.dirty & DIRTY_GLOBAL) && data.propagation_pass == tree->xform_change_pass;
 
 	data.children_lock++;
 
-	for (List<Node3D *>::Element *E = data.children.front(); E; E = E->next()) {
-		if (E->get()->data.top_level_active) {
-			continue; //don't propagate to a top_level
+	if (!subtree_dirty) {
+		for (List<Node3D *>::Element *E = data.children.front(); E; E = E->next()) {
+			if (E->get()->data.top_level_active) {
+				continue; //don't propagate to a top_level
+			}
+			E->get()->_propagate_transform_changed(p_origin);
 		}
-		E->get()->_propagate_transform_changed(p_origin);
 	}
 #ifdef TOOLS_ENABLED
-	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
+	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification) {
 #else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
+	if (data.notify_transform && !data.ignore_notification) {
 #endif
-		get_tree()->xform_change_list.add(&xform_change);
+		_add_to_xform_change_list(tree);
 	}
 	data.dirty |= DIRTY_GLOBAL;
+	data.propagation_pass = tree->xform_change_pass;
 
 	data.children_lock--;
 }
@@ -154,9 +167,11 @@ void Node3D::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 			notification(NOTIFICATION_EXIT_WORLD, true);
+			get_tree()->xform_change_lock.lock();
 			if (xform_change.in_list()) {
 				get_tree()->xform_change_list.remove(&xform_change);
 			}
+			get_tree()->xform_change_lock.unlock();
 			if (data.C) {
 				data.parent->data.children.erase(data.C);
 			}
@@ -214,6 +229,16 @@ void Node3D::_notification(int p_what) {
 		} break;
 
 		case NOTIFICATION_TRANSFORM_CHANGED: {
+			// This node left the change list, so the ancestors that skip their subtree walk while
+			// dirty must walk it again on the next move, or this node would not be queued again.
+			if (is_inside_tree()) {
+				uint64_t pass = get_tree()->xform_change_pass;
+				Node3D *n = this;
+				while (n && n->data.propagation_pass == pass) {
+					n->data.propagation_pass = 0;
+					n = n->data.top_level_active ? nullptr : n->data.parent;
+				}
+			}
 #ifdef TOOLS_ENABLED
 			if (data.gizmo.is_valid()) {
 				data.gizmo->transform();
@@ -665,6 +690,10 @@ Vector3 Node3D::to_global(Vector3 p_local) const {
 
 void Node3D::set_notify_transform(bool p_enable) {
 	data.notify_transform = p_enable;
+	if (p_enable && is_inside_tree() && (data.dirty & DIRTY_GLOBAL)) {
+		// Propagation may skip this node while its global transform stays dirty, queue it now.
+		_notify_dirty();
+	}
 }
 
 bool Node3D::is_transform_notification_enabled() const {
@@ -681,10 +710,14 @@ bool Node3D::is_local_transform_notification_enabled() const {
 
 void Node3D::force_update_transform() {
 	ERR_FAIL_COND(!is_inside_tree());
+	SceneTree *tree = get_tree();
+	tree->xform_change_lock.lock();
 	if (!xform_change.in_list()) {
+		tree->xform_change_lock.unlock();
 		return; //nothing to update
 	}
-	get_tree()->xform_change_list.remove(&xform_change);
+	tree->xform_change_list.remove(&xform_change);
+	tree->xform_change_lock.unlock();
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
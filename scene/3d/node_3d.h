@@ -68,6 +68,7 @@ class Node3D : public Node {
 		mutable Vector3 scale = Vector3(1, 1, 1);
 
 		mutable int dirty = DIRTY_NONE;
+		uint64_t propagation_pass = 0; // SceneTree transform flush pass in which DIRTY_GLOBAL was last propagated.
 
 		Viewport *viewport = nullptr;
 
@@ -101,6 +102,7 @@ class Node3D : public Node {
 
 	void _update_gizmo();
 	void _notify_dirty();
+	void _add_to_xform_change_list(SceneTree *p_tree);
 	void _propagate_transform_changed(Node3D *p_origin);
 
 	void _propagate_visibility_changed();
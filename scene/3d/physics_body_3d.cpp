@@ -598,7 +598,9 @@ void RigidBody3D::_direct_state_changed(Object *p_state) {
 #endif
 
 	set_ignore_transform_notification(true);
-	set_global_transform(state->get_transform());
+	step_transform = state->get_transform();
+	transform_interpolated = false;
+	set_global_transform(step_transform);
 	linear_velocity = state->get_linear_velocity();
 	angular_velocity = state->get_angular_velocity();
 	inverse_inertia_tensor = state->get_inverse_inertia_tensor();
@@ -695,8 +697,8 @@ void RigidBody3D::_direct_state_changed(Object *p_state) {
 }
 
 void RigidBody3D::_notification(int p_what) {
-#ifdef TOOLS_ENABLED
 	switch (p_what) {
+#ifdef TOOLS_ENABLED
 		case NOTIFICATION_ENTER_TREE: {
 			if (Engine::get_singleton()->is_editor_hint()) {
 				set_notify_local_transform(true); //used for warnings and only in editor
@@ -708,8 +710,36 @@ void RigidBody3D::_notification(int p_what) {
 				update_configuration_warnings();
 			}
 		} break;
-	}
 #endif
+
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			if (!interpolate_transform || sleeping || Engine::get_singleton()->is_editor_hint()) {
+				break;
+			}
+
+			// Only the node moves, the body keeps the transform of the last step.
+			real_t fraction = Engine::get_singleton()->get_physics_interpolation_fraction();
+			set_ignore_transform_notification(true);
+			set_global_transform(PhysicsServer3D::get_singleton()->body_get_interpolated_transform(get_rid(), fraction));
+			set_ignore_transform_notification(false);
+			transform_interpolated = true;
+		} break;
+
+		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
+			// Physics code must see the transform of the last step, not the interpolated one.
+			if (transform_interpolated) {
+				set_ignore_transform_notification(true);
+				set_global_transform(step_transform);
+				set_ignore_transform_notification(false);
+				transform_interpolated = false;
+			}
+		} break;
+
+		case NOTIFICATION_TRANSFORM_CHANGED: {
+			// Moved by the user, the interpolated transform was replaced.
+			transform_interpolated = false;
+		} break;
+	}
 }
 
 void RigidBody3D::set_mode(Mode p_mode) {
@@ -867,6 +897,16 @@ bool RigidBody3D::is_sleeping() const {
 	return sleeping;
 }
 
+void RigidBody3D::set_interpolate_transform(bool p_enable) {
+	interpolate_transform = p_enable;
+	set_process_internal(p_enable);
+	set_physics_process_internal(p_enable);
+}
+
+bool RigidBody3D::is_interpolating_transform() const {
+	return interpolate_transform;
+}
+
 void RigidBody3D::set_max_contacts_reported(int p_amount) {
 	max_contacts_reported = p_amount;
 	PhysicsServer3D::get_singleton()->body_set_max_contacts_reported(get_rid(), p_amount);
@@ -1027,6 +1067,9 @@ void RigidBody3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_can_sleep", "able_to_sleep"), &RigidBody3D::set_can_sleep);
 	ClassDB::bind_method(D_METHOD("is_able_to_sleep"), &RigidBody3D::is_able_to_sleep);
 
+	ClassDB::bind_method(D_METHOD("set_interpolate_transform", "enable"), &RigidBody3D::set_interpolate_transform);
+	ClassDB::bind_method(D_METHOD("is_interpolating_transform"), &RigidBody3D::is_interpolating_transform);
+
 	ClassDB::bind_method(D_METHOD("get_colliding_bodies"), &RigidBody3D::get_colliding_bodies);
 
 	BIND_VMETHOD(MethodInfo("_integrate_forces", PropertyInfo(Variant::OBJECT, "state", PROPERTY_HINT_RESOURCE_TYPE, "PhysicsDirectBodyState3D")));
@@ -1041,6 +1084,7 @@ void RigidBody3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "contact_monitor"), "set_contact_monitor", "is_contact_monitor_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "sleeping"), "set_sleeping", "is_sleeping");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "can_sleep"), "set_can_sleep", "is_able_to_sleep");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "interpolate_transform"), "set_interpolate_transform", "is_interpolating_transform");
 	ADD_GROUP("Linear", "linear_");
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "linear_velocity"), "set_linear_velocity", "get_linear_velocity");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "linear_damp", PROPERTY_HINT_RANGE, "-1,100,0.001,or_greater"), "set_linear_damp", "get_linear_damp");
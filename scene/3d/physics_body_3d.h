@@ -149,6 +149,9 @@ protected:
 
 	bool sleeping = false;
 	bool ccd = false;
+	bool interpolate_transform = false;
+	bool transform_interpolated = false;
+	Transform3D step_transform;
 
 	int max_contacts_reported = 0;
 
@@ -240,6 +243,9 @@ public:
 	void set_can_sleep(bool p_active);
 	bool is_able_to_sleep() const;
 
+	void set_interpolate_transform(bool p_enable);
+	bool is_interpolating_transform() const;
+
 	void set_contact_monitor(bool p_enabled);
 	bool is_contact_monitor_enabled() const;
 
@@ -35,6 +35,7 @@
 #include "core/object/message_queue.h"
 #include "core/variant/type_info.h"
 #include "scene/3d/physics_body_3d.h"
+#include "scene/main/scene_tree.h"
 #include "scene/resources/surface_tool.h"
 #include "scene/scene_string_names.h"
 
@@ -195,146 +196,219 @@ void Skeleton3D::_update_process_order() {
 	process_order_dirty = false;
 }
 
-void Skeleton3D::_notification(int p_what) {
-	switch (p_what) {
-		case NOTIFICATION_UPDATE_SKELETON: {
-			RenderingServer *rs = RenderingServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-			int len = bones.size();
+SelfList<Skeleton3D>::List Skeleton3D::pose_dirty_list;
+SpinLock Skeleton3D::pose_dirty_lock;
 
-			_update_process_order();
+void Skeleton3D::_update_bone_poses() {
+	Bone *bonesptr = bones.ptrw();
+	int len = bones.size();
 
-			const int *order = process_order.ptr();
+	_update_process_order();
 
-			for (int i = 0; i < len; i++) {
-				Bone &b = bonesptr[order[i]];
+	const int *order = process_order.ptr();
 
-				if (b.disable_rest) {
-					if (b.enabled) {
-						Transform3D pose = b.pose;
-						if (b.custom_pose_enable) {
-							pose = b.custom_pose * pose;
-						}
-						if (b.parent >= 0) {
-							b.pose_global = bonesptr[b.parent].pose_global * pose;
-							b.pose_global_no_override = bonesptr[b.parent].pose_global * pose;
-						} else {
-							b.pose_global = pose;
-							b.pose_global_no_override = pose;
-						}
-					} else {
-						if (b.parent >= 0) {
-							b.pose_global = bonesptr[b.parent].pose_global;
-							b.pose_global_no_override = bonesptr[b.parent].pose_global;
-						} else {
-							b.pose_global = Transform3D();
-							b.pose_global_no_override = Transform3D();
-						}
-					}
+	for (int i = 0; i < len; i++) {
+		Bone &b = bonesptr[order[i]];
 
+		if (b.disable_rest) {
+			if (b.enabled) {
+				Transform3D pose = b.pose;
+				if (b.custom_pose_enable) {
+					pose = b.custom_pose * pose;
+				}
+				if (b.parent >= 0) {
+					b.pose_global = bonesptr[b.parent].pose_global * pose;
+					b.pose_global_no_override = bonesptr[b.parent].pose_global * pose;
 				} else {
-					if (b.enabled) {
-						Transform3D pose = b.pose;
-						if (b.custom_pose_enable) {
-							pose = b.custom_pose * pose;
-						}
-						if (b.parent >= 0) {
-							b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
-							b.pose_global_no_override = bonesptr[b.parent].pose_global * (b.rest * pose);
-						} else {
-							b.pose_global = b.rest * pose;
-							b.pose_global_no_override = b.rest * pose;
-						}
-					} else {
-						if (b.parent >= 0) {
-							b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-							b.pose_global_no_override = bonesptr[b.parent].pose_global * b.rest;
-						} else {
-							b.pose_global = b.rest;
-							b.pose_global_no_override = b.rest;
-						}
-					}
+					b.pose_global = pose;
+					b.pose_global_no_override = pose;
 				}
-
-				if (b.global_pose_override_amount >= CMP_EPSILON) {
-					b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+			} else {
+				if (b.parent >= 0) {
+					b.pose_global = bonesptr[b.parent].pose_global;
+					b.pose_global_no_override = bonesptr[b.parent].pose_global;
+				} else {
+					b.pose_global = Transform3D();
+					b.pose_global_no_override = Transform3D();
 				}
+			}
 
-				if (b.global_pose_override_reset) {
-					b.global_pose_override_amount = 0.0;
+		} else {
+			if (b.enabled) {
+				Transform3D pose = b.pose;
+				if (b.custom_pose_enable) {
+					pose = b.custom_pose * pose;
 				}
-
-				for (List<ObjectID>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
-					Object *obj = ObjectDB::get_instance(E->get());
-					ERR_CONTINUE(!obj);
-					Node3D *node_3d = Object::cast_to<Node3D>(obj);
-					ERR_CONTINUE(!node_3d);
-					node_3d->set_transform(b.pose_global);
+				if (b.parent >= 0) {
+					b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
+					b.pose_global_no_override = bonesptr[b.parent].pose_global * (b.rest * pose);
+				} else {
+					b.pose_global = b.rest * pose;
+					b.pose_global_no_override = b.rest * pose;
+				}
+			} else {
+				if (b.parent >= 0) {
+					b.pose_global = bonesptr[b.parent].pose_global * b.rest;
+					b.pose_global_no_override = bonesptr[b.parent].pose_global * b.rest;
+				} else {
+					b.pose_global = b.rest;
+					b.pose_global_no_override = b.rest;
 				}
 			}
+		}
 
-			//update skins
-			for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
-				const Skin *skin = E->get()->skin.operator->();
-				RID skeleton = E->get()->skeleton;
-				uint32_t bind_count = skin->get_bind_count();
-
-				if (E->get()->bind_count != bind_count) {
-					RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
-					E->get()->bind_count = bind_count;
-					E->get()->skin_bone_indices.resize(bind_count);
-					E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
-				}
+		if (b.global_pose_override_amount >= CMP_EPSILON) {
+			b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+		}
+
+		if (b.global_pose_override_reset) {
+			b.global_pose_override_amount = 0.0;
+		}
+	}
+}
+
+void Skeleton3D::_update_bone_poses_batch(uint32_t p_index, Skeleton3D *const *p_skeletons) {
+	p_skeletons[p_index]->_update_bone_poses();
+}
+
+void Skeleton3D::_update_dirty_bone_poses() {
+	LocalVector<Skeleton3D *> skeletons;
+
+	pose_dirty_lock.lock();
+	while (pose_dirty_list.first()) {
+		SelfList<Skeleton3D> *item = pose_dirty_list.first();
+		pose_dirty_list.remove(item);
+		skeletons.push_back(item->self());
+	}
+	pose_dirty_lock.unlock();
+
+	if (skeletons.is_empty()) {
+		return;
+	}
+
+	// Pose evaluation only touches each skeleton's own bones, so skeletons are spread across the worker threads.
+	// Bound nodes and skins are still updated serially, when each skeleton handles its own notification.
+	ThreadWorkPool *work_pool = nullptr;
+	if (skeletons.size() >= PARALLEL_UPDATE_MIN_SKELETONS && SceneTree::get_singleton()) {
+		work_pool = SceneTree::get_singleton()->get_thread_work_pool();
+	}
 
-				if (E->get()->skeleton_version != version) {
-					for (uint32_t i = 0; i < bind_count; i++) {
-						StringName bind_name = skin->get_bind_name(i);
-
-						if (bind_name != StringName()) {
-							//bind name used, use this
-							bool found = false;
-							for (int j = 0; j < len; j++) {
-								if (bonesptr[j].name == bind_name) {
-									E->get()->skin_bone_indices_ptrs[i] = j;
-									found = true;
-									break;
-								}
-							}
-
-							if (!found) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							}
-						} else if (skin->get_bind_bone(i) >= 0) {
-							int bind_index = skin->get_bind_bone(i);
-							if (bind_index >= len) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							} else {
-								E->get()->skin_bone_indices_ptrs[i] = bind_index;
-							}
-						} else {
-							ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
-							E->get()->skin_bone_indices_ptrs[i] = 0;
+	if (work_pool) {
+		work_pool->do_work(skeletons.size(), skeletons[0], &Skeleton3D::_update_bone_poses_batch, (Skeleton3D *const *)skeletons.ptr());
+	} else {
+		for (uint32_t i = 0; i < skeletons.size(); i++) {
+			skeletons[i]->_update_bone_poses();
+		}
+	}
+}
+
+void Skeleton3D::_update_own_bone_poses() {
+	pose_dirty_lock.lock();
+	bool pose_dirty = pose_dirty_item.in_list();
+	if (pose_dirty) {
+		pose_dirty_list.remove(&pose_dirty_item);
+	}
+	pose_dirty_lock.unlock();
+
+	if (pose_dirty) {
+		_update_bone_poses();
+	}
+}
+
+void Skeleton3D::_apply_bone_poses() {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	Bone *bonesptr = bones.ptrw();
+	int len = bones.size();
+
+	_update_process_order();
+
+	const int *order = process_order.ptr();
+
+	for (int i = 0; i < len; i++) {
+		Bone &b = bonesptr[order[i]];
+
+		for (List<ObjectID>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
+			Object *obj = ObjectDB::get_instance(E->get());
+			ERR_CONTINUE(!obj);
+			Node3D *node_3d = Object::cast_to<Node3D>(obj);
+			ERR_CONTINUE(!node_3d);
+			node_3d->set_transform(b.pose_global);
+		}
+	}
+
+	//update skins
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		const Skin *skin = E->get()->skin.operator->();
+		RID skeleton = E->get()->skeleton;
+		uint32_t bind_count = skin->get_bind_count();
+
+		if (E->get()->bind_count != bind_count) {
+			RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
+			E->get()->bind_count = bind_count;
+			E->get()->skin_bone_indices.resize(bind_count);
+			E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
+		}
+
+		if (E->get()->skeleton_version != version) {
+			for (uint32_t i = 0; i < bind_count; i++) {
+				StringName bind_name = skin->get_bind_name(i);
+
+				if (bind_name != StringName()) {
+					//bind name used, use this
+					bool found = false;
+					for (int j = 0; j < len; j++) {
+						if (bonesptr[j].name == bind_name) {
+							E->get()->skin_bone_indices_ptrs[i] = j;
+							found = true;
+							break;
 						}
 					}
 
-					E->get()->skeleton_version = version;
-				}
-
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+					if (!found) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					}
+				} else if (skin->get_bind_bone(i) >= 0) {
+					int bind_index = skin->get_bind_bone(i);
+					if (bind_index >= len) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					} else {
+						E->get()->skin_bone_indices_ptrs[i] = bind_index;
+					}
+				} else {
+					ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
+					E->get()->skin_bone_indices_ptrs[i] = 0;
 				}
 			}
 
-			dirty = false;
+			E->get()->skeleton_version = version;
+		}
+
+		for (uint32_t i = 0; i < bind_count; i++) {
+			uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
+			ERR_CONTINUE(bone_index >= (uint32_t)len);
+			rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+		}
+	}
+
+	dirty = false;
 
 #ifdef TOOLS_ENABLED
-			emit_signal(SceneStringNames::get_singleton()->pose_updated);
+	emit_signal(SceneStringNames::get_singleton()->pose_updated);
 #endif // TOOLS_ENABLED
+}
 
+void Skeleton3D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_UPDATE_SKELETON: {
+			if (Thread::get_caller_id() == Thread::get_main_id()) {
+				// No sub-thread group is running, so every pending skeleton can be evaluated at once.
+				_update_dirty_bone_poses();
+			} else {
+				_update_own_bone_poses();
+			}
+			_apply_bone_poses();
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
@@ -377,7 +451,7 @@ void Skeleton3D::set_bone_global_pose_override(int p_bone, const Transform3D &p_
 Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform3D());
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_force_update();
 	}
 	return bones[p_bone].pose_global;
 }
@@ -385,7 +459,7 @@ Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 Transform3D Skeleton3D::get_bone_global_pose_no_override(int p_bone) const {
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform3D());
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_force_update();
 	}
 	return bones[p_bone].pose_global_no_override;
 }
@@ -588,7 +662,21 @@ Transform3D Skeleton3D::get_bone_custom_pose(int p_bone) const {
 	return bones[p_bone].custom_pose;
 }
 
+void Skeleton3D::_force_update() {
+	// Only this skeleton is evaluated. Others may belong to sub-thread groups processing right now,
+	// and the batch is left to the queued update.
+	_update_own_bone_poses();
+	_apply_bone_poses();
+}
+
 void Skeleton3D::_make_dirty() {
+	// Poses may already have been computed by an earlier batch while the notification is still queued.
+	pose_dirty_lock.lock();
+	if (!pose_dirty_item.in_list()) {
+		pose_dirty_list.add(&pose_dirty_item);
+	}
+	pose_dirty_lock.unlock();
+
 	if (dirty) {
 		return;
 	}
@@ -909,10 +997,15 @@ void Skeleton3D::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_UPDATE_SKELETON);
 }
 
-Skeleton3D::Skeleton3D() {
+Skeleton3D::Skeleton3D() :
+		pose_dirty_item(this) {
 }
 
 Skeleton3D::~Skeleton3D() {
+	pose_dirty_lock.lock();
+	pose_dirty_item.remove_from_list();
+	pose_dirty_lock.unlock();
+
 	//some skins may remain bound
 	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
 		E->get()->skeleton_node = nullptr;
@@ -31,7 +31,9 @@
 #ifndef SKELETON_3D_H
 #define SKELETON_3D_H
 
+#include "core/os/spin_lock.h"
 #include "core/templates/rid.h"
+#include "core/templates/self_list.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/skin.h"
 
@@ -105,8 +107,25 @@ private:
 	bool process_order_dirty = true;
 
 	void _make_dirty();
+	void _force_update();
 	bool dirty = false;
 
+	// Skeletons whose global poses are stale. They are all recomputed together, in parallel,
+	// by the first queued update that runs; each skeleton then applies its own bindings.
+	// Pose queries on a dirty skeleton only recompute that skeleton.
+	enum {
+		PARALLEL_UPDATE_MIN_SKELETONS = 4,
+	};
+	SelfList<Skeleton3D> pose_dirty_item;
+	static SelfList<Skeleton3D>::List pose_dirty_list;
+	static SpinLock pose_dirty_lock;
+
+	void _update_bone_poses();
+	void _update_bone_poses_batch(uint32_t p_index, Skeleton3D *const *p_skeletons);
+	static void _update_dirty_bone_poses();
+	void _update_own_bone_poses();
+	void _apply_bone_poses();
+
 	uint64_t version = 1;
 
 	void _update_process_order();
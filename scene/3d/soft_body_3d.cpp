@@ -96,6 +96,13 @@ void SoftBodyRenderingServerHandler::set_aabb(const AABB &p_aabb) {
 	RS::get_singleton()->mesh_set_custom_aabb(mesh, p_aabb);
 }
 
+uint8_t *SoftBodyRenderingServerHandler::get_vertex_write_buffer(uint32_t &r_stride, uint32_t &r_offset_vertex, uint32_t &r_offset_normal) {
+	r_stride = stride;
+	r_offset_vertex = offset_vertices;
+	r_offset_normal = offset_normal;
+	return write_buffer;
+}
+
 SoftBody3D::PinnedPoint::PinnedPoint() {
 }
 
@@ -61,6 +61,7 @@ public:
 	void set_vertex(int p_vertex_id, const void *p_vector3) override;
 	void set_normal(int p_vertex_id, const void *p_vector3) override;
 	void set_aabb(const AABB &p_aabb) override;
+	uint8_t *get_vertex_write_buffer(uint32_t &r_stride, uint32_t &r_offset_vertex, uint32_t &r_offset_normal) override;
 };
 
 class SoftBody3D : public MeshInstance3D {
@@ -62,7 +62,9 @@ void VisualInstance3D::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			Transform3D gt = get_global_transform();
-			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			if (!get_tree()->queue_instance_transform(instance, gt)) {
+				RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			}
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 			RenderingServer::get_singleton()->instance_set_scenario(instance, RID());
@@ -186,6 +188,15 @@ float GeometryInstance3D::get_visibility_range_end_margin() const {
 	return visibility_range_end_margin;
 }
 
+void GeometryInstance3D::set_visibility_range_hlod_error(float p_error) {
+	visibility_range_hlod_error = p_error;
+	RS::get_singleton()->instance_geometry_set_visibility_range_hlod_error(get_instance(), visibility_range_hlod_error);
+}
+
+float GeometryInstance3D::get_visibility_range_hlod_error() const {
+	return visibility_range_hlod_error;
+}
+
 void GeometryInstance3D::_notification(int p_what) {
 }
 
@@ -374,6 +385,9 @@ void GeometryInstance3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_visibility_range_begin", "distance"), &GeometryInstance3D::set_visibility_range_begin);
 	ClassDB::bind_method(D_METHOD("get_visibility_range_begin"), &GeometryInstance3D::get_visibility_range_begin);
 
+	ClassDB::bind_method(D_METHOD("set_visibility_range_hlod_error", "error"), &GeometryInstance3D::set_visibility_range_hlod_error);
+	ClassDB::bind_method(D_METHOD("get_visibility_range_hlod_error"), &GeometryInstance3D::get_visibility_range_hlod_error);
+
 	ClassDB::bind_method(D_METHOD("set_shader_instance_uniform", "uniform", "value"), &GeometryInstance3D::set_shader_instance_uniform);
 	ClassDB::bind_method(D_METHOD("get_shader_instance_uniform", "uniform"), &GeometryInstance3D::get_shader_instance_uniform);
 
@@ -408,6 +422,7 @@ void GeometryInstance3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "visibility_range_begin_margin", PROPERTY_HINT_RANGE, "0.0,4096.0,0.01"), "set_visibility_range_begin_margin", "get_visibility_range_begin_margin");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "visibility_range_end", PROPERTY_HINT_RANGE, "0.0,4096.0,0.01"), "set_visibility_range_end", "get_visibility_range_end");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "visibility_range_end_margin", PROPERTY_HINT_RANGE, "0.0,4096.0,0.01"), "set_visibility_range_end_margin", "get_visibility_range_end_margin");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "visibility_range_hlod_error", PROPERTY_HINT_RANGE, "0.0,256.0,0.001,or_greater"), "set_visibility_range_hlod_error", "get_visibility_range_hlod_error");
 
 	//ADD_SIGNAL( MethodInfo("visibility_changed"));
 
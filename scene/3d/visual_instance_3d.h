@@ -112,6 +112,7 @@ private:
 	float visibility_range_end = 0.0;
 	float visibility_range_begin_margin = 0.0;
 	float visibility_range_end_margin = 0.0;
+	float visibility_range_hlod_error = 0.0;
 
 	Vector<NodePath> visibility_range_children;
 
@@ -151,6 +152,9 @@ public:
 	void set_visibility_range_end_margin(float p_dist);
 	float get_visibility_range_end_margin() const;
 
+	void set_visibility_range_hlod_error(float p_error);
+	float get_visibility_range_hlod_error() const;
+
 	void set_visibility_range_parent(const Node *p_parent);
 	void clear_visibility_range_parent();
 
@@ -348,6 +348,11 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 	Animation *a = p_anim->animation.operator->();
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 
+	Vector<CrowdSample> crowd_samples;
+	if (crowd_time_step > 0) {
+		crowd_samples = _get_crowd_samples(p_anim->animation, p_time);
+	}
+
 	for (int i = 0; i < a->get_track_count(); i++) {
 		// If an animation changes this animation (or it animates itself)
 		// we need to recreate our animation cache
@@ -380,11 +385,21 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				Quaternion rot;
 				Vector3 scale;
 
-				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
-				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+				if (crowd_samples.size() == a->get_track_count()) {
+					const CrowdSample &sample = crowd_samples[i];
+					if (!sample.valid) {
+						continue;
+					}
+					loc = sample.loc;
+					rot = sample.rot;
+					scale = sample.scale;
+				} else {
+					Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
+					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
-				if (err != OK) {
-					continue;
+					if (err != OK) {
+						continue;
+					}
 				}
 
 				if (nc->accum_pass != accum_pass) {
@@ -1475,6 +1490,62 @@ float AnimationPlayer::get_default_blend_time() const {
 	return default_blend_time;
 }
 
+void AnimationPlayer::set_crowd_time_step(float p_step) {
+	crowd_time_step = MAX(p_step, 0.0f);
+}
+
+float AnimationPlayer::get_crowd_time_step() const {
+	return crowd_time_step;
+}
+
+HashMap<AnimationPlayer::CrowdPoseKey, Vector<AnimationPlayer::CrowdSample>, AnimationPlayer::CrowdPoseKey> AnimationPlayer::crowd_pose_cache;
+uint64_t AnimationPlayer::crowd_pose_cache_frame = 0;
+Mutex AnimationPlayer::crowd_pose_cache_mutex;
+
+Vector<AnimationPlayer::CrowdSample> AnimationPlayer::_get_crowd_samples(const Ref<Animation> &p_animation, float p_time) const {
+	CrowdPoseKey key;
+	key.animation = p_animation->get_instance_id();
+	key.step = crowd_time_step;
+	key.bucket = (int64_t)Math::floor(p_time / crowd_time_step);
+
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	{
+		MutexLock lock(crowd_pose_cache_mutex);
+		if (crowd_pose_cache_frame != frame) {
+			// Only keep samples for the current frame, so edited animations are picked up on the next one.
+			crowd_pose_cache.clear();
+			crowd_pose_cache_frame = frame;
+		}
+
+		const Vector<CrowdSample> *cached = crowd_pose_cache.getptr(key);
+		if (cached) {
+			return *cached;
+		}
+	}
+
+	// Sampled outside the lock; if another player fills the same bucket meanwhile, both results are identical.
+	const Animation *a = p_animation.operator->();
+	float time = key.bucket * crowd_time_step;
+	Vector<CrowdSample> samples;
+	samples.resize(a->get_track_count());
+	CrowdSample *samplesw = samples.ptrw();
+
+	for (int i = 0; i < a->get_track_count(); i++) {
+		if (a->track_get_type(i) != Animation::TYPE_TRANSFORM3D || !a->track_is_enabled(i) || a->track_get_key_count(i) == 0) {
+			continue;
+		}
+
+		CrowdSample &sample = samplesw[i];
+		sample.valid = a->transform_track_interpolate(i, time, &sample.loc, &sample.rot, &sample.scale) == OK;
+	}
+
+	MutexLock lock(crowd_pose_cache_mutex);
+	if (crowd_pose_cache_frame == frame) {
+		crowd_pose_cache.set(key, samples);
+	}
+	return samples;
+}
+
 void AnimationPlayer::set_root(const NodePath &p_root) {
 	root = p_root;
 	clear_caches();
@@ -1610,6 +1681,9 @@ void AnimationPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_default_blend_time", "sec"), &AnimationPlayer::set_default_blend_time);
 	ClassDB::bind_method(D_METHOD("get_default_blend_time"), &AnimationPlayer::get_default_blend_time);
 
+	ClassDB::bind_method(D_METHOD("set_crowd_time_step", "step"), &AnimationPlayer::set_crowd_time_step);
+	ClassDB::bind_method(D_METHOD("get_crowd_time_step"), &AnimationPlayer::get_crowd_time_step);
+
 	ClassDB::bind_method(D_METHOD("play", "name", "custom_blend", "custom_speed", "from_end"), &AnimationPlayer::play, DEFVAL(""), DEFVAL(-1), DEFVAL(1.0), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("play_backwards", "name", "custom_blend"), &AnimationPlayer::play_backwards, DEFVAL(""), DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("stop", "reset"), &AnimationPlayer::stop, DEFVAL(true));
@@ -1668,6 +1742,7 @@ void AnimationPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_default_blend_time", PROPERTY_HINT_RANGE, "0,4096,0.01"), "set_default_blend_time", "get_default_blend_time");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "playback_active", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_speed", PROPERTY_HINT_RANGE, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_crowd_time_step", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_crowd_time_step", "get_crowd_time_step");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "method_call_mode", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
 
 	ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(Variant::STRING_NAME, "anim_name")));
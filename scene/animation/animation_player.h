@@ -31,6 +31,8 @@
 #ifndef ANIMATION_PLAYER_H
 #define ANIMATION_PLAYER_H
 
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
 #include "scene/2d/node_2d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
@@ -163,6 +165,33 @@ private:
 	uint64_t accum_pass = 1;
 	float speed_scale = 1.0;
 	float default_blend_time = 0.0;
+	float crowd_time_step = 0.0;
+
+	// Transform track samples shared by every player evaluating the same animation
+	// in the same time bucket. Samples don't depend on the rig, so players only keep
+	// their own track-to-bone mapping. Entries live for a single process frame.
+	struct CrowdSample {
+		Vector3 loc;
+		Quaternion rot;
+		Vector3 scale;
+		bool valid = false;
+	};
+
+	// The step is part of the key, as the same bucket means a different time for each step.
+	struct CrowdPoseKey {
+		ObjectID animation;
+		float step = 0.0;
+		int64_t bucket = 0;
+
+		static uint32_t hash(const CrowdPoseKey &p_key) { return hash_djb2_one_64(p_key.bucket, hash_djb2_one_64(uint64_t(p_key.animation), hash_djb2_one_float(p_key.step))); }
+		bool operator==(const CrowdPoseKey &p_key) const { return animation == p_key.animation && step == p_key.step && bucket == p_key.bucket; }
+	};
+
+	static HashMap<CrowdPoseKey, Vector<CrowdSample>, CrowdPoseKey> crowd_pose_cache;
+	static uint64_t crowd_pose_cache_frame;
+	static Mutex crowd_pose_cache_mutex;
+
+	Vector<CrowdSample> _get_crowd_samples(const Ref<Animation> &p_animation, float p_time) const;
 
 	struct AnimationData {
 		String name;
@@ -274,6 +303,9 @@ public:
 	void set_default_blend_time(float p_default);
 	float get_default_blend_time() const;
 
+	void set_crowd_time_step(float p_step);
+	float get_crowd_time_step() const;
+
 	void play(const StringName &p_name = StringName(), float p_custom_blend = -1, float p_custom_scale = 1.0, bool p_from_end = false);
 	void play_backwards(const StringName &p_name = StringName(), float p_custom_blend = -1);
 	void queue(const StringName &p_name);
@@ -582,8 +582,8 @@ void CanvasItem::_notification(int p_what) {
 				}
 			}
 			_enter_canvas();
-			if (!block_transform_notify && !xform_change.in_list()) {
-				get_tree()->xform_change_list.add(&xform_change);
+			if (!block_transform_notify) {
+				_add_to_xform_change_list();
 			}
 		} break;
 		case NOTIFICATION_MOVED_IN_PARENT: {
@@ -601,9 +601,11 @@ void CanvasItem::_notification(int p_what) {
 
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			get_tree()->xform_change_lock.lock();
 			if (xform_change.in_list()) {
 				get_tree()->xform_change_list.remove(&xform_change);
 			}
+			get_tree()->xform_change_lock.unlock();
 			_exit_canvas();
 			if (C) {
 				Object::cast_to<CanvasItem>(get_parent())->children_items.erase(C);
@@ -938,6 +940,16 @@ real_t CanvasItem::draw_char(const Ref<Font> &p_font, const Point2 &p_pos, const
 	return p_font->draw_char(canvas_item, p_pos, p_char[0], p_next.get_data()[0], p_size, p_modulate, p_outline_size, p_outline_modulate);
 }
 
+void CanvasItem::_add_to_xform_change_list() {
+	// The list is shared by every sub-thread process group, so membership must be checked under the lock.
+	SceneTree *tree = get_tree();
+	tree->xform_change_lock.lock();
+	if (!xform_change.in_list()) {
+		tree->xform_change_list.add(&xform_change);
+	}
+	tree->xform_change_lock.unlock();
+}
+
 void CanvasItem::_notify_transform(CanvasItem *p_node) {
 	/* This check exists to avoid re-propagating the transform
 	 * notification down the tree on dirty nodes. It provides
@@ -951,12 +963,8 @@ void CanvasItem::_notify_transform(CanvasItem *p_node) {
 
 	p_node->global_invalid = true;
 
-	if (p_node->notify_transform && !p_node->xform_change.in_list()) {
-		if (!p_node->block_transform_notify) {
-			if (p_node->is_inside_tree()) {
-				get_tree()->xform_change_list.add(&p_node->xform_change);
-			}
-		}
+	if (p_node->notify_transform && !p_node->block_transform_notify && p_node->is_inside_tree()) {
+		p_node->_add_to_xform_change_list();
 	}
 
 	for (List<CanvasItem *>::Element *E = p_node->children_items.front(); E; E = E->next()) {
@@ -1088,11 +1096,15 @@ Vector2 CanvasItem::get_local_mouse_position() const {
 
 void CanvasItem::force_update_transform() {
 	ERR_FAIL_COND(!is_inside_tree());
+	SceneTree *tree = get_tree();
+	tree->xform_change_lock.lock();
 	if (!xform_change.in_list()) {
+		tree->xform_change_lock.unlock();
 		return;
 	}
 
-	get_tree()->xform_change_list.remove(&xform_change);
+	tree->xform_change_list.remove(&xform_change);
+	tree->xform_change_lock.unlock();
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
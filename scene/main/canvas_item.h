@@ -233,6 +233,7 @@ private:
 
 	void _window_visibility_changed();
 
+	void _add_to_xform_change_list();
 	void _notify_transform(CanvasItem *p_node);
 
 	void _set_on_top(bool p_on_top) { set_draw_behind_parent(!p_on_top); }
@@ -48,6 +48,7 @@
 #include <stdint.h>
 
 VARIANT_ENUM_CAST(Node::ProcessMode);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 
 int Node::orphan_node_count = 0;
 
@@ -80,6 +81,11 @@ void Node::_notification(int p_notification) {
 				data.process_owner = this;
 			}
 
+			data.process_thread_group_owner = _find_process_thread_group_owner();
+			if (data.process_thread_group_owner == this) {
+				get_tree()->process_thread_group_count++;
+			}
+
 			if (data.input) {
 				add_to_group("_vp_input" + itos(get_viewport()->get_instance_id()));
 			}
@@ -112,6 +118,12 @@ void Node::_notification(int p_notification) {
 			}
 
 			data.process_owner = nullptr;
+
+			if (data.process_thread_group_owner == this) {
+				get_tree()->process_thread_group_count--;
+			}
+			data.process_thread_group_owner = nullptr;
+
 			if (data.path_cache) {
 				memdelete(data.path_cache);
 				data.path_cache = nullptr;
@@ -292,6 +304,7 @@ void Node::_propagate_exit_tree() {
 }
 
 void Node::move_child(Node *p_child, int p_pos) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_INDEX_MSG(p_pos, data.children.size() + 1, vformat("Invalid new child position: %d.", p_pos));
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
@@ -337,6 +350,7 @@ void Node::move_child(Node *p_child, int p_pos) {
 }
 
 void Node::raise() {
+	ERR_MAIN_THREAD_GUARD;
 	if (!data.parent) {
 		return;
 	}
@@ -357,6 +371,7 @@ void Node::move_child_notify(Node *p_child) {
 }
 
 void Node::set_physics_process(bool p_process) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.physics_process == p_process) {
 		return;
 	}
@@ -375,6 +390,7 @@ bool Node::is_physics_processing() const {
 }
 
 void Node::set_physics_process_internal(bool p_process_internal) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.physics_process_internal == p_process_internal) {
 		return;
 	}
@@ -393,6 +409,7 @@ bool Node::is_physics_processing_internal() const {
 }
 
 void Node::set_process_mode(ProcessMode p_mode) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process_mode == p_mode) {
 		return;
 	}
@@ -466,6 +483,125 @@ Node::ProcessMode Node::get_process_mode() const {
 	return data.process_mode;
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_group) {
+	ERR_MAIN_THREAD_GUARD;
+	if (data.process_thread_group == p_group) {
+		return;
+	}
+
+	data.process_thread_group = p_group;
+
+	if (!is_inside_tree()) {
+		return;
+	}
+
+	_propagate_process_thread_group_owner();
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+	return data.process_thread_group;
+}
+
+Node *Node::_find_process_thread_group_owner() const {
+	switch (data.process_thread_group) {
+		case PROCESS_THREAD_GROUP_INHERIT: {
+			return data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+		}
+		case PROCESS_THREAD_GROUP_MAIN_THREAD: {
+			return nullptr;
+		}
+		case PROCESS_THREAD_GROUP_SUB_THREAD: {
+			// Sub-thread groups can't be nested. Transform changes propagate down the tree, so the
+			// thread of the outer group would write to nodes owned by the inner one while it runs.
+			// Join the enclosing group instead, even if main thread nodes are in between.
+			for (const Node *p = data.parent; p; p = p->data.parent) {
+				if (p->data.process_thread_group_owner) {
+					WARN_PRINT("Node '" + String(get_name()) + "' is a sub-thread group nested inside another sub-thread group ('" + String(p->data.process_thread_group_owner->get_name()) + "'), it will be processed as part of that group.");
+					return p->data.process_thread_group_owner;
+				}
+			}
+			return const_cast<Node *>(this);
+		}
+	}
+	return nullptr;
+}
+
+void Node::_propagate_process_thread_group_owner() {
+	Node *owner = _find_process_thread_group_owner();
+	if (owner != data.process_thread_group_owner) {
+		if (data.process_thread_group_owner == this) {
+			get_tree()->process_thread_group_count--;
+		}
+		if (owner == this) {
+			get_tree()->process_thread_group_count++;
+		}
+		data.process_thread_group_owner = owner;
+	}
+
+	// Every child needs updating, as nested sub-thread groups depend on their ancestors too.
+	for (int i = 0; i < data.children.size(); i++) {
+		data.children[i]->_propagate_process_thread_group_owner();
+	}
+}
+
+bool Node::is_accessible_from_caller_thread() const {
+	const Node *group_owner = SceneTree::get_current_process_thread_group_owner();
+	if (group_owner) {
+		// Processing a sub-thread group, only nodes of the same group can be used.
+		return data.process_thread_group_owner == group_owner;
+	}
+	// Otherwise, nodes inside the tree belong to the main thread.
+	return !data.inside_tree || Thread::get_caller_id() == Thread::get_main_id();
+}
+
+void Node::call_deferred_thread_group(const StringName &p_method, VARIANT_ARG_DECLARE) {
+	VARIANT_ARGPTRS;
+
+	int argc = 0;
+	for (int i = 0; i < VARIANT_ARG_MAX; i++) {
+		if (argptr[i]->get_type() == Variant::NIL) {
+			break;
+		}
+		argc++;
+	}
+
+	if (!SceneTree::push_process_thread_group_call(this, p_method, argptr, argc)) {
+		MessageQueue::get_singleton()->push_call(this, p_method, VARIANT_ARG_PASS);
+	}
+}
+
+void Node::set_deferred_thread_group(const StringName &p_property, const Variant &p_value) {
+	Variant property = p_property;
+	const Variant *args[2] = { &property, &p_value };
+	if (!SceneTree::push_process_thread_group_call(this, "set", args, 2)) {
+		MessageQueue::get_singleton()->push_set(this, p_property, p_value);
+	}
+}
+
+Variant Node::_call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (p_argcount < 1) {
+		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 1;
+		return Variant();
+	}
+
+	if (p_args[0]->get_type() != Variant::STRING_NAME && p_args[0]->get_type() != Variant::STRING) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 0;
+		r_error.expected = Variant::STRING_NAME;
+		return Variant();
+	}
+
+	StringName method = *p_args[0];
+
+	if (!SceneTree::push_process_thread_group_call(this, method, &p_args[1], p_argcount - 1)) {
+		MessageQueue::get_singleton()->push_call(get_instance_id(), method, &p_args[1], p_argcount - 1);
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+	return Variant();
+}
+
 void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification) {
 	data.process_owner = p_owner;
 
@@ -722,6 +858,7 @@ float Node::get_process_delta_time() const {
 }
 
 void Node::set_process(bool p_process) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process == p_process) {
 		return;
 	}
@@ -740,6 +877,7 @@ bool Node::is_processing() const {
 }
 
 void Node::set_process_internal(bool p_process_internal) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process_internal == p_process_internal) {
 		return;
 	}
@@ -758,6 +896,7 @@ bool Node::is_processing_internal() const {
 }
 
 void Node::set_process_priority(int p_priority) {
+	ERR_MAIN_THREAD_GUARD;
 	data.process_priority = p_priority;
 
 	// Make sure we are in SceneTree.
@@ -787,6 +926,7 @@ int Node::get_process_priority() const {
 }
 
 void Node::set_process_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.input) {
 		return;
 	}
@@ -808,6 +948,7 @@ bool Node::is_processing_input() const {
 }
 
 void Node::set_process_unhandled_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.unhandled_input) {
 		return;
 	}
@@ -828,6 +969,7 @@ bool Node::is_processing_unhandled_input() const {
 }
 
 void Node::set_process_unhandled_key_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.unhandled_key_input) {
 		return;
 	}
@@ -852,17 +994,30 @@ StringName Node::get_name() const {
 }
 
 void Node::_set_name_nocheck(const StringName &p_name) {
+	if (data.parent) {
+		data.parent->_child_name_index_remove(this);
+	}
 	data.name = p_name;
+	if (data.parent) {
+		data.parent->_child_name_index_add(this);
+	}
 }
 
 void Node::set_name(const String &p_name) {
+	ERR_MAIN_THREAD_GUARD;
 	String name = p_name.validate_node_name();
 
 	ERR_FAIL_COND(name == "");
+
+	if (data.parent) {
+		data.parent->_child_name_index_remove(this);
+	}
+
 	data.name = name;
 
 	if (data.parent) {
 		data.parent->_validate_child_name(this);
+		data.parent->_child_name_index_add(this);
 	}
 
 	propagate_notification(NOTIFICATION_PATH_CHANGED);
@@ -915,18 +1070,8 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 			unique = false;
 		} else {
 			//check if exists
-			Node **children = data.children.ptrw();
-			int cc = data.children.size();
-
-			for (int i = 0; i < cc; i++) {
-				if (children[i] == p_child) {
-					continue;
-				}
-				if (children[i]->data.name == p_child->data.name) {
-					unique = false;
-					break;
-				}
-			}
+			Node *existing = _get_child_by_name(p_child->data.name);
+			unique = !existing || existing == p_child;
 		}
 
 		if (!unique) {
@@ -983,22 +1128,9 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 	}
 
 	//quickly test if proposed name exists
-	int cc = data.children.size(); //children count
-	const Node *const *children_ptr = data.children.ptr();
-
 	{
-		bool exists = false;
-
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) { //exclude self in renaming if it's already a child
-				continue;
-			}
-			if (children_ptr[i]->data.name == name) {
-				exists = true;
-			}
-		}
-
-		if (!exists) {
+		const Node *existing = _get_child_by_name(name);
+		if (!existing || existing == p_child) { //exclude self in renaming if it's already a child
 			return; //if it does not exist, it does not need validation
 		}
 	}
@@ -1027,18 +1159,9 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 
 	for (;;) {
 		StringName attempt = name_string + nums;
-		bool exists = false;
-
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) {
-				continue;
-			}
-			if (children_ptr[i]->data.name == attempt) {
-				exists = true;
-			}
-		}
+		const Node *existing = _get_child_by_name(attempt);
 
-		if (!exists) {
+		if (!existing || existing == p_child) {
 			name = attempt;
 			return;
 		} else {
@@ -1059,6 +1182,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 	p_child->data.name = p_name;
 	p_child->data.pos = data.children.size();
 	data.children.push_back(p_child);
+	_child_name_index_add(p_child);
 	p_child->data.parent = this;
 	p_child->notification(NOTIFICATION_PARENTED);
 
@@ -1073,6 +1197,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 }
 
 void Node::add_child(Node *p_child, bool p_legible_unique_name) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(p_child == this, vformat("Can't add child '%s' to itself.", p_child->get_name())); // adding to itself!
 	ERR_FAIL_COND_MSG(p_child->data.parent, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_child->get_name(), get_name(), p_child->data.parent->get_name())); //Fail if node has a parent
@@ -1088,6 +1213,7 @@ void Node::add_child(Node *p_child, bool p_legible_unique_name) {
 }
 
 void Node::add_sibling(Node *p_sibling, bool p_legible_unique_name) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_sibling);
 	ERR_FAIL_COND_MSG(p_sibling == this, vformat("Can't add sibling '%s' to itself.", p_sibling->get_name())); // adding to itself!
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, add_sibling() failed. Consider using call_deferred(\"add_sibling\", sibling) instead.");
@@ -1122,6 +1248,7 @@ void Node::_propagate_validate_owner() {
 }
 
 void Node::remove_child(Node *p_child) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, remove_node() failed. Consider using call_deferred(\"remove_child\", child) instead.");
 
@@ -1155,6 +1282,7 @@ void Node::remove_child(Node *p_child) {
 	remove_child_notify(p_child);
 	p_child->notification(NOTIFICATION_UNPARENTED);
 
+	_child_name_index_remove(p_child);
 	data.children.remove(idx);
 
 	//update pointer and size
@@ -1191,6 +1319,11 @@ Node *Node::get_child(int p_index) const {
 }
 
 Node *Node::_get_child_by_name(const StringName &p_name) const {
+	if (data.children_by_name_built) {
+		Node *const *child = data.children_by_name.getptr(p_name);
+		return child ? *child : nullptr;
+	}
+
 	int cc = data.children.size();
 	Node *const *cd = data.children.ptr();
 
@@ -1203,7 +1336,57 @@ Node *Node::_get_child_by_name(const StringName &p_name) const {
 	return nullptr;
 }
 
+void Node::_child_name_index_insert(Node *p_child) {
+	Node **existing = data.children_by_name.getptr(p_child->data.name);
+	if (!existing) {
+		data.children_by_name.set(p_child->data.name, p_child);
+	} else if (*existing != p_child) {
+		data.children_by_name_collision = true; // Keep the first one, like a linear search would.
+	}
+}
+
+void Node::_child_name_index_add(Node *p_child) {
+	if (data.children_by_name_built) {
+		_child_name_index_insert(p_child);
+		return;
+	}
+
+	if (data.children.size() < CHILD_NAME_INDEX_THRESHOLD) {
+		return;
+	}
+
+	data.children_by_name_built = true;
+	for (int i = 0; i < data.children.size(); i++) {
+		_child_name_index_insert(data.children[i]);
+	}
+}
+
+void Node::_child_name_index_remove(Node *p_child) {
+	if (!data.children_by_name_built) {
+		return;
+	}
+
+	Node **existing = data.children_by_name.getptr(p_child->data.name);
+	if (!existing || *existing != p_child) {
+		return;
+	}
+
+	data.children_by_name.erase(p_child->data.name);
+
+	if (data.children_by_name_collision) {
+		// Another child may have the same name, it takes over the entry.
+		for (int i = 0; i < data.children.size(); i++) {
+			Node *child = data.children[i];
+			if (child != p_child && child->data.name == p_child->data.name) {
+				data.children_by_name.set(child->data.name, child);
+				break;
+			}
+		}
+	}
+}
+
 Node *Node::get_node_or_null(const NodePath &p_path) const {
+	ERR_THREAD_GUARD_V(nullptr);
 	if (p_path.is_empty()) {
 		return nullptr;
 	}
@@ -1243,16 +1426,7 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			}
 
 		} else {
-			next = nullptr;
-
-			for (int j = 0; j < current->data.children.size(); j++) {
-				Node *child = current->data.children[j];
-
-				if (child->data.name == name) {
-					next = child;
-					break;
-				}
-			}
+			next = current->_get_child_by_name(name);
 			if (next == nullptr) {
 				return nullptr;
 			};
@@ -1418,6 +1592,7 @@ void Node::_set_owner_nocheck(Node *p_owner) {
 }
 
 void Node::set_owner(Node *p_owner) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.owner) {
 		data.owner->data.owned.erase(data.OW);
 		data.OW = nullptr;
@@ -1560,6 +1735,7 @@ bool Node::is_in_group(const StringName &p_identifier) const {
 }
 
 void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_COND(!p_identifier.operator String().length());
 
 	if (data.grouped.has(p_identifier)) {
@@ -1580,6 +1756,7 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 }
 
 void Node::remove_from_group(const StringName &p_identifier) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_COND(!data.grouped.has(p_identifier));
 
 	Map<StringName, GroupData>::Element *E = data.grouped.find(p_identifier);
@@ -1731,6 +1908,7 @@ Ref<Tween> Node::create_tween() {
 }
 
 void Node::remove_and_skip() {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_COND(!data.parent);
 
 	Node *new_owner = get_owner();
@@ -2183,6 +2361,7 @@ static void find_owned_by(Node *p_by, Node *p_node, List<Node *> *p_owned) {
 }
 
 void Node::replace_by(Node *p_node, bool p_keep_groups) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_COND(p_node->data.parent);
 
@@ -2426,6 +2605,13 @@ void Node::print_stray_nodes() {
 }
 
 void Node::queue_delete() {
+	if (SceneTree::get_current_process_thread_group_owner()) {
+		// Freeing modifies the tree, so it waits for the end of the threaded process pass.
+		ERR_THREAD_GUARD;
+		call_deferred_thread_group("queue_free");
+		return;
+	}
+
 	if (is_inside_tree()) {
 		get_tree()->queue_delete(this);
 	} else {
@@ -2600,6 +2786,10 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_processing_unhandled_key_input"), &Node::is_processing_unhandled_key_input);
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &Node::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &Node::get_process_mode);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "group"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+	ClassDB::bind_method(D_METHOD("is_accessible_from_caller_thread"), &Node::is_accessible_from_caller_thread);
+	ClassDB::bind_method(D_METHOD("set_deferred_thread_group", "property", "value"), &Node::set_deferred_thread_group);
 	ClassDB::bind_method(D_METHOD("can_process"), &Node::can_process);
 	ClassDB::bind_method(D_METHOD("print_stray_nodes"), &Node::_print_stray_nodes);
 
@@ -2659,6 +2849,14 @@ void Node::_bind_methods() {
 		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "rpc_id", &Node::_rpc_id_bind, mi);
 	}
 
+	{
+		MethodInfo mi;
+		mi.name = "call_deferred_thread_group";
+		mi.arguments.push_back(PropertyInfo(Variant::STRING_NAME, "method"));
+
+		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "call_deferred_thread_group", &Node::_call_deferred_thread_group_bind, mi, varray(), false);
+	}
+
 	ClassDB::bind_method(D_METHOD("update_configuration_warnings"), &Node::update_configuration_warnings);
 
 	BIND_CONSTANT(NOTIFICATION_ENTER_TREE);
@@ -2708,6 +2906,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PROCESS_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(PROCESS_MODE_DISABLED);
 
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
+
 	BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS);
 	BIND_ENUM_CONSTANT(DUPLICATE_GROUPS);
 	BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS);
@@ -2728,6 +2930,7 @@ void Node::_bind_methods() {
 	ADD_GROUP("Process", "process_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Inherit,Pausable,When Paused,Always,Disabled"), "set_process_mode", "get_process_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 
 	ADD_GROUP("Editor Description", "editor_");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "editor_description", PROPERTY_HINT_MULTILINE_TEXT, "", PROPERTY_USAGE_EDITOR | PROPERTY_USAGE_INTERNAL), "set_editor_description", "get_editor_description");
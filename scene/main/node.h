@@ -35,6 +35,7 @@
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
 #include "core/string/node_path.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/map.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/scene_tree.h"
@@ -57,6 +58,12 @@ public:
 		PROCESS_MODE_DISABLED, // never process
 	};
 
+	enum ProcessThreadGroup {
+		PROCESS_THREAD_GROUP_INHERIT, // same as parent node
+		PROCESS_THREAD_GROUP_MAIN_THREAD, // process on the main thread
+		PROCESS_THREAD_GROUP_SUB_THREAD, // process this subtree on a worker thread
+	};
+
 	enum DuplicateFlags {
 		DUPLICATE_SIGNALS = 1,
 		DUPLICATE_GROUPS = 2,
@@ -83,6 +90,12 @@ private:
 		SceneTree::Group *group = nullptr;
 	};
 
+	enum {
+		// Children are looked up by name through a hash index once there are this many,
+		// scanning is faster below that.
+		CHILD_NAME_INDEX_THRESHOLD = 32,
+	};
+
 	struct Data {
 		String filename;
 		Ref<SceneState> instance_state;
@@ -91,6 +104,9 @@ private:
 		Node *parent = nullptr;
 		Node *owner = nullptr;
 		Vector<Node *> children;
+		HashMap<StringName, Node *> children_by_name;
+		bool children_by_name_built = false;
+		bool children_by_name_collision = false; // Some children share a name (only possible with _add_child_nocheck()).
 		int pos = -1;
 		int depth = -1;
 		int blocked = 0; // Safeguard that throws an error when attempting to modify the tree in a harmful way while being traversed.
@@ -113,6 +129,10 @@ private:
 		ProcessMode process_mode = PROCESS_MODE_INHERIT;
 		Node *process_owner = nullptr;
 
+		ProcessThreadGroup process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+		Node *process_thread_group_owner = nullptr; // Owner of the sub-thread group, nullptr if processed on the main thread.
+		uint32_t process_thread_group_index = 0; // Used by SceneTree when splitting a process pass into groups.
+
 		int network_master = 1; // Server by default.
 		Vector<MultiplayerAPI::RPCConfig> rpc_methods;
 
@@ -152,6 +172,9 @@ private:
 	void _print_tree(const Node *p_node);
 
 	Node *_get_child_by_name(const StringName &p_name) const;
+	void _child_name_index_insert(Node *p_child);
+	void _child_name_index_add(Node *p_child);
+	void _child_name_index_remove(Node *p_child);
 
 	void _replace_connections_target(Node *p_new_target);
 
@@ -167,6 +190,8 @@ private:
 	void _propagate_validate_owner();
 	void _print_stray_nodes();
 	void _propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification);
+	Node *_find_process_thread_group_owner() const;
+	void _propagate_process_thread_group_owner();
 	Array _get_node_and_resource(const NodePath &p_path);
 
 	void _duplicate_signals(const Node *p_original, Node *p_copy) const;
@@ -176,6 +201,7 @@ private:
 	Array _get_groups() const;
 
 	Variant _rpc_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Variant _call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _rpc_id_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	friend class SceneTree;
@@ -392,6 +418,13 @@ public:
 	bool can_process_notification(int p_what) const;
 	bool is_enabled() const;
 
+	void set_process_thread_group(ProcessThreadGroup p_group);
+	ProcessThreadGroup get_process_thread_group() const;
+	bool is_accessible_from_caller_thread() const;
+
+	void call_deferred_thread_group(const StringName &p_method, VARIANT_ARG_LIST);
+	void set_deferred_thread_group(const StringName &p_property, const Variant &p_value);
+
 	void request_ready();
 
 	static void print_stray_nodes();
@@ -449,6 +482,19 @@ public:
 
 VARIANT_ENUM_CAST(Node::DuplicateFlags);
 
+// Thread guards for nodes processed in sub-thread groups, only checked in debug builds.
+// ERR_THREAD_GUARD: the node may only be used from the thread that processes its group.
+// ERR_MAIN_THREAD_GUARD: the call modifies the scene tree, so it must happen on the main thread.
+#ifdef DEBUG_ENABLED
+#define ERR_THREAD_GUARD ERR_FAIL_COND_MSG(!is_accessible_from_caller_thread(), "Caller thread can't call this function in this node (" + String(get_name()) + "). Use call_deferred() or call_deferred_thread_group() instead.");
+#define ERR_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_accessible_from_caller_thread(), (m_ret), "Caller thread can't call this function in this node (" + String(get_name()) + "). Use call_deferred() or call_deferred_thread_group() instead.");
+#define ERR_MAIN_THREAD_GUARD ERR_FAIL_COND_MSG(is_inside_tree() && Thread::get_caller_id() != Thread::get_main_id(), "This function in this node (" + String(get_name()) + ") can only be accessed from the main thread. Use call_deferred() or call_deferred_thread_group() instead.");
+#else
+#define ERR_THREAD_GUARD
+#define ERR_THREAD_GUARD_V(m_ret)
+#define ERR_MAIN_THREAD_GUARD
+#endif
+
 typedef Set<Node *, Node::Comparator> NodeSet;
 
 #endif
@@ -40,6 +40,7 @@
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/sort_array.h"
 #include "node.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
@@ -147,14 +148,59 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 	}
 }
 
+ThreadWorkPool *SceneTree::get_thread_work_pool() {
+	// Sub-thread groups are processed on this same pool.
+	if (Thread::get_caller_id() != Thread::get_main_id() || process_thread_work_pool.is_working()) {
+		return nullptr;
+	}
+
+	if (process_thread_work_pool.get_thread_count() == 0) {
+		process_thread_work_pool.init();
+	}
+	return &process_thread_work_pool;
+}
+
+bool SceneTree::XFormChangeDepthSort::operator()(const SelfList<Node> *p_a, const SelfList<Node> *p_b) const {
+	return p_a->self()->data.depth < p_b->self()->data.depth;
+}
+
 void SceneTree::flush_transform_notifications() {
-	SelfList<Node> *n = xform_change_list.first();
-	while (n) {
-		Node *node = n->self();
-		SelfList<Node> *nx = n->next();
-		xform_change_list.remove(n);
-		n = nx;
-		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
+	if (!xform_change_list.first()) {
+		return;
+	}
+
+	// Nodes moved from now on must propagate again, as the pending notifications are consumed here.
+	xform_change_pass++;
+	xform_batching = true;
+
+	// Notify parents before children, so every global transform queried by the notifications
+	// is computed from an up to date parent, with a single multiplication instead of a recursion.
+	// Notifications can move other nodes, those are flushed in the next iteration.
+	while (xform_change_list.first()) {
+		xform_change_nodes.clear();
+		for (SelfList<Node> *n = xform_change_list.first(); n; n = n->next()) {
+			xform_change_nodes.push_back(n);
+		}
+
+		SortArray<SelfList<Node> *, XFormChangeDepthSort> sorter;
+		sorter.sort(xform_change_nodes.ptr(), xform_change_nodes.size());
+
+		for (uint32_t i = 0; i < xform_change_nodes.size(); i++) {
+			SelfList<Node> *n = xform_change_nodes[i];
+			if (!n->in_list()) {
+				continue; // Already flushed by a previous notification.
+			}
+			xform_change_list.remove(n);
+			n->self()->notification(NOTIFICATION_TRANSFORM_CHANGED);
+		}
+	}
+
+	xform_batching = false;
+
+	if (xform_batch_instances.size()) {
+		RenderingServer::get_singleton()->instance_set_transforms(xform_batch_instances, xform_batch_transforms);
+		xform_batch_instances.clear();
+		xform_batch_transforms.clear();
 	}
 }
 
@@ -558,6 +604,9 @@ void SceneTree::finalize() {
 		root = nullptr;
 	}
 
+	// Pooled scene instances may keep their scene alive, release them along with the tree.
+	PackedScene::clear_pools();
+
 	// cleanup timers
 	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E; E = E->next()) {
 		E->get()->release_connections();
@@ -823,21 +872,72 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 
 	call_lock++;
 
-	for (int i = 0; i < node_count; i++) {
-		Node *n = nodes[i];
-		if (call_lock && call_skip.has(n)) {
-			continue;
+	if (process_thread_group_count > 0) {
+		// Split the pass: sub-thread groups run in parallel first, then their deferred
+		// calls are flushed, and then main thread nodes are processed as usual.
+		process_thread_groups_used = 0;
+		process_main_thread_nodes.clear();
+
+		for (int i = 0; i < node_count; i++) {
+			Node *n = nodes[i];
+			if (call_lock && call_skip.has(n)) {
+				continue;
+			}
+			if (!n->can_process() || !n->can_process_notification(p_notification)) {
+				continue;
+			}
+
+			Node *owner = n->data.process_thread_group_owner;
+			if (!owner) {
+				process_main_thread_nodes.push_back(n);
+				continue;
+			}
+
+			uint32_t index = owner->data.process_thread_group_index;
+			if (index >= process_thread_groups_used || process_thread_groups[index].owner != owner) {
+				index = process_thread_groups_used++;
+				if (index == process_thread_groups.size()) {
+					process_thread_groups.push_back(ProcessThreadGroup());
+				}
+				process_thread_groups[index].owner = owner;
+				process_thread_groups[index].nodes.clear();
+				owner->data.process_thread_group_index = index;
+			}
+			process_thread_groups[index].nodes.push_back(n);
 		}
 
-		if (!n->can_process()) {
-			continue;
+		if (process_thread_groups_used > 0) {
+			if (process_thread_work_pool.get_thread_count() == 0) {
+				process_thread_work_pool.init();
+			}
+			process_thread_work_pool.do_work(process_thread_groups_used, this, &SceneTree::_process_thread_group, p_notification);
+			_flush_process_thread_group_calls();
 		}
-		if (!n->can_process_notification(p_notification)) {
-			continue;
+
+		for (uint32_t i = 0; i < process_main_thread_nodes.size(); i++) {
+			Node *n = process_main_thread_nodes[i];
+			if (call_skip.has(n)) {
+				continue;
+			}
+			n->notification(p_notification);
 		}
+	} else {
+		for (int i = 0; i < node_count; i++) {
+			Node *n = nodes[i];
+			if (call_lock && call_skip.has(n)) {
+				continue;
+			}
 
-		n->notification(p_notification);
-		//ERR_FAIL_COND(node_count != g.nodes.size());
+			if (!n->can_process()) {
+				continue;
+			}
+			if (!n->can_process_notification(p_notification)) {
+				continue;
+			}
+
+			n->notification(p_notification);
+			//ERR_FAIL_COND(node_count != g.nodes.size());
+		}
 	}
 
 	call_lock--;
@@ -846,6 +946,58 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 	}
 }
 
+void SceneTree::_process_thread_group(uint32_t p_index, int p_notification) {
+	ProcessThreadGroup &group = process_thread_groups[p_index];
+	current_process_thread_group = &group;
+
+	for (uint32_t i = 0; i < group.nodes.size(); i++) {
+		group.nodes[i]->notification(p_notification);
+	}
+
+	current_process_thread_group = nullptr;
+}
+
+void SceneTree::_flush_process_thread_group_calls() {
+	for (uint32_t i = 0; i < process_thread_groups_used; i++) {
+		ProcessThreadGroup &group = process_thread_groups[i];
+		for (uint32_t j = 0; j < group.calls.size(); j++) {
+			const ProcessThreadGroup::Call &call = group.calls[j];
+			Object *obj = ObjectDB::get_instance(call.object);
+			if (!obj) {
+				continue;
+			}
+
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * MAX(1, call.args.size()));
+			for (int k = 0; k < call.args.size(); k++) {
+				argptrs[k] = &call.args[k];
+			}
+
+			Callable::CallError ce;
+			obj->call(call.method, argptrs, call.args.size(), ce);
+			if (ce.error != Callable::CallError::CALL_OK) {
+				ERR_PRINT("Error calling deferred method from process thread group: " + Variant::get_call_error_text(obj, call.method, argptrs, call.args.size(), ce) + ".");
+			}
+		}
+		group.calls.clear();
+	}
+}
+
+bool SceneTree::push_process_thread_group_call(Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount) {
+	if (!current_process_thread_group) {
+		return false;
+	}
+
+	ProcessThreadGroup::Call call;
+	call.object = p_object->get_instance_id();
+	call.method = p_method;
+	call.args.resize(p_argcount);
+	for (int i = 0; i < p_argcount; i++) {
+		call.args.write[i] = *p_args[i];
+	}
+	current_process_thread_group->calls.push_back(call);
+	return true;
+}
+
 /*
 void SceneMainLoop::_update_listener_2d() {
 	if (listener_2d.is_valid()) {
@@ -1107,6 +1259,145 @@ Error SceneTree::reload_current_scene() {
 	return change_scene(fname);
 }
 
+String SceneTree::_get_threaded_instantiation_path(const String &p_path) {
+	// Same as ResourceLoader, so requests for the same scene match regardless of how the path is written.
+	if (p_path.is_rel_path()) {
+		return "res://" + p_path;
+	}
+	return ProjectSettings::get_singleton()->localize_path(p_path);
+}
+
+void SceneTree::_threaded_instantiate(ThreadedInstantiation *p_instantiation) {
+	// Waits for the ResourceLoader if the scene is still loading.
+	Ref<PackedScene> scene = ResourceLoader::load_threaded_get(p_instantiation->path);
+	if (scene.is_valid()) {
+		// Nothing is inside the tree yet, and servers create their RIDs from any thread.
+		p_instantiation->node = scene->instantiate();
+	}
+
+	p_instantiation->done.set();
+	p_instantiation->done_semaphore.post(); // The request may be freed by the caller from now on.
+}
+
+void SceneTree::_threaded_instantiation_thread_function(void *p_userdata) {
+	SceneTree *tree = (SceneTree *)p_userdata;
+
+	while (true) {
+		tree->threaded_instantiation_semaphore.wait();
+		if (tree->threaded_instantiation_exit.is_set()) {
+			break;
+		}
+
+		ThreadedInstantiation *ti = nullptr;
+		{
+			MutexLock lock(tree->threaded_instantiation_mutex);
+			for (List<ThreadedInstantiation *>::Element *E = tree->threaded_instantiations.front(); E; E = E->next()) {
+				if (!E->get()->started) {
+					ti = E->get();
+					ti->started = true;
+					break;
+				}
+			}
+		}
+
+		// Nothing left if a caller already took the request.
+		if (ti) {
+			_threaded_instantiate(ti);
+		}
+	}
+}
+
+Error SceneTree::instantiate_threaded_request(const String &p_path) {
+	Error err = ResourceLoader::load_threaded_request(p_path, "PackedScene");
+	if (err != OK) {
+		return err;
+	}
+
+	ThreadedInstantiation *ti = memnew(ThreadedInstantiation);
+	ti->path = _get_threaded_instantiation_path(p_path);
+	{
+		MutexLock lock(threaded_instantiation_mutex);
+		threaded_instantiations.push_back(ti);
+		// Loading is already spread over the ResourceLoader threads, one thread is enough to instantiate.
+		if (!threaded_instantiation_thread.is_started()) {
+			threaded_instantiation_thread.start(_threaded_instantiation_thread_function, this);
+		}
+	}
+	threaded_instantiation_semaphore.post();
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus SceneTree::instantiate_threaded_get_status(const String &p_path) {
+	String path = _get_threaded_instantiation_path(p_path);
+	ResourceLoader::ThreadLoadStatus status = ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+	MutexLock lock(threaded_instantiation_mutex);
+	for (List<ThreadedInstantiation *>::Element *E = threaded_instantiations.front(); E; E = E->next()) {
+		ThreadedInstantiation *ti = E->get();
+		if (ti->path != path) {
+			continue;
+		}
+		if (!ti->done.is_set()) {
+			status = ResourceLoader::THREAD_LOAD_IN_PROGRESS;
+		} else if (ti->node) {
+			return ResourceLoader::THREAD_LOAD_LOADED; // At least one instance is ready.
+		} else if (status == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE) {
+			status = ResourceLoader::THREAD_LOAD_FAILED;
+		}
+	}
+
+	return status;
+}
+
+int SceneTree::_instantiate_threaded_get_status_bind(const String &p_path) {
+	return instantiate_threaded_get_status(p_path);
+}
+
+Node *SceneTree::instantiate_threaded_get(const String &p_path) {
+	String path = _get_threaded_instantiation_path(p_path);
+	ThreadedInstantiation *ti = nullptr;
+	bool started = false;
+
+	{
+		MutexLock lock(threaded_instantiation_mutex);
+
+		// Prefer an instance that is ready, then one in progress, then a failed one.
+		List<ThreadedInstantiation *>::Element *found = nullptr;
+		for (List<ThreadedInstantiation *>::Element *E = threaded_instantiations.front(); E; E = E->next()) {
+			if (E->get()->path != path) {
+				continue;
+			}
+			bool done = E->get()->done.is_set();
+			if (done && E->get()->node) {
+				found = E;
+				break;
+			}
+			if (!found || (!done && found->get()->done.is_set())) {
+				found = E;
+			}
+		}
+
+		ERR_FAIL_COND_V_MSG(!found, nullptr, "Attempted to get a scene instance that was not requested: " + p_path + ".");
+		ti = found->get();
+		threaded_instantiations.erase(found);
+		started = ti->started;
+		ti->started = true;
+	}
+
+	if (started) {
+		// Blocks until instantiated if still in progress.
+		ti->done_semaphore.wait();
+	} else {
+		// Still queued behind other requests, don't wait for them.
+		_threaded_instantiate(ti);
+	}
+	Node *node = ti->node;
+	memdelete(ti);
+
+	return node;
+}
+
 void SceneTree::add_current_scene(Node *p_current) {
 	current_scene = p_current;
 	root->add_child(p_current);
@@ -1221,6 +1512,10 @@ void SceneTree::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("reload_current_scene"), &SceneTree::reload_current_scene);
 
+	ClassDB::bind_method(D_METHOD("instantiate_threaded_request", "path"), &SceneTree::instantiate_threaded_request);
+	ClassDB::bind_method(D_METHOD("instantiate_threaded_get_status", "path"), &SceneTree::_instantiate_threaded_get_status_bind);
+	ClassDB::bind_method(D_METHOD("instantiate_threaded_get", "path"), &SceneTree::instantiate_threaded_get);
+
 	ClassDB::bind_method(D_METHOD("_change_scene"), &SceneTree::_change_scene);
 
 	ClassDB::bind_method(D_METHOD("set_multiplayer", "multiplayer"), &SceneTree::set_multiplayer);
@@ -1256,6 +1551,7 @@ void SceneTree::_bind_methods() {
 }
 
 SceneTree *SceneTree::singleton = nullptr;
+thread_local SceneTree::ProcessThreadGroup *SceneTree::current_process_thread_group = nullptr;
 
 SceneTree::IdleCallback SceneTree::idle_callbacks[SceneTree::MAX_IDLE_CALLBACKS];
 int SceneTree::idle_callback_count = 0;
@@ -1429,6 +1725,24 @@ SceneTree::SceneTree() {
 }
 
 SceneTree::~SceneTree() {
+	if (threaded_instantiation_thread.is_started()) {
+		threaded_instantiation_exit.set();
+		threaded_instantiation_semaphore.post();
+		threaded_instantiation_thread.wait_to_finish();
+	}
+	while (threaded_instantiations.size()) {
+		ThreadedInstantiation *ti = threaded_instantiations.front()->get();
+		threaded_instantiations.pop_front();
+		if (!ti->started) {
+			// Claim the pending load, so the ResourceLoader doesn't keep it around.
+			ResourceLoader::load_threaded_get(ti->path);
+		}
+		if (ti->node) {
+			memdelete(ti->node);
+		}
+		memdelete(ti);
+	}
+
 	if (root) {
 		root->_set_tree(nullptr);
 		root->_propagate_after_exit_tree();
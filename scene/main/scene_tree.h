@@ -32,9 +32,17 @@
 #define SCENE_TREE_H
 
 #include "core/io/multiplayer_api.h"
+#include "core/io/resource_loader.h"
 #include "core/os/main_loop.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/thread_work_pool.h"
 #include "scene/resources/mesh.h"
 #include "scene/resources/world_2d.h"
 #include "scene/resources/world_3d.h"
@@ -127,6 +135,31 @@ private:
 
 	List<ObjectID> delete_queue;
 
+	// Nodes in sub-thread groups are processed on worker threads, one group per task.
+	// Calls deferred from inside a group are flushed on the main thread, in group order,
+	// once every group is done.
+	struct ProcessThreadGroup {
+		struct Call {
+			ObjectID object;
+			StringName method;
+			Vector<Variant> args;
+		};
+
+		Node *owner = nullptr;
+		LocalVector<Node *> nodes;
+		LocalVector<Call> calls;
+	};
+
+	LocalVector<ProcessThreadGroup> process_thread_groups;
+	uint32_t process_thread_groups_used = 0;
+	LocalVector<Node *> process_main_thread_nodes;
+	int process_thread_group_count = 0; // Sub-thread groups inside the tree.
+	ThreadWorkPool process_thread_work_pool;
+	static thread_local ProcessThreadGroup *current_process_thread_group;
+
+	void _process_thread_group(uint32_t p_index, int p_notification);
+	void _flush_process_thread_group_calls();
+
 	Map<UGCall, Vector<Variant>> unique_group_calls;
 	bool ugc_locked = false;
 	void _flush_ugc();
@@ -136,6 +169,27 @@ private:
 
 	Array _get_nodes_in_group(const StringName &p_group);
 
+	// Scenes instantiated by a single worker thread, in request order, detached from the tree
+	// until added by the caller.
+	struct ThreadedInstantiation {
+		String path;
+		Node *node = nullptr; // Null if failed.
+		bool started = false; // Taken by the worker, or by a caller that couldn't wait for it.
+		SafeFlag done;
+		Semaphore done_semaphore;
+	};
+
+	Mutex threaded_instantiation_mutex;
+	List<ThreadedInstantiation *> threaded_instantiations;
+	Thread threaded_instantiation_thread;
+	Semaphore threaded_instantiation_semaphore;
+	SafeFlag threaded_instantiation_exit;
+
+	static void _threaded_instantiation_thread_function(void *p_userdata);
+	static void _threaded_instantiate(ThreadedInstantiation *p_instantiation);
+	static String _get_threaded_instantiation_path(const String &p_path);
+	int _instantiate_threaded_get_status_bind(const String &p_path);
+
 	Node *current_scene;
 
 	Color debug_collisions_color;
@@ -183,6 +237,18 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	SpinLock xform_change_lock; // Transforms can be changed from sub-thread process groups.
+	uint64_t xform_change_pass = 1; // Incremented every time transform notifications are flushed.
+	LocalVector<SelfList<Node> *> xform_change_nodes;
+
+	struct XFormChangeDepthSort {
+		bool operator()(const SelfList<Node> *p_a, const SelfList<Node> *p_b) const;
+	};
+
+	// Rendering instance transforms changed while flushing are sent to the RenderingServer in one call.
+	bool xform_batching = false;
+	Vector<RID> xform_batch_instances;
+	Vector<Transform3D> xform_batch_transforms;
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -231,6 +297,23 @@ public:
 
 	void flush_transform_notifications();
 
+	// Worker threads for nodes splitting their own work, only available to the main thread.
+	ThreadWorkPool *get_thread_work_pool();
+
+	// Returns false if not flushing transform notifications, the transform must be set right away then.
+	_FORCE_INLINE_ bool queue_instance_transform(RID p_instance, const Transform3D &p_transform) {
+		if (!xform_batching) {
+			return false;
+		}
+		xform_batch_instances.push_back(p_instance);
+		xform_batch_transforms.push_back(p_transform);
+		return true;
+	}
+
+	// Returns the owner of the sub-thread group processed by the calling thread, if any.
+	static Node *get_current_process_thread_group_owner() { return current_process_thread_group ? current_process_thread_group->owner : nullptr; }
+	static bool push_process_thread_group_call(Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount);
+
 	virtual void initialize() override;
 
 	virtual bool physics_process(float p_time) override;
@@ -313,6 +396,10 @@ public:
 	Error change_scene_to(const Ref<PackedScene> &p_scene);
 	Error reload_current_scene();
 
+	Error instantiate_threaded_request(const String &p_path);
+	ResourceLoader::ThreadLoadStatus instantiate_threaded_get_status(const String &p_path);
+	Node *instantiate_threaded_get(const String &p_path);
+
 	Ref<SceneTreeTimer> create_timer(float p_delay_sec, bool p_process_always = true);
 	Ref<Tween> create_tween();
 	Array get_processed_tweens();
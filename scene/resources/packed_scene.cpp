@@ -78,6 +78,15 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	const NodeData *nd = &nodes[0];
 
+	// Editor states keep setting properties by name, so they are marked as edited.
+	const CompiledNode *cnodes = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED) {
+		if (!program_valid.is_set()) {
+			_compile_program();
+		}
+		cnodes = program.ptr();
+	}
+
 	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
 
 	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.is_empty();
@@ -150,7 +159,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		} else {
 			Object *obj = nullptr;
 
-			if (ClassDB::is_class_enabled(snames[n.type])) {
+			if ((cnodes && cnodes[i].type != StringName()) || ClassDB::is_class_enabled(snames[n.type])) {
 				//node belongs to this scene and must be created
 				obj = ClassDB::instantiate(snames[n.type]);
 			}
@@ -187,6 +196,11 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			int nprop_count = n.properties.size();
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
+				// The node may be a placeholder, or something else entirely if instanced.
+				const CompiledProperty *cprops = nullptr;
+				if (cnodes && cnodes[i].type == node->get_class_name()) {
+					cprops = cnodes[i].properties.ptr();
+				}
 
 				for (int j = 0; j < nprop_count; j++) {
 					bool valid;
@@ -244,7 +258,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+						if (cprops && cprops[j].setter && !node->get_script_instance()) {
+							// Script properties take precedence over the class ones, so only when there is no script.
+							_set_compiled_property(node, cprops[j], value);
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -346,6 +365,160 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::_compile_program() const {
+	MutexLock lock(program_mutex);
+
+	if (program_valid.is_set()) {
+		return; // Compiled by another thread meanwhile.
+	}
+
+	program.resize(nodes.size());
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		CompiledNode &cn = program[i];
+		cn.type = StringName();
+		cn.properties.clear();
+
+		if ((i == 0 && base_scene_idx >= 0) || n.instance >= 0 || n.type == TYPE_INSTANCED) {
+			continue; // Class is only known after instancing, properties are set by name.
+		}
+
+		ERR_CONTINUE(n.type < 0 || n.type >= names.size());
+		const StringName &type = names[n.type];
+
+		// Extension classes can intercept properties before the class setters.
+		if (!ClassDB::is_class_enabled(type) || ClassDB::get_api_type(type) != ClassDB::API_CORE) {
+			continue;
+		}
+
+		cn.type = type;
+		cn.properties.resize(n.properties.size());
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			CompiledProperty &cp = cn.properties[j];
+			cp.setter = nullptr;
+			cp.index = -1;
+
+			ERR_CONTINUE(n.properties[j].name < 0 || n.properties[j].name >= names.size());
+			const StringName &pname = names[n.properties[j].name];
+			if (pname == CoreStringNames::get_singleton()->_script) {
+				continue;
+			}
+
+			const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(type, pname);
+			if (psg && psg->_setptr) {
+				cp.setter = psg->_setptr;
+				cp.index = psg->index;
+			}
+		}
+	}
+
+	program_valid.set();
+}
+
+void SceneState::_set_compiled_property(Object *p_object, const CompiledProperty &p_property, const Variant &p_value) {
+	Callable::CallError ce;
+
+	if (p_property.index >= 0) {
+		Variant index = p_property.index;
+		const Variant *args[2] = { &index, &p_value };
+		p_property.setter->call(p_object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		p_property.setter->call(p_object, args, 1, ce);
+	}
+}
+
+void SceneState::reset_instance(Node *p_root) const {
+	ERR_FAIL_NULL(p_root);
+
+	int nc = nodes.size();
+	ERR_FAIL_COND(nc == 0);
+
+	if (!program_valid.is_set()) {
+		_compile_program();
+	}
+
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+	int sname_count = names.size();
+	int prop_count = variants.size();
+
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+
+		Node *node = nullptr;
+		if (i == 0) {
+			node = p_root;
+		} else {
+			Node *parent = nullptr;
+			if (n.parent & FLAG_ID_IS_PATH) {
+				parent = p_root->get_node_or_null(node_paths[n.parent & FLAG_MASK]);
+			} else if (n.parent >= 0 && n.parent < i) {
+				parent = ret_nodes[n.parent];
+			}
+			if (parent) {
+				node = parent->_get_child_by_name(snames[n.name]);
+			}
+		}
+
+		ret_nodes[i] = node;
+		if (!node) {
+			continue; // Removed since it was instanced.
+		}
+
+		// Instanced scenes reset their own properties first, the ones stored here override them.
+		Ref<PackedScene> sdata;
+		if (i == 0 && base_scene_idx >= 0) {
+			sdata = props[base_scene_idx];
+		} else if (n.instance >= 0 && !(n.instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
+			sdata = props[n.instance & FLAG_MASK];
+		}
+		if (sdata.is_valid()) {
+			sdata->get_state()->reset_instance(node);
+		}
+
+		const CompiledProperty *cprops = nullptr;
+		if (program[i].type == node->get_class_name()) {
+			cprops = program[i].properties.ptr();
+		}
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			ERR_CONTINUE(prop.name < 0 || prop.name >= sname_count);
+			ERR_CONTINUE(prop.value < 0 || prop.value >= prop_count);
+
+			if (snames[prop.name] == CoreStringNames::get_singleton()->_script) {
+				continue; // Keep the script, and the state of its instance.
+			}
+
+			const Variant &value = props[prop.value];
+			if (value.get_type() == Variant::OBJECT) {
+				Ref<Resource> res = value;
+				if (res.is_valid() && res->is_local_to_scene()) {
+					continue; // Keep the copy made for this instance.
+				}
+			}
+
+			if (cprops && cprops[j].setter && !node->get_script_instance()) {
+				_set_compiled_property(node, cprops[j], value);
+			} else {
+				node->set(snames[prop.name], value);
+			}
+		}
+
+		for (int j = 0; j < n.groups.size(); j++) {
+			ERR_CONTINUE(n.groups[j] < 0 || n.groups[j] >= sname_count);
+			node->add_to_group(snames[n.groups[j]], true);
+		}
+
+		node->request_ready();
+	}
+}
+
 static int _nm_get_string(const String &p_string, Map<StringName, int> &name_map) {
 	if (name_map.has(p_string)) {
 		return name_map[p_string];
@@ -922,6 +1095,7 @@ void SceneState::clear() {
 	node_paths.clear();
 	editable_instances.clear();
 	base_scene_idx = -1;
+	_invalidate_program();
 }
 
 Ref<SceneState> SceneState::_get_base_scene_state() const {
@@ -1072,6 +1246,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_invalidate_program();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1517,6 +1693,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	_invalidate_program();
 
 	return nodes.size() - 1;
 }
@@ -1530,6 +1707,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	prop.name = p_name;
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_invalidate_program();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -1541,6 +1719,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
+	_invalidate_program();
 }
 
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, const Vector<int> &p_binds) {
@@ -1622,6 +1801,7 @@ Error PackedScene::pack(Node *p_scene) {
 }
 
 void PackedScene::clear() {
+	_clear_pool();
 	state->clear();
 }
 
@@ -1634,6 +1814,21 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	ERR_FAIL_COND_V_MSG(p_edit_state != GEN_EDIT_STATE_DISABLED, nullptr, "Edit state is only for editors, does not work without tools compiled.");
 #endif
 
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && pool_size > 0) {
+		Node *recycled = nullptr;
+		{
+			MutexLock lock(pool_mutex);
+			if (pool.size()) {
+				recycled = pool[pool.size() - 1];
+				pool.resize(pool.size() - 1);
+			}
+		}
+		if (recycled) {
+			state->reset_instance(recycled);
+			return recycled;
+		}
+	}
+
 	Node *s = state->instantiate((SceneState::GenEditState)p_edit_state);
 	if (!s) {
 		return nullptr;
@@ -1652,7 +1847,95 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+void PackedScene::set_pool_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+
+	{
+		MutexLock scenes_lock(pooled_scenes_mutex);
+		if (p_size > 0 && !pooled_scene_item.in_list()) {
+			pooled_scenes.add(&pooled_scene_item);
+		} else if (p_size == 0 && pooled_scene_item.in_list()) {
+			pooled_scenes.remove(&pooled_scene_item);
+		}
+	}
+
+	LocalVector<Node *> freed;
+	{
+		MutexLock lock(pool_mutex);
+		pool_size = p_size;
+		while ((int)pool.size() > pool_size) {
+			freed.push_back(pool[pool.size() - 1]);
+			pool.resize(pool.size() - 1);
+		}
+	}
+
+	// Freeing may release the last reference to this scene, so it's done without the lock.
+	for (uint32_t i = 0; i < freed.size(); i++) {
+		memdelete(freed[i]);
+	}
+}
+
+int PackedScene::get_pool_size() const {
+	return pool_size;
+}
+
+bool PackedScene::recycle_instance(Node *p_node) {
+	ERR_FAIL_NULL_V(p_node, false);
+	ERR_FAIL_COND_V_MSG(p_node->is_queued_for_deletion(), false, "Can't recycle a node queued for deletion.");
+	ERR_FAIL_COND_V_MSG(get_path() != "" && get_path().find("::") == -1 && p_node->get_filename() != get_path(), false, "Node '" + p_node->get_name() + "' was not instantiated from scene '" + get_path() + "'.");
+
+	{
+		MutexLock lock(pool_mutex);
+		if ((int)pool.size() >= pool_size) {
+			return false;
+		}
+	}
+
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+	}
+
+	MutexLock lock(pool_mutex);
+	if ((int)pool.size() >= pool_size) {
+		return false; // Filled by another thread meanwhile, the caller still owns the node.
+	}
+	pool.push_back(p_node);
+	return true;
+}
+
+void PackedScene::_clear_pool() {
+	LocalVector<Node *> freed;
+	{
+		MutexLock lock(pool_mutex);
+		SWAP(freed, pool);
+	}
+	for (uint32_t i = 0; i < freed.size(); i++) {
+		memdelete(freed[i]);
+	}
+}
+
+void PackedScene::clear_pools() {
+	// Pooled nodes may keep their own scene alive (e.g. through a script preloading it),
+	// so pools are only released here or when the pool size is set back to 0.
+	LocalVector<Node *> freed;
+	{
+		MutexLock scenes_lock(pooled_scenes_mutex);
+		for (SelfList<PackedScene> *E = pooled_scenes.first(); E; E = E->next()) {
+			PackedScene *scene = E->self();
+			MutexLock lock(scene->pool_mutex);
+			for (uint32_t i = 0; i < scene->pool.size(); i++) {
+				freed.push_back(scene->pool[i]);
+			}
+			scene->pool.clear();
+		}
+	}
+	for (uint32_t i = 0; i < freed.size(); i++) {
+		memdelete(freed[i]);
+	}
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	_clear_pool();
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -1661,6 +1944,7 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	_clear_pool();
 	state = Ref<SceneState>(memnew(SceneState));
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -1684,6 +1968,9 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
+	ClassDB::bind_method(D_METHOD("set_pool_size", "size"), &PackedScene::set_pool_size);
+	ClassDB::bind_method(D_METHOD("get_pool_size"), &PackedScene::get_pool_size);
+	ClassDB::bind_method(D_METHOD("recycle_instance", "node"), &PackedScene::recycle_instance);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
@@ -1695,6 +1982,22 @@ void PackedScene::_bind_methods() {
 	BIND_ENUM_CONSTANT(GEN_EDIT_STATE_MAIN);
 }
 
-PackedScene::PackedScene() {
+SelfList<PackedScene>::List PackedScene::pooled_scenes;
+Mutex PackedScene::pooled_scenes_mutex;
+
+PackedScene::PackedScene() :
+		pooled_scene_item(this) {
 	state = Ref<SceneState>(memnew(SceneState));
 }
+
+PackedScene::~PackedScene() {
+	{
+		MutexLock scenes_lock(pooled_scenes_mutex);
+		if (pooled_scene_item.in_list()) {
+			pooled_scenes.remove(&pooled_scene_item);
+		}
+	}
+	for (uint32_t i = 0; i < pool.size(); i++) {
+		memdelete(pool[i]);
+	}
+}
@@ -32,6 +32,10 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/self_list.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -87,6 +91,26 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Node properties resolved against the class of the node, so instancing calls the setters
+	// directly instead of looking every property up by name. Built on first instantiation.
+	struct CompiledProperty {
+		MethodBind *setter = nullptr; // If null, the property is set by name.
+		int index = -1;
+	};
+
+	struct CompiledNode {
+		StringName type; // Empty if the class is only known once instanced.
+		LocalVector<CompiledProperty> properties;
+	};
+
+	mutable LocalVector<CompiledNode> program;
+	mutable SafeFlag program_valid;
+	mutable Mutex program_mutex;
+
+	void _compile_program() const;
+	_FORCE_INLINE_ void _invalidate_program() { program_valid.clear(); }
+	static void _set_compiled_property(Object *p_object, const CompiledProperty &p_property, const Variant &p_value);
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -138,6 +162,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state) const;
+	void reset_instance(Node *p_root) const;
 
 	//unbuild API
 
@@ -194,6 +219,18 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	// Instances given back with recycle_instance(), reused by instantiate().
+	// Pooled nodes hold references to their resources, possibly to this scene too, so
+	// scenes with pooling enabled are tracked to release every pool when the tree ends.
+	mutable Mutex pool_mutex;
+	mutable LocalVector<Node *> pool;
+	int pool_size = 0;
+	SelfList<PackedScene> pooled_scene_item;
+	static SelfList<PackedScene>::List pooled_scenes;
+	static Mutex pooled_scenes_mutex;
+
+	void _clear_pool();
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -216,6 +253,11 @@ public:
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	void set_pool_size(int p_size);
+	int get_pool_size() const;
+	bool recycle_instance(Node *p_node);
+	static void clear_pools();
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -227,6 +269,7 @@ public:
 	Ref<SceneState> get_state();
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
@@ -30,8 +30,11 @@
 
 #include "texture.h"
 
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
 #include "core/core_string_names.h"
 #include "core/io/image_loader.h"
+#include "core/object/message_queue.h"
 #include "core/os/os.h"
 #include "mesh.h"
 #include "scene/resources/bit_map.h"
@@ -411,24 +414,25 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 				}
 			}
 
-			image->create(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->create(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
 	} else if (data_format == DATA_FORMAT_IMAGE) {
 		int size = Image::get_image_data_size(w, h, format, mipmaps ? true : false);
+		uint64_t data_start = f->get_position();
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			//only the mipmaps from here on are read from the file
+			f->seek(data_start + ofs);
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -535,6 +539,14 @@ Error StreamTexture2D::_load_data(const String &p_path, int &r_width, int &r_hei
 		p_size_limit = 0;
 	}
 
+	//the image may have been resized on import, streaming needs the size it was stored at
+	uint64_t image_start = f->get_position();
+	f->get_32(); //data format
+	int stored_width = f->get_16();
+	int stored_height = f->get_16();
+	stream_full_size = MAX(stored_width, stored_height);
+	f->seek(image_start);
+
 	image = load_image_from_file(f, p_size_limit);
 
 	memdelete(f);
@@ -555,8 +567,11 @@ Error StreamTexture2D::load(const String &p_path) {
 	bool request_normal;
 	bool request_roughness;
 	int mipmap_limit;
+	int size_limit = streaming_enabled ? streaming_initial_size : 0;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	_stream_stop();
+
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, size_limit);
 	if (err) {
 		return err;
 	}
@@ -608,11 +623,187 @@ Error StreamTexture2D::load(const String &p_path) {
 	}
 
 #endif
+
+	// Only the initial mipmaps were read if the file allows streaming, request the rest when needed.
+	streamed = size_limit > 0 && image->has_mipmaps() && MAX(image->get_width(), image->get_height()) < stream_full_size;
+	if (streamed) {
+		stream_mutex.lock();
+		streamed_textures.insert(this);
+		stream_mutex.unlock();
+		RS::get_singleton()->texture_set_stream_callback(texture, _requested_stream, this);
+	} else {
+		RS::get_singleton()->texture_set_stream_callback(texture, nullptr, nullptr);
+	}
+
 	notify_property_list_changed();
 	emit_changed();
 	return OK;
 }
 
+void StreamTexture2D::_requested_stream(void *p_ud, int p_size) {
+	StreamTexture2D *st = (StreamTexture2D *)p_ud;
+	MutexLock lock(stream_mutex);
+	if (!streamed_textures.has(st)) {
+		return; //freed or reloaded since the renderer was told about it
+	}
+	st->stream_size = p_size;
+	if (!st->stream_element.in_list()) {
+		stream_queue.add_last(&st->stream_element);
+		stream_semaphore.post();
+	}
+}
+
+void StreamTexture2D::_stream_thread_function(void *p_ud) {
+	while (true) {
+		stream_semaphore.wait();
+
+		stream_mutex.lock();
+		if (stream_thread_exit) {
+			stream_mutex.unlock();
+			break;
+		}
+		SelfList<StreamTexture2D> *E = stream_queue.first();
+		if (!E) {
+			stream_mutex.unlock();
+			continue;
+		}
+		StreamTexture2D *st = E->self();
+		stream_queue.remove(E);
+
+		String path = st->path_to_file;
+		ObjectID id = st->get_instance_id();
+		uint32_t generation = st->stream_generation;
+		//requests are relative to the size override, which may differ from the stored size
+		int size_limit = int(Math::ceil(double(st->stream_size) * st->stream_full_size / MAX(MAX(st->w, st->h), 1)));
+		stream_in_progress = st;
+		stream_in_progress_mutex.lock();
+		stream_mutex.unlock();
+
+		Ref<Image> image = _load_stream_mipmaps(path, size_limit);
+		if (image.is_valid()) {
+			//textures can't be replaced from here, and the texture may be freed or reloaded before the
+			//message is flushed, so it's looked up by ID and the generation is checked on arrival
+			MessageQueue::get_singleton()->push_call(id, "_stream_loaded", image, generation);
+		}
+
+		stream_mutex.lock();
+		stream_in_progress = nullptr;
+		stream_in_progress_mutex.unlock();
+		stream_mutex.unlock();
+	}
+}
+
+Ref<Image> StreamTexture2D::_load_stream_mipmaps(const String &p_path, int p_size_limit) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(!f, Ref<Image>(), vformat("Unable to open file: %s.", p_path));
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'G' || header[1] != 'S' || header[2] != 'T' || header[3] != '2') {
+		memdelete(f);
+		ERR_FAIL_V_MSG(Ref<Image>(), "Stream texture file is corrupt (Bad header).");
+	}
+
+	//version, size and format were validated when the texture was loaded
+	f->get_32();
+	f->get_32();
+	f->get_32();
+	f->get_32();
+	//reserved
+	f->get_32();
+	f->get_32();
+	f->get_32();
+	f->get_32();
+
+	Ref<Image> image = load_image_from_file(f, p_size_limit);
+	memdelete(f);
+
+	if (image.is_null() || image->is_empty()) {
+		return Ref<Image>();
+	}
+	return image;
+}
+
+void StreamTexture2D::_stream_loaded(const Ref<Image> &p_image, uint32_t p_generation) {
+	if (!streamed || !texture.is_valid()) {
+		return;
+	}
+
+	stream_mutex.lock();
+	bool current = p_generation == stream_generation;
+	stream_mutex.unlock();
+	if (!current) {
+		return; //read from a file that was reloaded since
+	}
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+	alpha_cache.unref();
+}
+
+void StreamTexture2D::_stream_stop() {
+	if (!streamed) {
+		return;
+	}
+
+	stream_mutex.lock();
+	streamed_textures.erase(this);
+	stream_generation++;
+	if (stream_element.in_list()) {
+		stream_queue.remove(&stream_element);
+	}
+	bool in_progress = stream_in_progress == this;
+	stream_mutex.unlock();
+
+	if (in_progress) {
+		//wait for the thread to be done with this texture
+		stream_in_progress_mutex.lock();
+		stream_in_progress_mutex.unlock();
+	}
+
+	streamed = false;
+}
+
+bool StreamTexture2D::streaming_enabled = false;
+int StreamTexture2D::streaming_initial_size = 0;
+bool StreamTexture2D::stream_thread_exit = false;
+Thread StreamTexture2D::stream_thread;
+Semaphore StreamTexture2D::stream_semaphore;
+Mutex StreamTexture2D::stream_mutex;
+Mutex StreamTexture2D::stream_in_progress_mutex;
+Set<StreamTexture2D *> StreamTexture2D::streamed_textures;
+SelfList<StreamTexture2D>::List StreamTexture2D::stream_queue;
+StreamTexture2D *StreamTexture2D::stream_in_progress = nullptr;
+
+void StreamTexture2D::initialize_streaming() {
+	streaming_enabled = bool(GLOBAL_GET("rendering/textures/streaming/enabled")) && !Engine::get_singleton()->is_editor_hint();
+	if (!streaming_enabled) {
+		return;
+	}
+
+	streaming_initial_size = MAX(int(GLOBAL_GET("rendering/textures/streaming/initial_size")), 1);
+	stream_thread_exit = false;
+	stream_thread.start(_stream_thread_function, nullptr);
+}
+
+void StreamTexture2D::finalize_streaming() {
+	if (!streaming_enabled) {
+		return;
+	}
+
+	stream_mutex.lock();
+	stream_thread_exit = true;
+	stream_mutex.unlock();
+	stream_semaphore.post();
+	stream_thread.wait_to_finish();
+
+	while (stream_queue.first()) {
+		stream_queue.remove(stream_queue.first());
+	}
+	streaming_enabled = false;
+}
+
 String StreamTexture2D::get_load_path() const {
 	return path_to_file;
 }
@@ -720,13 +911,17 @@ void StreamTexture2D::_validate_property(PropertyInfo &property) const {
 void StreamTexture2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "path"), &StreamTexture2D::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &StreamTexture2D::get_load_path);
+	ClassDB::bind_method(D_METHOD("_stream_loaded", "image", "generation"), &StreamTexture2D::_stream_loaded);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.stex"), "load", "get_load_path");
 }
 
-StreamTexture2D::StreamTexture2D() {}
+StreamTexture2D::StreamTexture2D() :
+		stream_element(this) {}
 
 StreamTexture2D::~StreamTexture2D() {
+	_stream_stop();
+
 	if (texture.is_valid()) {
 		RS::get_singleton()->free(texture);
 	}
@@ -37,6 +37,8 @@
 #include "core/math/rect2.h"
 #include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "scene/resources/curve.h"
 #include "scene/resources/gradient.h"
@@ -169,6 +171,32 @@ private:
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
 
+	// Mipmap streaming, for textures imported with compress/streamed. The renderer asks for a size
+	// through _requested_stream, which queues the texture for the stream thread to read the mipmaps
+	// from the file. They are uploaded with _stream_loaded on the main thread.
+	bool streamed = false;
+	int stream_full_size = 0; // Largest dimension of the full size image stored in the file.
+	int stream_size = 0; // Requested size, in the same space as w and h. Protected by stream_mutex.
+	uint32_t stream_generation = 0; // Bumped when streaming stops, so mipmaps read before are dropped. Protected by stream_mutex.
+	SelfList<StreamTexture2D> stream_element;
+
+	static bool streaming_enabled;
+	static int streaming_initial_size;
+	static bool stream_thread_exit;
+	static Thread stream_thread;
+	static Semaphore stream_semaphore;
+	static Mutex stream_mutex; // Protects the queue and the set of streamed textures.
+	static Mutex stream_in_progress_mutex; // Held by the thread while a texture is read.
+	static Set<StreamTexture2D *> streamed_textures;
+	static SelfList<StreamTexture2D>::List stream_queue;
+	static StreamTexture2D *stream_in_progress;
+
+	static void _requested_stream(void *p_ud, int p_size);
+	static void _stream_thread_function(void *p_ud);
+	static Ref<Image> _load_stream_mipmaps(const String &p_path, int p_size_limit);
+	void _stream_loaded(const Ref<Image> &p_image, uint32_t p_generation);
+	void _stream_stop();
+
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &property) const override;
@@ -202,6 +230,9 @@ public:
 
 	virtual Ref<Image> get_image() const override;
 
+	static void initialize_streaming();
+	static void finalize_streaming();
+
 	StreamTexture2D();
 	~StreamTexture2D();
 };
@@ -30,6 +30,8 @@
 
 #include "body_2d_sw.h"
 #include "area_2d_sw.h"
+#include "constraint_2d_sw.h"
+#include "deterministic_math_2d_sw.h"
 #include "physics_server_2d_sw.h"
 #include "space_2d_sw.h"
 
@@ -325,6 +327,46 @@ Variant Body2DSW::get_state(PhysicsServer2D::BodyState p_state) const {
 	return Variant();
 }
 
+void Body2DSW::save_simulation_state(SimulationState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.biased_linear_velocity = biased_linear_velocity;
+	r_state.applied_force = applied_force;
+	r_state.angular_velocity = angular_velocity;
+	r_state.biased_angular_velocity = biased_angular_velocity;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void Body2DSW::restore_simulation_state(const SimulationState &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	biased_linear_velocity = p_state.biased_linear_velocity;
+	applied_force = p_state.applied_force;
+	angular_velocity = p_state.angular_velocity;
+	biased_angular_velocity = p_state.biased_angular_velocity;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+}
+
+void Body2DSW::add_constraint(Constraint2DSW *p_constraint, int p_pos) {
+	// Kept sorted, see Constraint2DSW::Comparator. New constraints usually go last.
+	Constraint2DSW::Comparator less;
+	for (List<Pair<Constraint2DSW *, int>>::Element *E = constraint_list.back(); E; E = E->prev()) {
+		if (!less(p_constraint, E->get().first)) {
+			constraint_list.insert_after(E, { p_constraint, p_pos });
+			return;
+		}
+	}
+	constraint_list.push_front({ p_constraint, p_pos });
+}
+
 void Body2DSW::set_space(Space2DSW *p_space) {
 	if (get_space()) {
 		wakeup_neighbours();
@@ -356,7 +398,8 @@ void Body2DSW::_compute_area_gravity_and_dampenings(const Area2DSW *p_area) {
 	if (p_area->is_gravity_point()) {
 		if (p_area->get_gravity_distance_scale() > 0) {
 			Vector2 v = p_area->get_transform().xform(p_area->get_gravity_vector()) - get_transform().get_origin();
-			gravity += v.normalized() * (p_area->get_gravity() / Math::pow(v.length() * p_area->get_gravity_distance_scale() + 1, 2));
+			real_t d = v.length() * p_area->get_gravity_distance_scale() + 1;
+			gravity += v.normalized() * (p_area->get_gravity() / (d * d));
 		} else {
 			gravity += (p_area->get_transform().xform(p_area->get_gravity_vector()) - get_transform().get_origin()).normalized() * p_area->get_gravity();
 		}
@@ -437,7 +480,13 @@ void Body2DSW::integrate_forces(real_t p_step) {
 		motion = new_transform.get_origin() - get_transform().get_origin();
 		linear_velocity = motion / p_step;
 
-		real_t rot = new_transform.get_rotation() - get_transform().get_rotation();
+		real_t rot;
+		if (get_space()->is_deterministic()) {
+			const Transform2D &xform = get_transform();
+			rot = DeterministicMath2DSW::atan2(new_transform.elements[0].y, new_transform.elements[0].x) - DeterministicMath2DSW::atan2(xform.elements[0].y, xform.elements[0].x);
+		} else {
+			rot = new_transform.get_rotation() - get_transform().get_rotation();
+		}
 		angular_velocity = remainder(rot, 2.0 * Math_PI) / p_step;
 
 		do_motion = true;
@@ -518,10 +567,26 @@ void Body2DSW::integrate_velocities(real_t p_step) {
 	real_t total_angular_velocity = angular_velocity + biased_angular_velocity;
 	Vector2 total_linear_velocity = linear_velocity + biased_linear_velocity;
 
-	real_t angle = get_transform().get_rotation() + total_angular_velocity * p_step;
 	Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	Transform2D xform;
+	if (get_space()->is_deterministic()) {
+		// Rotate the current basis instead of rebuilding it from the angle, so no trigonometric functions
+		// from the C library are needed.
+		real_t angle = total_angular_velocity * p_step;
+		real_t s = DeterministicMath2DSW::sin(angle);
+		real_t c = DeterministicMath2DSW::cos(angle);
+		const Transform2D &prev = get_transform();
+		xform.elements[0] = Vector2(c * prev.elements[0].x - s * prev.elements[0].y, s * prev.elements[0].x + c * prev.elements[0].y);
+		xform.elements[1] = Vector2(c * prev.elements[1].x - s * prev.elements[1].y, s * prev.elements[1].x + c * prev.elements[1].y);
+		xform.orthonormalize();
+		xform.elements[2] = pos;
+	} else {
+		real_t angle = get_transform().get_rotation() + total_angular_velocity * p_step;
+		xform = Transform2D(angle, pos);
+	}
+
+	_set_transform(xform, continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
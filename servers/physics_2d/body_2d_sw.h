@@ -91,7 +91,13 @@ class Body2DSW : public CollisionObject2DSW {
 		Area2DSW *area;
 		int refCount;
 		_FORCE_INLINE_ bool operator==(const AreaCMP &p_cmp) const { return area->get_self() == p_cmp.area->get_self(); }
-		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const { return area->get_priority() < p_cmp.area->get_priority(); }
+		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const {
+			// Areas with the same priority are sorted by RID, so the order doesn't depend on the order they were added.
+			if (area->get_priority() == p_cmp.area->get_priority()) {
+				return area->get_self() < p_cmp.area->get_self();
+			}
+			return area->get_priority() < p_cmp.area->get_priority();
+		}
 		_FORCE_INLINE_ AreaCMP() {}
 		_FORCE_INLINE_ AreaCMP(Area2DSW *p_area) {
 			area = p_area;
@@ -172,7 +178,7 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
-	_FORCE_INLINE_ void add_constraint(Constraint2DSW *p_constraint, int p_pos) { constraint_list.push_back({ p_constraint, p_pos }); }
+	void add_constraint(Constraint2DSW *p_constraint, int p_pos);
 	_FORCE_INLINE_ void remove_constraint(Constraint2DSW *p_constraint, int p_pos) { constraint_list.erase({ p_constraint, p_pos }); }
 	const List<Pair<Constraint2DSW *, int>> &get_constraint_list() const { return constraint_list; }
 	_FORCE_INLINE_ void clear_constraint_list() { constraint_list.clear(); }
@@ -229,6 +235,24 @@ public:
 	void set_state(PhysicsServer2D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer2D::BodyState p_state) const;
 
+	// Everything that changes while simulating, see Space2DSW::save_state().
+	struct SimulationState {
+		Transform2D transform;
+		Transform2D inv_transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		Vector2 biased_linear_velocity;
+		Vector2 applied_force;
+		real_t angular_velocity = 0.0;
+		real_t biased_angular_velocity = 0.0;
+		real_t applied_torque = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_simulation_state(SimulationState &r_state) const;
+	void restore_simulation_state(const SimulationState &p_state);
+
 	void set_applied_force(const Vector2 &p_force) { applied_force = p_force; }
 	Vector2 get_applied_force() const { return applied_force; }
 
@@ -522,6 +522,49 @@ void BodyPair2DSW::solve(real_t p_step) {
 	}
 }
 
+uint32_t BodyPair2DSW::get_state_size() const {
+	return sizeof(StateHeader) + contact_count * sizeof(Contact);
+}
+
+void BodyPair2DSW::save_state(uint8_t *r_data) const {
+	StateHeader header;
+	memset((void *)&header, 0, sizeof(StateHeader)); // Keep the padding deterministic.
+	header.offset_B = offset_B;
+	header.sep_axis = sep_axis;
+	header.contact_count = contact_count;
+	header.collided = collided;
+	header.oneway_disabled = oneway_disabled;
+
+	memcpy(r_data, &header, sizeof(StateHeader));
+	memcpy(r_data + sizeof(StateHeader), contacts, contact_count * sizeof(Contact));
+}
+
+uint32_t BodyPair2DSW::restore_state(const uint8_t *p_data, uint32_t p_size) {
+	ERR_FAIL_COND_V(p_size < sizeof(StateHeader), 0);
+
+	StateHeader header;
+	memcpy(&header, p_data, sizeof(StateHeader));
+	ERR_FAIL_COND_V(header.contact_count < 0 || header.contact_count > MAX_CONTACTS, 0);
+
+	uint32_t size = sizeof(StateHeader) + header.contact_count * sizeof(Contact);
+	ERR_FAIL_COND_V(p_size < size, 0);
+
+	offset_B = header.offset_B;
+	sep_axis = header.sep_axis;
+	contact_count = header.contact_count;
+	collided = header.collided;
+	oneway_disabled = header.oneway_disabled;
+	memcpy(contacts, p_data + sizeof(StateHeader), contact_count * sizeof(Contact));
+
+	return size;
+}
+
+void BodyPair2DSW::clear_state() {
+	contact_count = 0;
+	collided = false;
+	oneway_disabled = false;
+}
+
 BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_shape_B) :
 		Constraint2DSW(_arr, 2) {
 	A = p_A;
@@ -529,6 +572,7 @@ BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_sh
 	shape_A = p_shape_A;
 	shape_B = p_shape_B;
 	space = A->get_space();
+	set_sort_key(A->get_self().get_id(), B->get_self().get_id(), (uint64_t(shape_A) << 32) | uint32_t(shape_B));
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
 }
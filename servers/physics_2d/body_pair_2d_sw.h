@@ -81,6 +81,14 @@ class BodyPair2DSW : public Constraint2DSW {
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
 
+	struct StateHeader {
+		Vector2 offset_B;
+		Vector2 sep_axis;
+		int32_t contact_count;
+		bool collided;
+		bool oneway_disabled;
+	};
+
 	bool _test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const Transform2D &p_xform_A, Body2DSW *p_B, int p_shape_B, const Transform2D &p_xform_B, bool p_swap_result = false);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
@@ -91,6 +99,19 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual BodyPair2DSW *get_body_pair() override { return this; }
+
+	_FORCE_INLINE_ Body2DSW *get_body_A() const { return A; }
+	_FORCE_INLINE_ Body2DSW *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
+	// Contacts and accumulated impulses used for warm starting, see Space2DSW::save_state().
+	uint32_t get_state_size() const;
+	void save_state(uint8_t *r_data) const;
+	uint32_t restore_state(const uint8_t *p_data, uint32_t p_size);
+	void clear_state();
+
 	BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_shape_B);
 	~BodyPair2DSW();
 };
@@ -103,6 +103,10 @@ void BroadPhase2DBVH::update() {
 	bvh.update();
 }
 
+void BroadPhase2DBVH::reset_pairs() {
+	bvh.force_collision_check_all();
+}
+
 BroadPhase2DSW *BroadPhase2DBVH::_create() {
 	return memnew(BroadPhase2DBVH);
 }
@@ -65,6 +65,7 @@ public:
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata);
 
 	virtual void update();
+	virtual void reset_pairs();
 
 	static BroadPhase2DSW *_create();
 	BroadPhase2DBVH();
@@ -64,6 +64,9 @@ public:
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
 	virtual void update() = 0;
+	// Like update(), but the pairs only depend on the current AABBs afterwards, not
+	// on how the objects moved before. Used to save and restore space states.
+	virtual void reset_pairs() = 0;
 
 	virtual ~BroadPhase2DSW();
 };
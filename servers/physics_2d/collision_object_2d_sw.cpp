@@ -189,6 +189,19 @@ void CollisionObject2DSW::_update_shapes() {
 	}
 }
 
+// Shape AABBs are grown based on their previous size, so they're part of the
+// state saved by the space.
+void CollisionObject2DSW::restore_shape_aabb(int p_index, const Rect2 &p_aabb) {
+	ERR_FAIL_INDEX(p_index, shapes.size());
+	Shape &s = shapes.write[p_index];
+	if (s.disabled || s.bpid == 0) {
+		return;
+	}
+
+	s.aabb_cache = p_aabb;
+	space->get_broadphase()->move(s.bpid, p_aabb);
+}
+
 void CollisionObject2DSW::_update_shapes_with_motion(const Vector2 &p_motion) {
 	if (!space) {
 		return;
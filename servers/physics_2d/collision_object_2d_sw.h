@@ -134,6 +134,7 @@ public:
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].aabb_cache;
 	}
+	void restore_shape_aabb(int p_index, const Rect2 &p_aabb);
 	_FORCE_INLINE_ const Variant &get_shape_metadata(int p_index) const {
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].metadata;
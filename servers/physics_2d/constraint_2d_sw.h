@@ -33,11 +33,14 @@
 
 #include "body_2d_sw.h"
 
+class BodyPair2DSW;
+
 class Constraint2DSW {
 	Body2DSW **_body_ptr;
 	int _body_count;
 	uint64_t island_step;
 	bool disabled_collisions_between_bodies;
+	uint64_t sort_key[3] = {};
 
 	RID self;
 
@@ -49,7 +52,29 @@ protected:
 		disabled_collisions_between_bodies = true;
 	}
 
+	// Must be set before the constraint is added to the bodies, and be unique among
+	// the constraints of a body.
+	_FORCE_INLINE_ void set_sort_key(uint64_t p_a, uint64_t p_b, uint64_t p_c) {
+		sort_key[0] = p_a;
+		sort_key[1] = p_b;
+		sort_key[2] = p_c;
+	}
+
 public:
+	// Orders constraints by what they connect instead of by creation order, so
+	// islands are built in the same order when pairs are recreated (e.g. after
+	// restoring a saved state).
+	struct Comparator {
+		_FORCE_INLINE_ bool operator()(const Constraint2DSW *p_a, const Constraint2DSW *p_b) const {
+			for (int i = 0; i < 3; i++) {
+				if (p_a->sort_key[i] != p_b->sort_key[i]) {
+					return p_a->sort_key[i] < p_b->sort_key[i];
+				}
+			}
+			return false;
+		}
+	};
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -62,6 +87,8 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	virtual BodyPair2DSW *get_body_pair() { return nullptr; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -0,0 +1,163 @@
+/*************************************************************************/
+/*  deterministic_math_2d_sw.h                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef DETERMINISTIC_MATH_2D_SW_H
+#define DETERMINISTIC_MATH_2D_SW_H
+
+#include "core/math/math_defs.h"
+#include "core/typedefs.h"
+
+#include <math.h>
+
+// Replacements for the C library functions used by the 2D physics server.
+// The C library functions can give different results on different platforms,
+// these only use additions, multiplications, divisions, floor() and ldexp(),
+// which are exact or correctly rounded everywhere. Only used in deterministic
+// mode, see Space2DSW::is_deterministic().
+class DeterministicMath2DSW {
+	static constexpr double PI_2_HI = 1.57079632679489655800e+00;
+	static constexpr double PI_2_LO = 6.12323399573676603587e-17;
+	static constexpr double LN2_HI = 6.93147180369123816490e-01;
+	static constexpr double LN2_LO = 1.90821492927058770002e-10;
+
+	// Both are accurate to double precision for |p_x| <= PI / 4.
+	static _FORCE_INLINE_ double _sin_kernel(double p_x) {
+		const double x2 = p_x * p_x;
+		double r = 1.0 / 1307674368000.0; // 1 / 15!
+		r = r * x2 - 1.0 / 6227020800.0;
+		r = r * x2 + 1.0 / 39916800.0;
+		r = r * x2 - 1.0 / 362880.0;
+		r = r * x2 + 1.0 / 5040.0;
+		r = r * x2 - 1.0 / 120.0;
+		r = r * x2 + 1.0 / 6.0;
+		return p_x - p_x * x2 * r;
+	}
+
+	static _FORCE_INLINE_ double _cos_kernel(double p_x) {
+		const double x2 = p_x * p_x;
+		double r = 1.0 / 87178291200.0; // 1 / 14!
+		r = r * x2 - 1.0 / 479001600.0;
+		r = r * x2 + 1.0 / 3628800.0;
+		r = r * x2 - 1.0 / 40320.0;
+		r = r * x2 + 1.0 / 720.0;
+		r = r * x2 - 1.0 / 24.0;
+		r = r * x2 + 0.5;
+		return 1.0 - x2 * r;
+	}
+
+	// Accurate to double precision for |p_x| <= tan(PI / 12).
+	static _FORCE_INLINE_ double _atan_kernel(double p_x) {
+		const double x2 = p_x * p_x;
+		double r = 0.0;
+		for (int i = 23; i >= 3; i -= 2) {
+			r = r * x2 + ((i & 2) ? -1.0 : 1.0) / i;
+		}
+		return p_x + p_x * x2 * r;
+	}
+
+	// Returns p_x reduced to [-PI / 4, PI / 4] and the quadrant it was in.
+	static _FORCE_INLINE_ double _reduce(double p_x, int &r_quadrant) {
+		const double k = floor(p_x / PI_2_HI + 0.5);
+		r_quadrant = int(int64_t(k) & 3);
+		return (p_x - k * PI_2_HI) - k * PI_2_LO;
+	}
+
+public:
+	static real_t sin(real_t p_x) {
+		int quadrant;
+		const double x = _reduce(p_x, quadrant);
+		switch (quadrant) {
+			case 0:
+				return _sin_kernel(x);
+			case 1:
+				return _cos_kernel(x);
+			case 2:
+				return -_sin_kernel(x);
+			default:
+				return -_cos_kernel(x);
+		}
+	}
+
+	static real_t cos(real_t p_x) {
+		int quadrant;
+		const double x = _reduce(p_x, quadrant);
+		switch (quadrant) {
+			case 0:
+				return _cos_kernel(x);
+			case 1:
+				return -_sin_kernel(x);
+			case 2:
+				return -_cos_kernel(x);
+			default:
+				return _sin_kernel(x);
+		}
+	}
+
+	static real_t atan2(real_t p_y, real_t p_x) {
+		const double ax = p_x < 0 ? -double(p_x) : double(p_x);
+		const double ay = p_y < 0 ? -double(p_y) : double(p_y);
+		if (ax == 0.0 && ay == 0.0) {
+			return 0.0;
+		}
+
+		// Reduce to [0, 1], then to [-tan(PI / 12), tan(PI / 12)].
+		const bool swap = ay > ax;
+		double t = swap ? ax / ay : ay / ax;
+		double offset = 0.0;
+		if (t > 0.2679491924311227) { // tan(PI / 12)
+			const double sqrt3 = 1.7320508075688772;
+			t = (t * sqrt3 - 1.0) / (sqrt3 + t);
+			offset = PI_2_HI / 3.0;
+		}
+
+		double r = offset + _atan_kernel(t);
+		if (swap) {
+			r = PI_2_HI - r;
+		}
+		if (p_x < 0) {
+			r = 2.0 * PI_2_HI - r;
+		}
+		return p_y < 0 ? -r : r;
+	}
+
+	static real_t exp(real_t p_x) {
+		const double x = CLAMP(double(p_x), -700.0, 700.0);
+		const double k = floor(x / LN2_HI + 0.5);
+		const double r = (x - k * LN2_HI) - k * LN2_LO;
+
+		double e = 1.0;
+		for (int i = 16; i >= 1; i--) {
+			e = 1.0 + e * r / i;
+		}
+		return ldexp(e, int(k));
+	}
+};
+
+#endif // DETERMINISTIC_MATH_2D_SW_H
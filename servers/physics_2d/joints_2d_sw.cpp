@@ -30,6 +30,7 @@
 
 #include "joints_2d_sw.h"
 
+#include "deterministic_math_2d_sw.h"
 #include "space_2d_sw.h"
 
 //based on chipmunk joint constraints
@@ -402,7 +403,11 @@ bool DampedSpringJoint2DSW::setup(real_t p_step) {
 	n_mass = 1.0f / k;
 
 	target_vrn = 0.0f;
-	v_coef = 1.0f - Math::exp(-damping * (p_step)*k);
+	if (A->get_space()->is_deterministic()) {
+		v_coef = 1.0f - DeterministicMath2DSW::exp(-damping * (p_step)*k);
+	} else {
+		v_coef = 1.0f - Math::exp(-damping * (p_step)*k);
+	}
 
 	// Calculate spring force.
 	real_t f_spring = (rest_length - dist) * stiffness;
@@ -62,6 +62,9 @@ public:
 	virtual PhysicsServer2D::JointType get_type() const { return PhysicsServer2D::JOINT_TYPE_MAX; }
 	Joint2DSW(Body2DSW **p_body_ptr = nullptr, int p_body_count = 0) :
 			Constraint2DSW(p_body_ptr, p_body_count) {
+		// Joints are never recreated by the space, so creation order is stable.
+		static uint64_t joint_count = 0;
+		set_sort_key(0, ++joint_count, 0);
 		bias = 0;
 		max_force = max_bias = 3.40282e+38;
 	};
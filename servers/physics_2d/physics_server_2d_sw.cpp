@@ -274,6 +274,20 @@ int PhysicsServer2DSW::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> PhysicsServer2DSW::space_save_state(RID p_space) const {
+	Space2DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+
+	return space->save_state();
+}
+
+Error PhysicsServer2DSW::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	Space2DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+
+	return space->restore_state(p_state);
+}
+
 PhysicsDirectSpaceState2D *PhysicsServer2DSW::space_get_direct_state(RID p_space) {
 	Space2DSW *space = space_owner.getornull(p_space);
 	ERR_FAIL_COND_V(!space, nullptr);
@@ -1327,6 +1327,220 @@ void Space2DSW::update() {
 	broadphase->update();
 }
 
+Vector<uint8_t> Space2DSW::save_state() {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Can't save the state of a space while it's being stepped.");
+
+	// Pairs found by the broadphase depend on how the objects moved, reset them
+	// so they are the same as after restoring the state.
+	broadphase->reset_pairs();
+
+	LocalVector<const Body2DSW *> bodies;
+	LocalVector<BodyPair2DSW *> pairs;
+	uint32_t bodies_size = 0;
+	uint32_t pairs_size = 0;
+
+	for (const Set<CollisionObject2DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject2DSW::TYPE_BODY) {
+			continue;
+		}
+
+		const Body2DSW *body = static_cast<const Body2DSW *>(E->get());
+		bodies.push_back(body);
+		bodies_size += sizeof(uint64_t) + sizeof(Body2DSW::SimulationState) + sizeof(uint32_t) + body->get_shape_count() * sizeof(Rect2);
+
+		for (const List<Pair<Constraint2DSW *, int>>::Element *C = body->get_constraint_list().front(); C; C = C->next()) {
+			BodyPair2DSW *pair = C->get().first->get_body_pair();
+			// Pairs are in the constraint list of both bodies, only save them once.
+			if (pair && pair->get_body_A() == body) {
+				pairs.push_back(pair);
+				pairs_size += sizeof(PairStateKey) + pair->get_state_size();
+			}
+		}
+	}
+
+	// Islands are generated in active list order, so it's part of the state.
+	uint32_t active_body_count = 0;
+	for (const SelfList<Body2DSW> *E = active_list.first(); E; E = E->next()) {
+		active_body_count++;
+	}
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(StateHeader) + bodies_size + active_body_count * sizeof(uint64_t) + pairs_size);
+	uint8_t *w = state.ptrw();
+
+	StateHeader header;
+	header.version = STATE_VERSION;
+	header.real_size = sizeof(real_t);
+	header.body_count = bodies.size();
+	header.active_body_count = active_body_count;
+	header.pair_count = pairs.size();
+	memcpy(w, &header, sizeof(StateHeader));
+	w += sizeof(StateHeader);
+
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		uint64_t id = bodies[i]->get_self().get_id();
+		memcpy(w, &id, sizeof(uint64_t));
+		w += sizeof(uint64_t);
+
+		Body2DSW::SimulationState body_state;
+		memset((void *)&body_state, 0, sizeof(Body2DSW::SimulationState)); // Keep the padding deterministic.
+		bodies[i]->save_simulation_state(body_state);
+		memcpy(w, &body_state, sizeof(Body2DSW::SimulationState));
+		w += sizeof(Body2DSW::SimulationState);
+
+		uint32_t shape_count = bodies[i]->get_shape_count();
+		memcpy(w, &shape_count, sizeof(uint32_t));
+		w += sizeof(uint32_t);
+		for (uint32_t j = 0; j < shape_count; j++) {
+			memcpy(w, &bodies[i]->get_shape_aabb(j), sizeof(Rect2));
+			w += sizeof(Rect2);
+		}
+	}
+
+	for (const SelfList<Body2DSW> *E = active_list.first(); E; E = E->next()) {
+		uint64_t id = E->self()->get_self().get_id();
+		memcpy(w, &id, sizeof(uint64_t));
+		w += sizeof(uint64_t);
+	}
+
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		const BodyPair2DSW *pair = pairs[i];
+
+		PairStateKey key;
+		memset(&key, 0, sizeof(PairStateKey));
+		key.body_A = pair->get_body_A()->get_self().get_id();
+		key.body_B = pair->get_body_B()->get_self().get_id();
+		key.shape_A = pair->get_shape_A();
+		key.shape_B = pair->get_shape_B();
+		key.size = pair->get_state_size();
+		memcpy(w, &key, sizeof(PairStateKey));
+		w += sizeof(PairStateKey);
+
+		pair->save_state(w);
+		w += key.size;
+	}
+
+	return state;
+}
+
+Error Space2DSW::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Can't restore the state of a space while it's being stepped.");
+
+	const uint8_t *r = p_state.ptr();
+	uint32_t remaining = p_state.size();
+
+	ERR_FAIL_COND_V(remaining < sizeof(StateHeader), ERR_INVALID_DATA);
+	StateHeader header;
+	memcpy(&header, r, sizeof(StateHeader));
+	r += sizeof(StateHeader);
+	remaining -= sizeof(StateHeader);
+
+	ERR_FAIL_COND_V_MSG(header.version != STATE_VERSION || header.real_size != sizeof(real_t), ERR_INVALID_DATA, "Space state was saved by an incompatible version.");
+
+	HashMap<uint64_t, Body2DSW *> bodies;
+	for (Set<CollisionObject2DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() == CollisionObject2DSW::TYPE_BODY) {
+			bodies.set(E->get()->get_self().get_id(), static_cast<Body2DSW *>(E->get()));
+		}
+	}
+
+	const uint32_t body_state_size = sizeof(uint64_t) + sizeof(Body2DSW::SimulationState) + sizeof(uint32_t);
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		ERR_FAIL_COND_V(remaining < body_state_size, ERR_INVALID_DATA);
+		uint64_t id;
+		memcpy(&id, r, sizeof(uint64_t));
+		uint32_t shape_count;
+		memcpy(&shape_count, r + sizeof(uint64_t) + sizeof(Body2DSW::SimulationState), sizeof(uint32_t));
+		ERR_FAIL_COND_V(uint64_t(remaining) < body_state_size + uint64_t(shape_count) * sizeof(Rect2), ERR_INVALID_DATA);
+
+		// Bodies removed since the state was saved are skipped.
+		Body2DSW **body = bodies.getptr(id);
+		if (body) {
+			Body2DSW::SimulationState body_state;
+			memcpy(&body_state, r + sizeof(uint64_t), sizeof(Body2DSW::SimulationState));
+			(*body)->restore_simulation_state(body_state);
+
+			// Bodies with a different number of shapes keep the AABBs computed from the transform.
+			if (int(shape_count) == (*body)->get_shape_count()) {
+				for (uint32_t j = 0; j < shape_count; j++) {
+					Rect2 aabb;
+					memcpy(&aabb, r + body_state_size + j * sizeof(Rect2), sizeof(Rect2));
+					(*body)->restore_shape_aabb(j, aabb);
+				}
+			}
+		}
+
+		r += body_state_size + shape_count * sizeof(Rect2);
+		remaining -= body_state_size + shape_count * sizeof(Rect2);
+	}
+
+	ERR_FAIL_COND_V(uint64_t(remaining) < uint64_t(header.active_body_count) * sizeof(uint64_t), ERR_INVALID_DATA);
+
+	// Activating bodies adds them at the head of the active list, move them back
+	// to the saved order. Bodies added since the state was saved stay in front.
+	HashMap<uint64_t, SelfList<Body2DSW> *> active_bodies;
+	for (SelfList<Body2DSW> *E = active_list.first(); E; E = E->next()) {
+		active_bodies.set(E->self()->get_self().get_id(), E);
+	}
+	for (uint32_t i = 0; i < header.active_body_count; i++) {
+		uint64_t id;
+		memcpy(&id, r, sizeof(uint64_t));
+		r += sizeof(uint64_t);
+		remaining -= sizeof(uint64_t);
+
+		SelfList<Body2DSW> **E = active_bodies.getptr(id);
+		if (E) {
+			active_list.remove(*E);
+			active_list.add_last(*E);
+		}
+	}
+
+	// Pairs are created by the broadphase, find them now, the same way as when
+	// saving, so all the pairs exist before restoring their contacts.
+	broadphase->reset_pairs();
+
+	// Contacts of pairs that weren't saved must not be used for warm starting.
+	for (Set<CollisionObject2DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject2DSW::TYPE_BODY) {
+			continue;
+		}
+
+		const Body2DSW *body = static_cast<const Body2DSW *>(E->get());
+		for (const List<Pair<Constraint2DSW *, int>>::Element *C = body->get_constraint_list().front(); C; C = C->next()) {
+			BodyPair2DSW *pair = C->get().first->get_body_pair();
+			if (pair && pair->get_body_A() == body) {
+				pair->clear_state();
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		ERR_FAIL_COND_V(remaining < sizeof(PairStateKey), ERR_INVALID_DATA);
+		PairStateKey key;
+		memcpy(&key, r, sizeof(PairStateKey));
+		r += sizeof(PairStateKey);
+		remaining -= sizeof(PairStateKey);
+		ERR_FAIL_COND_V(remaining < key.size, ERR_INVALID_DATA);
+
+		Body2DSW **body_A = bodies.getptr(key.body_A);
+		Body2DSW **body_B = bodies.getptr(key.body_B);
+		if (body_A && body_B) {
+			for (const List<Pair<Constraint2DSW *, int>>::Element *C = (*body_A)->get_constraint_list().front(); C; C = C->next()) {
+				BodyPair2DSW *pair = C->get().first->get_body_pair();
+				if (pair && pair->get_body_A() == *body_A && pair->get_body_B() == *body_B && pair->get_shape_A() == key.shape_A && pair->get_shape_B() == key.shape_B) {
+					ERR_FAIL_COND_V(pair->restore_state(r, key.size) != key.size, ERR_INVALID_DATA);
+					break;
+				}
+			}
+		}
+
+		r += key.size;
+		remaining -= key.size;
+	}
+
+	return OK;
+}
+
 void Space2DSW::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -1412,6 +1626,7 @@ Space2DSW::Space2DSW() {
 	body_angular_velocity_sleep_threshold = GLOBAL_DEF("physics/2d/sleep_threshold_angular", Math::deg2rad(8.0));
 	body_time_to_sleep = GLOBAL_DEF("physics/2d/time_before_sleep", 0.5);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/time_before_sleep", PropertyInfo(Variant::FLOAT, "physics/2d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"));
+	deterministic = GLOBAL_DEF("physics/2d/deterministic", false);
 
 	broadphase = BroadPhase2DSW::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -115,6 +115,7 @@ private:
 	real_t body_angular_velocity_sleep_threshold;
 	real_t body_time_to_sleep;
 
+	bool deterministic = false;
 	bool locked;
 
 	int island_count;
@@ -123,6 +124,26 @@ private:
 
 	int _cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb);
 
+	enum {
+		STATE_VERSION = 2
+	};
+
+	struct StateHeader {
+		uint32_t version;
+		uint32_t real_size;
+		uint32_t body_count;
+		uint32_t active_body_count;
+		uint32_t pair_count;
+	};
+
+	struct PairStateKey {
+		uint64_t body_A;
+		uint64_t body_B;
+		int32_t shape_A;
+		int32_t shape_B;
+		uint32_t size;
+	};
+
 	Vector<Vector2> contact_debug;
 	int contact_debug_count;
 
@@ -165,6 +186,9 @@ public:
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 
 	void update();
+
+	Vector<uint8_t> save_state();
+	Error restore_state(const Vector<uint8_t> &p_state);
 	void setup();
 	void call_queries();
 
@@ -172,6 +196,10 @@ public:
 	void lock();
 	void unlock();
 
+	// Gives bit identical results on all platforms and with any number of threads, at some performance cost.
+	_FORCE_INLINE_ void set_deterministic(bool p_deterministic) { deterministic = p_deterministic; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
+
 	void set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::SpaceParameter p_param) const;
 
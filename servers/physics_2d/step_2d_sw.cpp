@@ -234,7 +234,14 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_contraint_count = all_constraints.size();
-	work_pool.do_work(total_contraint_count, this, &Step2DSW::_setup_contraint, nullptr);
+	if (p_space->is_deterministic()) {
+		// Area pairs modify the bodies they overlap during setup, and the order matters.
+		for (uint32_t constraint_index = 0; constraint_index < total_contraint_count; ++constraint_index) {
+			_setup_contraint(constraint_index);
+		}
+	} else {
+		work_pool.do_work(total_contraint_count, this, &Step2DSW::_setup_contraint, nullptr);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -293,14 +300,14 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 	_step++;
 }
 
-Step2DSW::Step2DSW() {
+Step2DSW::Step2DSW(int p_thread_count) {
 	_step = 1;
 
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 
-	work_pool.init();
+	work_pool.init(p_thread_count);
 }
 
 Step2DSW::~Step2DSW() {
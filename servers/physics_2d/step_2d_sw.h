@@ -56,7 +56,7 @@ class Step2DSW {
 
 public:
 	void step(Space2DSW *p_space, real_t p_delta, int p_iterations);
-	Step2DSW();
+	Step2DSW(int p_thread_count = -1);
 	~Step2DSW();
 };
 
@@ -157,6 +157,10 @@ void Body3DSW::set_active(bool p_active) {
 			active = false;
 		} else if (get_space()) {
 			get_space()->body_add_to_active_list(&active_list);
+			if (sleeping_island != -1) {
+				// Everything that fell asleep with this body wakes up with it.
+				get_space()->wake_sleeping_island(sleeping_island);
+			}
 		}
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
@@ -354,6 +358,36 @@ Variant Body3DSW::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void Body3DSW::save_simulation_state(SimulationState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.biased_linear_velocity = biased_linear_velocity;
+	r_state.biased_angular_velocity = biased_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void Body3DSW::restore_simulation_state(const SimulationState &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	biased_linear_velocity = p_state.biased_linear_velocity;
+	biased_angular_velocity = p_state.biased_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+
+	_update_transform_dependant();
+}
+
 void Body3DSW::set_space(Space3DSW *p_space) {
 	if (get_space()) {
 		if (inertia_update_list.in_list()) {
@@ -365,6 +399,9 @@ void Body3DSW::set_space(Space3DSW *p_space) {
 		if (direct_state_query_list.in_list()) {
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
 		}
+		if (sleeping_island != -1) {
+			get_space()->body_remove_from_sleeping_island(this);
+		}
 	}
 
 	_set_space(p_space);
@@ -640,7 +677,7 @@ void BodySW::simulate_motion(const Transform3D& p_xform,real_t p_step) {
 */
 
 void Body3DSW::wakeup_neighbours() {
-	for (Map<Constraint3DSW *, int>::Element *E = constraint_map.front(); E; E = E->next()) {
+	for (Map<Constraint3DSW *, int, Constraint3DSW::Comparator>::Element *E = constraint_map.front(); E; E = E->next()) {
 		const Constraint3DSW *c = E->key();
 		Body3DSW **n = c->get_body_ptr();
 		int bc = c->get_body_count();
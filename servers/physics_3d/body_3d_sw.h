@@ -33,6 +33,7 @@
 
 #include "area_3d_sw.h"
 #include "collision_object_3d_sw.h"
+#include "constraint_3d_sw.h"
 #include "core/templates/vset.h"
 
 class Constraint3DSW;
@@ -87,6 +88,10 @@ class Body3DSW : public CollisionObject3DSW {
 
 	bool first_integration;
 
+	// Island the body fell asleep with, woken up as a whole.
+	int sleeping_island = -1;
+	int sleeping_island_index = 0;
+
 	bool continuous_cd;
 	bool can_sleep;
 	bool first_time_kinematic;
@@ -94,7 +99,7 @@ class Body3DSW : public CollisionObject3DSW {
 	virtual void _shapes_changed();
 	Transform3D new_transform;
 
-	Map<Constraint3DSW *, int> constraint_map;
+	Map<Constraint3DSW *, int, Constraint3DSW::Comparator> constraint_map;
 
 	struct AreaCMP {
 		Area3DSW *area;
@@ -184,7 +189,7 @@ public:
 
 	_FORCE_INLINE_ void add_constraint(Constraint3DSW *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(Constraint3DSW *p_constraint) { constraint_map.erase(p_constraint); }
-	const Map<Constraint3DSW *, int> &get_constraint_map() const { return constraint_map; }
+	const Map<Constraint3DSW *, int, Constraint3DSW::Comparator> &get_constraint_map() const { return constraint_map; }
 	_FORCE_INLINE_ void clear_constraint_map() { constraint_map.clear(); }
 
 	_FORCE_INLINE_ void set_omit_force_integration(bool p_omit_force_integration) { omit_force_integration = p_omit_force_integration; }
@@ -247,6 +252,13 @@ public:
 	void set_active(bool p_active);
 	_FORCE_INLINE_ bool is_active() const { return active; }
 
+	_FORCE_INLINE_ void set_sleeping_island(int p_island, int p_index) {
+		sleeping_island = p_island;
+		sleeping_island_index = p_index;
+	}
+	_FORCE_INLINE_ int get_sleeping_island() const { return sleeping_island; }
+	_FORCE_INLINE_ int get_sleeping_island_index() const { return sleeping_island_index; }
+
 	_FORCE_INLINE_ void wakeup() {
 		if ((!get_space()) || mode == PhysicsServer3D::BODY_MODE_STATIC || mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 			return;
@@ -263,6 +275,24 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
+	// Everything that changes while simulating, see Space3DSW::save_state().
+	struct SimulationState {
+		Transform3D transform;
+		Transform3D inv_transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 biased_linear_velocity;
+		Vector3 biased_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_simulation_state(SimulationState &r_state) const;
+	void restore_simulation_state(const SimulationState &p_state);
+
 	void set_applied_force(const Vector3 &p_force) { applied_force = p_force; }
 	Vector3 get_applied_force() const { return applied_force; }
 
@@ -212,8 +212,16 @@ real_t combine_friction(Body3DSW *A, Body3DSW *B) {
 }
 
 bool BodyPair3DSW::setup(real_t p_step) {
-	dynamic_A = (A->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC);
-	dynamic_B = (B->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC);
+	// Sleeping bodies are not part of the island being solved, so they are treated as static.
+	// Several islands can touch the same sleeping body, and they are solved in parallel.
+	// The body is woken up after the step if the contact is still there.
+	dynamic_A = (A->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) && !is_body_static_in_island(0);
+	dynamic_B = (B->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) && !is_body_static_in_island(1);
+
+	inv_mass_A = dynamic_A ? A->get_inv_mass() : 0.0;
+	inv_mass_B = dynamic_B ? B->get_inv_mass() : 0.0;
+	inv_inertia_tensor_A = dynamic_A ? A->get_inv_inertia_tensor() : Basis(Vector3(), Vector3(), Vector3());
+	inv_inertia_tensor_B = dynamic_B ? B->get_inv_inertia_tensor() : Basis(Vector3(), Vector3(), Vector3());
 
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
@@ -339,9 +347,9 @@ bool BodyPair3DSW::pre_solve(real_t p_step) {
 		do_process = true;
 
 		// Precompute normal mass, tangent mass, and bias.
-		Vector3 inertia_A = A->get_inv_inertia_tensor().xform(c.rA.cross(c.normal));
-		Vector3 inertia_B = B->get_inv_inertia_tensor().xform(c.rB.cross(c.normal));
-		real_t kNormal = A->get_inv_mass() + B->get_inv_mass();
+		Vector3 inertia_A = inv_inertia_tensor_A.xform(c.rA.cross(c.normal));
+		Vector3 inertia_B = inv_inertia_tensor_B.xform(c.rB.cross(c.normal));
+		real_t kNormal = inv_mass_A + inv_mass_B;
 		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
 		c.mass_normal = 1.0f / kNormal;
 
@@ -415,7 +423,7 @@ void BodyPair3DSW::solve(real_t p_step) {
 			vbn = dbv.dot(c.normal);
 
 			if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
-				real_t jbn_com = (-vbn + c.bias) / (A->get_inv_mass() + B->get_inv_mass());
+				real_t jbn_com = (-vbn + c.bias) / (inv_mass_A + inv_mass_B);
 				real_t jbnOld_com = c.acc_bias_impulse_center_of_mass;
 				c.acc_bias_impulse_center_of_mass = MAX(jbnOld_com + jbn_com, 0.0f);
 
@@ -473,11 +481,11 @@ void BodyPair3DSW::solve(real_t p_step) {
 		if (tvl > MIN_VELOCITY) {
 			tv /= tvl;
 
-			Vector3 temp1 = A->get_inv_inertia_tensor().xform(c.rA.cross(tv));
-			Vector3 temp2 = B->get_inv_inertia_tensor().xform(c.rB.cross(tv));
+			Vector3 temp1 = inv_inertia_tensor_A.xform(c.rA.cross(tv));
+			Vector3 temp2 = inv_inertia_tensor_B.xform(c.rB.cross(tv));
 
 			real_t t = -tvl /
-					   (A->get_inv_mass() + B->get_inv_mass() + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
+					   (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
 
 			Vector3 jt = t * tv;
 
@@ -505,6 +513,46 @@ void BodyPair3DSW::solve(real_t p_step) {
 	}
 }
 
+uint32_t BodyPair3DSW::get_state_size() const {
+	return sizeof(StateHeader) + contact_count * sizeof(Contact);
+}
+
+void BodyPair3DSW::save_state(uint8_t *r_data) const {
+	StateHeader header;
+	memset((void *)&header, 0, sizeof(StateHeader)); // Keep the padding deterministic.
+	header.offset_B = offset_B;
+	header.sep_axis = sep_axis;
+	header.contact_count = contact_count;
+	header.collided = collided;
+
+	memcpy(r_data, &header, sizeof(StateHeader));
+	memcpy(r_data + sizeof(StateHeader), contacts, contact_count * sizeof(Contact));
+}
+
+uint32_t BodyPair3DSW::restore_state(const uint8_t *p_data, uint32_t p_size) {
+	ERR_FAIL_COND_V(p_size < sizeof(StateHeader), 0);
+
+	StateHeader header;
+	memcpy(&header, p_data, sizeof(StateHeader));
+	ERR_FAIL_COND_V(header.contact_count < 0 || header.contact_count > MAX_CONTACTS, 0);
+
+	uint32_t size = sizeof(StateHeader) + header.contact_count * sizeof(Contact);
+	ERR_FAIL_COND_V(p_size < size, 0);
+
+	offset_B = header.offset_B;
+	sep_axis = header.sep_axis;
+	contact_count = header.contact_count;
+	collided = header.collided;
+	memcpy(contacts, p_data + sizeof(StateHeader), contact_count * sizeof(Contact));
+
+	return size;
+}
+
+void BodyPair3DSW::clear_state() {
+	contact_count = 0;
+	collided = false;
+}
+
 BodyPair3DSW::BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_shape_B) :
 		BodyContact3DSW(_arr, 2) {
 	A = p_A;
@@ -512,6 +560,7 @@ BodyPair3DSW::BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_sh
 	shape_A = p_shape_A;
 	shape_B = p_shape_B;
 	space = A->get_space();
+	set_sort_key(A->get_self().get_id(), B->get_self().get_id(), (uint64_t(shape_A) << 32) | uint32_t(shape_B));
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
 }
@@ -595,7 +644,10 @@ void BodySoftBodyPair3DSW::validate_contacts() {
 }
 
 bool BodySoftBodyPair3DSW::setup(real_t p_step) {
-	body_dynamic = (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC);
+	// Sleeping bodies are treated as static, see BodyPair3DSW::setup().
+	body_dynamic = (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) && !is_body_static_in_island(0);
+	body_inv_mass = body_dynamic ? body->get_inv_mass() : 0.0;
+	body_inv_inertia_tensor = body_dynamic ? body->get_inv_inertia_tensor() : Basis(Vector3(), Vector3(), Vector3());
 
 	if (!body->test_collision_mask(soft_body) || body->has_exception(soft_body->get_self()) || soft_body->has_exception(body->get_self())) {
 		collided = false;
@@ -682,8 +734,8 @@ bool BodySoftBodyPair3DSW::pre_solve(real_t p_step) {
 		}
 
 		// Precompute normal mass, tangent mass, and bias.
-		Vector3 inertia_A = body->get_inv_inertia_tensor().xform(c.rA.cross(c.normal));
-		real_t kNormal = body->get_inv_mass() + node_inv_mass;
+		Vector3 inertia_A = body_inv_inertia_tensor.xform(c.rA.cross(c.normal));
+		real_t kNormal = body_inv_mass + node_inv_mass;
 		kNormal += c.normal.dot(inertia_A.cross(c.rA));
 		c.mass_normal = 1.0f / kNormal;
 
@@ -752,7 +804,7 @@ void BodySoftBodyPair3DSW::solve(real_t p_step) {
 			vbn = dbv.dot(c.normal);
 
 			if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
-				real_t jbn_com = (-vbn + c.bias) / (body->get_inv_mass() + soft_body->get_node_inv_mass(c.index_B));
+				real_t jbn_com = (-vbn + c.bias) / (body_inv_mass + soft_body->get_node_inv_mass(c.index_B));
 				real_t jbnOld_com = c.acc_bias_impulse_center_of_mass;
 				c.acc_bias_impulse_center_of_mass = MAX(jbnOld_com + jbn_com, 0.0f);
 
@@ -804,10 +856,10 @@ void BodySoftBodyPair3DSW::solve(real_t p_step) {
 		if (tvl > MIN_VELOCITY) {
 			tv /= tvl;
 
-			Vector3 temp1 = body->get_inv_inertia_tensor().xform(c.rA.cross(tv));
+			Vector3 temp1 = body_inv_inertia_tensor.xform(c.rA.cross(tv));
 
 			real_t t = -tvl /
-					   (body->get_inv_mass() + soft_body->get_node_inv_mass(c.index_B) + tv.dot(temp1.cross(c.rA)));
+					   (body_inv_mass + soft_body->get_node_inv_mass(c.index_B) + tv.dot(temp1.cross(c.rA)));
 
 			Vector3 jt = t * tv;
 
@@ -839,6 +891,7 @@ BodySoftBodyPair3DSW::BodySoftBodyPair3DSW(Body3DSW *p_A, int p_shape_A, SoftBod
 	soft_body = p_B;
 	body_shape = p_shape_A;
 	space = p_A->get_space();
+	set_sort_key(body->get_self().get_id(), soft_body->get_self().get_id(), uint64_t(body_shape) << 32);
 	body->add_constraint(this, 0);
 	soft_body->add_constraint(this);
 }
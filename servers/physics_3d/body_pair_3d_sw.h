@@ -86,6 +86,12 @@ class BodyPair3DSW : public BodyContact3DSW {
 	bool dynamic_A = false;
 	bool dynamic_B = false;
 
+	// Mass properties as seen by the solver, zero for bodies that are not dynamic in this step.
+	real_t inv_mass_A = 0.0;
+	real_t inv_mass_B = 0.0;
+	Basis inv_inertia_tensor_A;
+	Basis inv_inertia_tensor_B;
+
 	bool report_contacts_only = false;
 
 	Vector3 offset_B; //use local A coordinates to avoid numerical issues on collision detection
@@ -93,6 +99,13 @@ class BodyPair3DSW : public BodyContact3DSW {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	struct StateHeader {
+		Vector3 offset_B;
+		Vector3 sep_axis;
+		int32_t contact_count;
+		bool collided;
+	};
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B);
@@ -105,6 +118,19 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual BodyPair3DSW *get_body_pair() override { return this; }
+
+	_FORCE_INLINE_ Body3DSW *get_body_A() const { return A; }
+	_FORCE_INLINE_ Body3DSW *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
+	// Contacts and accumulated impulses used for warm starting, see Space3DSW::save_state().
+	uint32_t get_state_size() const;
+	void save_state(uint8_t *r_data) const;
+	uint32_t restore_state(const uint8_t *p_data, uint32_t p_size);
+	void clear_state();
+
 	BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_shape_B);
 	~BodyPair3DSW();
 };
@@ -116,6 +142,8 @@ class BodySoftBodyPair3DSW : public BodyContact3DSW {
 	int body_shape = 0;
 
 	bool body_dynamic = false;
+	real_t body_inv_mass = 0.0;
+	Basis body_inv_inertia_tensor;
 
 	LocalVector<Contact> contacts;
 
@@ -31,21 +31,36 @@
 #include "broad_phase_3d_bvh.h"
 #include "collision_object_3d_sw.h"
 
+void BroadPhase3DBVH::_flush_moves() {
+	if (pending_move_ids.is_empty()) {
+		return;
+	}
+
+	bvh.move_bulk(pending_move_ids.ptr(), pending_move_aabbs.ptr(), pending_move_ids.size());
+
+	pending_move_ids.clear();
+	pending_move_aabbs.clear();
+}
+
 BroadPhase3DBVH::ID BroadPhase3DBVH::create(CollisionObject3DSW *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
+	_flush_moves();
 	ID oid = bvh.create(p_object, true, p_aabb, p_subindex, !p_static, 1 << p_object->get_type(), p_static ? 0 : 0xFFFFF); // Pair everything, don't care?
 	return oid + 1;
 }
 
 void BroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
-	bvh.move(p_id - 1, p_aabb);
+	pending_move_ids.push_back(p_id - 1);
+	pending_move_aabbs.push_back(p_aabb);
 }
 
 void BroadPhase3DBVH::set_static(ID p_id, bool p_static) {
+	_flush_moves();
 	CollisionObject3DSW *it = bvh.get(p_id - 1);
 	bvh.set_pairable(p_id - 1, !p_static, 1 << it->get_type(), p_static ? 0 : 0xFFFFF, false); // Pair everything, don't care?
 }
 
 void BroadPhase3DBVH::remove(ID p_id) {
+	_flush_moves();
 	bvh.erase(p_id - 1);
 }
 
@@ -64,14 +79,17 @@ int BroadPhase3DBVH::get_subindex(ID p_id) const {
 }
 
 int BroadPhase3DBVH::cull_point(const Vector3 &p_point, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices) {
+	_flush_moves();
 	return bvh.cull_point(p_point, p_results, p_max_results, p_result_indices);
 }
 
 int BroadPhase3DBVH::cull_segment(const Vector3 &p_from, const Vector3 &p_to, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices) {
+	_flush_moves();
 	return bvh.cull_segment(p_from, p_to, p_results, p_max_results, p_result_indices);
 }
 
 int BroadPhase3DBVH::cull_aabb(const AABB &p_aabb, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices) {
+	_flush_moves();
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, p_result_indices);
 }
 
@@ -103,8 +121,14 @@ void BroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback, void
 	unpair_userdata = p_userdata;
 }
 
-void BroadPhase3DBVH::update() {
-	bvh.update();
+void BroadPhase3DBVH::update(ThreadWorkPool &p_work_pool) {
+	_flush_moves();
+	bvh.update(&p_work_pool);
+}
+
+void BroadPhase3DBVH::reset_pairs(ThreadWorkPool &p_work_pool) {
+	_flush_moves();
+	bvh.force_collision_check_all(&p_work_pool);
 }
 
 BroadPhase3DSW *BroadPhase3DBVH::_create() {
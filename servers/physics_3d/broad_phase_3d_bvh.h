@@ -37,6 +37,13 @@
 class BroadPhase3DBVH : public BroadPhase3DSW {
 	BVH_Manager<CollisionObject3DSW, true, 128> bvh;
 
+	// Moves are queued and applied to the tree in bulk, so it is only refit once
+	// per step instead of once per moved object.
+	LocalVector<uint32_t> pending_move_ids;
+	LocalVector<AABB> pending_move_aabbs;
+
+	void _flush_moves();
+
 	static void *_pair_callback(void *, uint32_t, CollisionObject3DSW *, int, uint32_t, CollisionObject3DSW *, int);
 	static void _unpair_callback(void *, uint32_t, CollisionObject3DSW *, int, uint32_t, CollisionObject3DSW *, int, void *);
 
@@ -63,7 +70,8 @@ public:
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata);
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata);
 
-	virtual void update();
+	virtual void update(ThreadWorkPool &p_work_pool);
+	virtual void reset_pairs(ThreadWorkPool &p_work_pool);
 
 	static BroadPhase3DSW *_create();
 	BroadPhase3DBVH();
@@ -0,0 +1,391 @@
+/*************************************************************************/
+/*  broad_phase_3d_sap.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "broad_phase_3d_sap.h"
+#include "collision_object_3d_sw.h"
+
+#include "core/templates/sort_array.h"
+
+// Amount of sorted elements swept by a single work item.
+#define SAP_SWEEP_CHUNK_SIZE 1024
+
+BroadPhase3DSAP::ID BroadPhase3DSAP::create(CollisionObject3DSW *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
+	uint32_t index;
+	if (free_elements.size()) {
+		index = free_elements[free_elements.size() - 1];
+		free_elements.resize(free_elements.size() - 1);
+	} else {
+		index = elements.size();
+		elements.push_back(Element());
+	}
+
+	Element &e = elements[index];
+	e.owner = p_object;
+	e.subindex = p_subindex;
+	e.aabb = p_aabb;
+	e._static = p_static;
+	e.pair_count = 0;
+
+	added_elements.push_back(index);
+	sweep_dirty = true;
+
+	return index + 1;
+}
+
+void BroadPhase3DSAP::move(ID p_id, const AABB &p_aabb) {
+	ERR_FAIL_COND(p_id == 0 || p_id > elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_COND(!e.owner);
+
+	e.aabb = p_aabb;
+	sweep_dirty = true;
+}
+
+void BroadPhase3DSAP::set_static(ID p_id, bool p_static) {
+	ERR_FAIL_COND(p_id == 0 || p_id > elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_COND(!e.owner);
+
+	// Pairs that are no longer valid are removed on the next update.
+	e._static = p_static;
+	sweep_dirty = true;
+}
+
+void BroadPhase3DSAP::remove(ID p_id) {
+	ERR_FAIL_COND(p_id == 0 || p_id > elements.size());
+	const uint32_t index = p_id - 1;
+	Element &e = elements[index];
+	ERR_FAIL_COND(!e.owner);
+
+	// Pairs must be removed right away, the owner might be about to be freed.
+	for (int i = pairs.size() - 1; i >= 0 && e.pair_count > 0; i--) {
+		const Pair &pair = pairs[i];
+		if (pair.a == index || pair.b == index) {
+			_remove_pair(i);
+		}
+	}
+
+	e.owner = nullptr;
+	removed_elements.push_back(index);
+	sweep_dirty = true;
+}
+
+CollisionObject3DSW *BroadPhase3DSAP::get_object(ID p_id) const {
+	ERR_FAIL_COND_V(p_id == 0 || p_id > elements.size(), nullptr);
+	const Element &e = elements[p_id - 1];
+	ERR_FAIL_COND_V(!e.owner, nullptr);
+	return e.owner;
+}
+
+bool BroadPhase3DSAP::is_static(ID p_id) const {
+	ERR_FAIL_COND_V(p_id == 0 || p_id > elements.size(), false);
+	return elements[p_id - 1]._static;
+}
+
+int BroadPhase3DSAP::get_subindex(ID p_id) const {
+	ERR_FAIL_COND_V(p_id == 0 || p_id > elements.size(), 0);
+	return elements[p_id - 1].subindex;
+}
+
+void BroadPhase3DSAP::_update_sweep() {
+	if (!sweep_dirty) {
+		return;
+	}
+	sweep_dirty = false;
+
+	// Drop removed elements, keeping the others sorted.
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < order.size(); i++) {
+		if (elements[order[i]].owner) {
+			order[count++] = order[i];
+		}
+	}
+	order.resize(count);
+
+	for (uint32_t i = 0; i < removed_elements.size(); i++) {
+		free_elements.push_back(removed_elements[i]);
+	}
+	removed_elements.clear();
+
+	uint32_t added_count = 0;
+	for (uint32_t i = 0; i < added_elements.size(); i++) {
+		if (elements[added_elements[i]].owner) {
+			order.push_back(added_elements[i]);
+			added_count++;
+		}
+	}
+	added_elements.clear();
+
+	if (added_count > order.size() / 4) {
+		SortArray<uint32_t, SortByStart> sorter;
+		sorter.compare.elements = elements.ptr();
+		sorter.sort(order.ptr(), order.size());
+	} else {
+		// Objects move little between updates, so the list is nearly sorted and
+		// insertion sort runs in close to linear time.
+		for (uint32_t i = 1; i < order.size(); i++) {
+			const uint32_t index = order[i];
+			const real_t start = elements[index].aabb.position.x;
+			uint32_t j = i;
+			while (j > 0 && elements[order[j - 1]].aabb.position.x > start) {
+				order[j] = order[j - 1];
+				j--;
+			}
+			order[j] = index;
+		}
+	}
+
+	sweep.resize(order.size());
+	max_width = 0.0;
+	for (uint32_t i = 0; i < order.size(); i++) {
+		const Element &e = elements[order[i]];
+		SweepEntry &entry = sweep[i];
+		entry.min = e.aabb.position;
+		entry.max = e.aabb.position + e.aabb.size;
+		entry.owner = e.owner;
+		entry.element = order[i];
+		entry._static = e._static;
+		max_width = MAX(max_width, e.aabb.size.x);
+	}
+}
+
+uint32_t BroadPhase3DSAP::_find_first_candidate(real_t p_min_x) const {
+	// No element starting before this can reach p_min_x.
+	const real_t start = p_min_x - max_width;
+
+	uint32_t low = 0;
+	uint32_t high = sweep.size();
+	while (low < high) {
+		uint32_t middle = (low + high) / 2;
+		if (sweep[middle].min.x < start) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+int BroadPhase3DSAP::cull_point(const Vector3 &p_point, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices) {
+	return cull_aabb(AABB(p_point, Vector3()), p_results, p_max_results, p_result_indices);
+}
+
+int BroadPhase3DSAP::cull_segment(const Vector3 &p_from, const Vector3 &p_to, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices) {
+	_update_sweep();
+
+	AABB bounds(p_from, Vector3());
+	bounds.expand_to(p_to);
+	const Vector3 bounds_max = bounds.position + bounds.size;
+
+	int count = 0;
+	for (uint32_t i = _find_first_candidate(bounds.position.x); i < sweep.size() && count < p_max_results; i++) {
+		const SweepEntry &entry = sweep[i];
+		if (entry.min.x > bounds_max.x) {
+			break;
+		}
+
+		const Element &e = elements[entry.element];
+		if (!e.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		p_results[count] = e.owner;
+		if (p_result_indices) {
+			p_result_indices[count] = e.subindex;
+		}
+		count++;
+	}
+
+	return count;
+}
+
+int BroadPhase3DSAP::cull_aabb(const AABB &p_aabb, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices) {
+	_update_sweep();
+
+	const Vector3 aabb_min = p_aabb.position;
+	const Vector3 aabb_max = p_aabb.position + p_aabb.size;
+
+	int count = 0;
+	for (uint32_t i = _find_first_candidate(aabb_min.x); i < sweep.size() && count < p_max_results; i++) {
+		const SweepEntry &entry = sweep[i];
+		if (entry.min.x > aabb_max.x) {
+			break;
+		}
+
+		if (entry.max.x < aabb_min.x || entry.min.y > aabb_max.y || entry.max.y < aabb_min.y || entry.min.z > aabb_max.z || entry.max.z < aabb_min.z) {
+			continue;
+		}
+
+		p_results[count] = entry.owner;
+		if (p_result_indices) {
+			p_result_indices[count] = elements[entry.element].subindex;
+		}
+		count++;
+	}
+
+	return count;
+}
+
+void BroadPhase3DSAP::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
+	pair_callback = p_pair_callback;
+	pair_userdata = p_userdata;
+}
+
+void BroadPhase3DSAP::set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) {
+	unpair_callback = p_unpair_callback;
+	unpair_userdata = p_userdata;
+}
+
+void BroadPhase3DSAP::_sweep_chunk(uint32_t p_chunk, void *p_userdata) {
+	LocalVector<uint64_t> &result = chunk_pairs[p_chunk];
+	result.clear();
+
+	const uint32_t from = p_chunk * SAP_SWEEP_CHUNK_SIZE;
+	const uint32_t to = MIN(from + SAP_SWEEP_CHUNK_SIZE, sweep.size());
+	const uint32_t sweep_size = sweep.size();
+	const SweepEntry *entries = sweep.ptr();
+
+	for (uint32_t i = from; i < to; i++) {
+		const SweepEntry &a = entries[i];
+
+		for (uint32_t j = i + 1; j < sweep_size; j++) {
+			const SweepEntry &b = entries[j];
+			if (b.min.x > a.max.x) {
+				break; // Sorted by start, no other element can overlap.
+			}
+
+			if (a._static && b._static) {
+				continue;
+			}
+
+			if (a.owner == b.owner) {
+				continue;
+			}
+
+			if (b.max.y < a.min.y || b.min.y > a.max.y || b.max.z < a.min.z || b.min.z > a.max.z) {
+				continue;
+			}
+
+			result.push_back(_get_pair_key(a.element, b.element));
+		}
+	}
+}
+
+void BroadPhase3DSAP::_remove_pair(uint32_t p_pair_index) {
+	const Pair pair = pairs[p_pair_index];
+
+	pair_map.erase(_get_pair_key(pair.a, pair.b));
+
+	// Swap with the last pair to keep the list compact.
+	const uint32_t last = pairs.size() - 1;
+	if (p_pair_index != last) {
+		pairs[p_pair_index] = pairs[last];
+		pair_map[_get_pair_key(pairs[p_pair_index].a, pairs[p_pair_index].b)] = p_pair_index;
+	}
+	pairs.resize(last);
+
+	Element &element_a = elements[pair.a];
+	Element &element_b = elements[pair.b];
+	element_a.pair_count--;
+	element_b.pair_count--;
+
+	if (unpair_callback) {
+		unpair_callback(element_a.owner, element_a.subindex, element_b.owner, element_b.subindex, pair.data, unpair_userdata);
+	}
+}
+
+void BroadPhase3DSAP::update(ThreadWorkPool &p_work_pool) {
+	_update_sweep();
+
+	pass++;
+
+	// Find overlaps. The sweep only reads data, so it can be split across threads.
+	const uint32_t chunk_count = (sweep.size() + SAP_SWEEP_CHUNK_SIZE - 1) / SAP_SWEEP_CHUNK_SIZE;
+	if (chunk_pairs.size() < chunk_count) {
+		chunk_pairs.resize(chunk_count);
+	}
+
+	if (chunk_count > 1) {
+		p_work_pool.do_work(chunk_count, this, &BroadPhase3DSAP::_sweep_chunk, nullptr);
+	} else if (chunk_count == 1) {
+		_sweep_chunk(0, nullptr);
+	}
+
+	// Register new pairs. Callbacks are not thread safe, and going through the
+	// chunks in order keeps the results independent of the thread count.
+	for (uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+		const LocalVector<uint64_t> &chunk_result = chunk_pairs[chunk];
+		for (uint32_t i = 0; i < chunk_result.size(); i++) {
+			const uint64_t key = chunk_result[i];
+
+			uint32_t *existing = pair_map.getptr(key);
+			if (existing) {
+				pairs[*existing].pass = pass;
+				continue;
+			}
+
+			Pair pair;
+			pair.a = uint32_t(key >> 32);
+			pair.b = uint32_t(key & 0xFFFFFFFF);
+			pair.pass = pass;
+
+			Element &element_a = elements[pair.a];
+			Element &element_b = elements[pair.b];
+			element_a.pair_count++;
+			element_b.pair_count++;
+
+			if (pair_callback) {
+				pair.data = pair_callback(element_a.owner, element_a.subindex, element_b.owner, element_b.subindex, pair_userdata);
+			}
+
+			pair_map[key] = pairs.size();
+			pairs.push_back(pair);
+		}
+	}
+
+	// Remove pairs that were not found again.
+	for (int i = pairs.size() - 1; i >= 0; i--) {
+		if (pairs[i].pass != pass) {
+			_remove_pair(i);
+		}
+	}
+}
+
+void BroadPhase3DSAP::reset_pairs(ThreadWorkPool &p_work_pool) {
+	// Every update finds all the pairs again, there is no history to reset.
+	update(p_work_pool);
+}
+
+BroadPhase3DSW *BroadPhase3DSAP::_create() {
+	return memnew(BroadPhase3DSAP);
+}
+
+BroadPhase3DSAP::BroadPhase3DSAP() {
+}
@@ -0,0 +1,132 @@
+/*************************************************************************/
+/*  broad_phase_3d_sap.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BROAD_PHASE_3D_SAP_H
+#define BROAD_PHASE_3D_SAP_H
+
+#include "broad_phase_3d_sw.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Sweep and prune broadphase: elements are kept sorted by the start of their
+// AABB along the X axis, and pairs are found by sweeping that list.
+// It stays cheap with lots of moving objects spread over a large, mostly flat
+// world, where a tree needs constant refitting. Queries are slower than with
+// the BVH, as they can only use the sorted axis.
+class BroadPhase3DSAP : public BroadPhase3DSW {
+	struct Element {
+		CollisionObject3DSW *owner = nullptr;
+		int subindex = 0;
+		AABB aabb;
+		bool _static = false;
+		uint32_t pair_count = 0;
+	};
+
+	// Copy of the data needed to sweep, in sorted order, to keep the sweep cache friendly.
+	struct SweepEntry {
+		Vector3 min;
+		Vector3 max;
+		CollisionObject3DSW *owner = nullptr;
+		uint32_t element = 0;
+		bool _static = false;
+	};
+
+	struct Pair {
+		uint32_t a = 0;
+		uint32_t b = 0;
+		void *data = nullptr;
+		uint64_t pass = 0;
+	};
+
+	struct SortByStart {
+		const Element *elements = nullptr;
+		_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return elements[p_a].aabb.position.x < elements[p_b].aabb.position.x;
+		}
+	};
+
+	LocalVector<Element> elements;
+	LocalVector<uint32_t> free_elements;
+	// Removed elements can only be reused once they are out of the sorted list.
+	LocalVector<uint32_t> removed_elements;
+	LocalVector<uint32_t> added_elements;
+
+	LocalVector<uint32_t> order;
+	LocalVector<SweepEntry> sweep;
+	real_t max_width = 0.0;
+	bool sweep_dirty = false;
+
+	LocalVector<Pair> pairs;
+	HashMap<uint64_t, uint32_t> pair_map;
+	uint64_t pass = 1;
+
+	// Candidate pairs found by each sweep chunk.
+	LocalVector<LocalVector<uint64_t>> chunk_pairs;
+
+	PairCallback pair_callback = nullptr;
+	void *pair_userdata = nullptr;
+	UnpairCallback unpair_callback = nullptr;
+	void *unpair_userdata = nullptr;
+
+	static _FORCE_INLINE_ uint64_t _get_pair_key(uint32_t p_a, uint32_t p_b) {
+		return p_a < p_b ? ((uint64_t(p_a) << 32) | p_b) : ((uint64_t(p_b) << 32) | p_a);
+	}
+
+	void _update_sweep();
+	uint32_t _find_first_candidate(real_t p_min_x) const;
+	void _sweep_chunk(uint32_t p_chunk, void *p_userdata);
+	void _remove_pair(uint32_t p_pair_index);
+
+public:
+	// 0 is an invalid ID
+	virtual ID create(CollisionObject3DSW *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false);
+	virtual void move(ID p_id, const AABB &p_aabb);
+	virtual void set_static(ID p_id, bool p_static);
+	virtual void remove(ID p_id);
+
+	virtual CollisionObject3DSW *get_object(ID p_id) const;
+	virtual bool is_static(ID p_id) const;
+	virtual int get_subindex(ID p_id) const;
+
+	virtual int cull_point(const Vector3 &p_point, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices = nullptr);
+	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices = nullptr);
+	virtual int cull_aabb(const AABB &p_aabb, CollisionObject3DSW **p_results, int p_max_results, int *p_result_indices = nullptr);
+
+	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata);
+	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata);
+
+	virtual void update(ThreadWorkPool &p_work_pool);
+	virtual void reset_pairs(ThreadWorkPool &p_work_pool);
+
+	static BroadPhase3DSW *_create();
+	BroadPhase3DSAP();
+};
+
+#endif // BROAD_PHASE_3D_SAP_H
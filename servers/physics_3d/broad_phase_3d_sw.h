@@ -33,6 +33,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/math_funcs.h"
+#include "core/templates/thread_work_pool.h"
 
 class CollisionObject3DSW;
 
@@ -64,7 +65,10 @@ public:
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
-	virtual void update() = 0;
+	virtual void update(ThreadWorkPool &p_work_pool) = 0;
+	// Like update(), but the pairs only depend on the current AABBs afterwards, not
+	// on how the objects moved before. Used to save and restore space states.
+	virtual void reset_pairs(ThreadWorkPool &p_work_pool) = 0;
 
 	virtual ~BroadPhase3DSW();
 };
@@ -181,6 +181,19 @@ void CollisionObject3DSW::_update_shapes() {
 	}
 }
 
+// Shape AABBs are grown based on their previous size, so they're part of the
+// state saved by the space.
+void CollisionObject3DSW::restore_shape_aabb(int p_index, const AABB &p_aabb) {
+	ERR_FAIL_INDEX(p_index, shapes.size());
+	Shape &s = shapes.write[p_index];
+	if (s.disabled || s.bpid == 0) {
+		return;
+	}
+
+	s.aabb_cache = p_aabb;
+	space->get_broadphase()->move(s.bpid, p_aabb);
+}
+
 void CollisionObject3DSW::_update_shapes_with_motion(const Vector3 &p_motion) {
 	if (!space) {
 		return;
@@ -136,6 +136,7 @@ public:
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].aabb_cache;
 	}
+	void restore_shape_aabb(int p_index, const AABB &p_aabb);
 	_FORCE_INLINE_ real_t get_shape_area(int p_index) const {
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].area_cache;
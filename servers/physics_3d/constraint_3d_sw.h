@@ -32,14 +32,17 @@
 #define CONSTRAINT_SW_H
 
 class Body3DSW;
+class BodyPair3DSW;
 class SoftBody3DSW;
 
 class Constraint3DSW {
 	Body3DSW **_body_ptr;
 	int _body_count;
 	uint64_t island_step;
+	uint32_t island_static_bodies = 0;
 	int priority;
 	bool disabled_collisions_between_bodies;
+	uint64_t sort_key[3] = {};
 
 	RID self;
 
@@ -52,19 +55,48 @@ protected:
 		disabled_collisions_between_bodies = true;
 	}
 
+	// Must be set before the constraint is added to the bodies, and be unique among
+	// the constraints of a body.
+	_FORCE_INLINE_ void set_sort_key(uint64_t p_a, uint64_t p_b, uint64_t p_c) {
+		sort_key[0] = p_a;
+		sort_key[1] = p_b;
+		sort_key[2] = p_c;
+	}
+
 public:
+	// Orders constraints by what they connect instead of by address, so islands
+	// are built in the same order when pairs are recreated (e.g. after restoring
+	// a saved state).
+	struct Comparator {
+		_FORCE_INLINE_ bool operator()(const Constraint3DSW *p_a, const Constraint3DSW *p_b) const {
+			for (int i = 0; i < 3; i++) {
+				if (p_a->sort_key[i] != p_b->sort_key[i]) {
+					return p_a->sort_key[i] < p_b->sort_key[i];
+				}
+			}
+			return false;
+		}
+	};
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	// Bodies the island walk left out of this constraint's island (one bit per body index).
+	// They are solved as static in this step, even if they are woken up later on.
+	_FORCE_INLINE_ void set_island_static_bodies(uint32_t p_mask) { island_static_bodies = p_mask; }
+	_FORCE_INLINE_ bool is_body_static_in_island(int p_index) const { return island_static_bodies & (1 << p_index); }
+
 	_FORCE_INLINE_ Body3DSW **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
 	virtual SoftBody3DSW *get_soft_body_ptr(int p_index) const { return nullptr; }
 	virtual int get_soft_body_count() const { return 0; }
 
+	virtual BodyPair3DSW *get_body_pair() { return nullptr; }
+
 	_FORCE_INLINE_ void set_priority(int p_priority) { priority = p_priority; }
 	_FORCE_INLINE_ int get_priority() const { return priority; }
 
@@ -53,6 +53,9 @@ public:
 	virtual PhysicsServer3D::JointType get_type() const { return PhysicsServer3D::JOINT_TYPE_MAX; }
 	_FORCE_INLINE_ Joint3DSW(Body3DSW **p_body_ptr = nullptr, int p_body_count = 0) :
 			Constraint3DSW(p_body_ptr, p_body_count) {
+		// Joints are never recreated by the space, so creation order is stable.
+		static uint64_t joint_count = 0;
+		set_sort_key(0, ++joint_count, 0);
 	}
 
 	virtual ~Joint3DSW() {
@@ -31,6 +31,8 @@
 #include "physics_server_3d_sw.h"
 
 #include "broad_phase_3d_bvh.h"
+#include "broad_phase_3d_sap.h"
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/os/os.h"
 #include "joints/cone_twist_joint_3d_sw.h"
@@ -212,6 +214,20 @@ int PhysicsServer3DSW::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> PhysicsServer3DSW::space_save_state(RID p_space) const {
+	Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+
+	return space->save_state(stepper->get_work_pool());
+}
+
+Error PhysicsServer3DSW::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+
+	return space->restore_state(p_state, stepper->get_work_pool());
+}
+
 RID PhysicsServer3DSW::area_create() {
 	Area3DSW *area = memnew(Area3DSW);
 	RID rid = area_owner.make_rid(area);
@@ -1744,7 +1760,14 @@ void PhysicsServer3DSW::_shape_col_cbk(const Vector3 &p_point_A, int p_index_A,
 PhysicsServer3DSW *PhysicsServer3DSW::singletonsw = nullptr;
 PhysicsServer3DSW::PhysicsServer3DSW(bool p_using_threads) {
 	singletonsw = this;
-	BroadPhase3DSW::create_func = BroadPhase3DBVH::_create;
+
+	int broadphase = GLOBAL_DEF("physics/3d/godot_physics/broadphase", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/godot_physics/broadphase", PropertyInfo(Variant::INT, "physics/3d/godot_physics/broadphase", PROPERTY_HINT_ENUM, "BVH,Sweep and Prune"));
+	if (broadphase == 1) {
+		BroadPhase3DSW::create_func = BroadPhase3DSAP::_create;
+	} else {
+		BroadPhase3DSW::create_func = BroadPhase3DBVH::_create;
+	}
 
 	island_count = 0;
 	active_objects = 0;
@@ -38,9 +38,137 @@ void PhysicsServer3DWrapMT::thread_exit() {
 
 void PhysicsServer3DWrapMT::thread_step(real_t p_delta) {
 	physics_3d_server->step(p_delta);
+	_update_snapshots();
 	step_sem.post();
 }
 
+void PhysicsServer3DWrapMT::thread_free(RID p_rid) {
+	{
+		// Also drop requests made before the free, so the dead RID isn't tracked again after the step.
+		MutexLock lock(snapshot_mutex);
+		if (created_bodies.erase(p_rid)) {
+			for (uint32_t i = 0; i < snapshot_requests.size(); i++) {
+				if (snapshot_requests[i] == p_rid) {
+					snapshot_requests.remove_unordered(i);
+					i--;
+				}
+			}
+			snapshots[0].erase(p_rid);
+			snapshots[1].erase(p_rid);
+		}
+	}
+	snapshot_bodies.erase(p_rid);
+	physics_3d_server->free(p_rid);
+}
+
+/* STATE SNAPSHOTS */
+
+bool PhysicsServer3DWrapMT::_get_snapshot(RID p_body, BodySnapshot &r_snapshot) const {
+	MutexLock lock(snapshot_mutex);
+
+	const BodySnapshot *snapshot = snapshots[snapshot_front].getptr(p_body);
+	if (snapshot) {
+		r_snapshot = *snapshot;
+		return true;
+	}
+
+	// Start tracking the body, it will be part of the snapshot after the next step.
+	if (created_bodies.has(p_body)) {
+		snapshot_requests.push_back(p_body);
+	}
+	return false;
+}
+
+void PhysicsServer3DWrapMT::_update_snapshots() {
+	{
+		MutexLock lock(snapshot_mutex);
+		for (uint32_t i = 0; i < snapshot_requests.size(); i++) {
+			snapshot_bodies.insert(snapshot_requests[i]);
+		}
+		snapshot_requests.clear();
+	}
+
+	if (snapshot_bodies.is_empty() && snapshots[snapshot_front].is_empty()) {
+		return;
+	}
+
+	// Only this thread writes the buffers, so the front one can be read without locking.
+	const HashMap<RID, BodySnapshot> &front = snapshots[snapshot_front];
+	HashMap<RID, BodySnapshot> &back = snapshots[1 - snapshot_front];
+	back.clear();
+
+	for (Set<RID>::Element *E = snapshot_bodies.front(); E; E = E->next()) {
+		const RID &body = E->get();
+
+		BodySnapshot snapshot;
+		snapshot.transform = physics_3d_server->body_get_state(body, BODY_STATE_TRANSFORM);
+		snapshot.linear_velocity = physics_3d_server->body_get_state(body, BODY_STATE_LINEAR_VELOCITY);
+		snapshot.angular_velocity = physics_3d_server->body_get_state(body, BODY_STATE_ANGULAR_VELOCITY);
+		snapshot.sleeping = physics_3d_server->body_get_state(body, BODY_STATE_SLEEPING);
+
+		const BodySnapshot *previous = front.getptr(body);
+		snapshot.previous_transform = previous ? previous->transform : snapshot.transform;
+
+		back.set(body, snapshot);
+	}
+
+	MutexLock lock(snapshot_mutex);
+	snapshot_front = 1 - snapshot_front;
+}
+
+Variant PhysicsServer3DWrapMT::body_get_state(RID p_body, BodyState p_state) const {
+	if (Thread::get_caller_id() != server_thread) {
+		if (async_snapshot) {
+			switch (p_state) {
+				case BODY_STATE_TRANSFORM:
+				case BODY_STATE_LINEAR_VELOCITY:
+				case BODY_STATE_ANGULAR_VELOCITY:
+				case BODY_STATE_SLEEPING: {
+					BodySnapshot snapshot;
+					if (_get_snapshot(p_body, snapshot)) {
+						switch (p_state) {
+							case BODY_STATE_TRANSFORM:
+								return snapshot.transform;
+							case BODY_STATE_LINEAR_VELOCITY:
+								return snapshot.linear_velocity;
+							case BODY_STATE_ANGULAR_VELOCITY:
+								return snapshot.angular_velocity;
+							default:
+								return snapshot.sleeping;
+						}
+					}
+				} break;
+				default: {
+				}
+			}
+		}
+
+		Variant ret;
+		command_queue.push_and_ret(physics_3d_server, &PhysicsServer3D::body_get_state, p_body, p_state, &ret);
+		return ret;
+	} else {
+		command_queue.flush_if_pending();
+		return physics_3d_server->body_get_state(p_body, p_state);
+	}
+}
+
+Transform3D PhysicsServer3DWrapMT::body_get_interpolated_transform(RID p_body, real_t p_fraction) const {
+	BodySnapshot snapshot;
+	if (_get_snapshot(p_body, snapshot)) {
+		return snapshot.previous_transform.interpolate_with(snapshot.transform, p_fraction);
+	}
+	return body_get_state(p_body, BODY_STATE_TRANSFORM);
+}
+
+void PhysicsServer3DWrapMT::free(RID p_rid) {
+	if (Thread::get_caller_id() != server_thread) {
+		command_queue.push(this, &PhysicsServer3DWrapMT::thread_free, p_rid);
+	} else {
+		command_queue.flush_if_pending();
+		thread_free(p_rid);
+	}
+}
+
 void PhysicsServer3DWrapMT::_thread_callback(void *_instance) {
 	PhysicsServer3DWrapMT *vsmt = reinterpret_cast<PhysicsServer3DWrapMT *>(_instance);
 
@@ -72,6 +200,7 @@ void PhysicsServer3DWrapMT::step(real_t p_step) {
 	} else {
 		command_queue.flush_all(); //flush all pending from other threads
 		physics_3d_server->step(p_step);
+		_update_snapshots();
 	}
 }
 
@@ -123,6 +252,7 @@ PhysicsServer3DWrapMT::PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool
 	step_thread_up = false;
 
 	pool_max_size = GLOBAL_GET("memory/limits/multithreaded_server/rid_pool_prealloc");
+	async_snapshot = p_create_thread && bool(GLOBAL_GET("physics/3d/async_state_snapshot"));
 
 	if (!p_create_thread) {
 		server_thread = Thread::get_caller_id();
@@ -34,6 +34,9 @@
 #include "core/config/project_settings.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/set.h"
 #include "servers/physics_server_3d.h"
 
 #ifdef DEBUG_SYNC
@@ -69,6 +72,28 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	Mutex alloc_mutex;
 	int pool_max_size = 0;
 
+	struct BodySnapshot {
+		Transform3D previous_transform;
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		bool sleeping = false;
+	};
+
+	// Double-buffered body states of the last completed step. The server thread
+	// fills the back buffer after each step and swaps, other threads read the front one.
+	bool async_snapshot = false;
+	mutable Mutex snapshot_mutex;
+	HashMap<RID, BodySnapshot> snapshots[2];
+	int snapshot_front = 0;
+	mutable LocalVector<RID> snapshot_requests;
+	Set<RID> snapshot_bodies; // Only accessed from the server thread.
+	Set<RID> created_bodies; // Only bodies can be tracked, other RIDs fall back to the command queue.
+
+	bool _get_snapshot(RID p_body, BodySnapshot &r_snapshot) const;
+	void _update_snapshots();
+	void thread_free(RID p_rid);
+
 public:
 #define ServerName PhysicsServer3D
 #define ServerNameWrapMT PhysicsServer3DWrapMT
@@ -131,6 +156,9 @@ public:
 		return physics_3d_server->space_get_contact_count(p_space);
 	}
 
+	FUNC1RC(Vector<uint8_t>, space_save_state, RID);
+	FUNC2R(Error, space_restore_state, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -174,7 +202,12 @@ public:
 	/* BODY API */
 
 	//FUNC2RID(body,BodyMode,bool);
-	FUNCRID(body)
+	virtual RID body_create() override {
+		RID body = physics_3d_server->body_create();
+		MutexLock lock(snapshot_mutex);
+		created_bodies.insert(body);
+		return body;
+	}
 
 	FUNC2(body_set_space, RID, RID);
 	FUNC1RC(RID, body_get_space, RID);
@@ -214,7 +247,8 @@ public:
 	FUNC2RC(real_t, body_get_param, RID, BodyParameter);
 
 	FUNC3(body_set_state, RID, BodyState, const Variant &);
-	FUNC2RC(Variant, body_get_state, RID, BodyState);
+	virtual Variant body_get_state(RID p_body, BodyState p_state) const override;
+	virtual Transform3D body_get_interpolated_transform(RID p_body, real_t p_fraction) const override;
 
 	FUNC2(body_set_applied_force, RID, const Vector3 &);
 	FUNC1RC(Vector3, body_get_applied_force, RID);
@@ -375,7 +409,7 @@ public:
 
 	/* MISC */
 
-	FUNC1(free, RID);
+	virtual void free(RID p_rid) override;
 	FUNC1(set_active, bool);
 	FUNC1(set_collision_iterations, int);
 
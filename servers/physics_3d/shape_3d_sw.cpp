@@ -1635,8 +1635,33 @@ ConcavePolygonShape3DSW::ConcavePolygonShape3DSW() {
 
 /* HEIGHT MAP SHAPE */
 
+// Slack added to quadtree nodes and cells when testing them against segments,
+// so that rays going exactly along cell edges are not discarded by rounding errors.
+#define HEIGHTMAP_SEGMENT_MARGIN 0.01
+
+static _FORCE_INLINE_ real_t _heightmap_fetch(const uint8_t *p_data, bool p_half, int p_index) {
+	if (p_half) {
+		return Math::half_to_float(((const uint16_t *)p_data)[p_index]);
+	}
+	return ((const float *)p_data)[p_index];
+}
+
 Vector<float> HeightMapShape3DSW::get_heights() const {
-	return heights;
+	if (!compressed) {
+		return heights;
+	}
+
+	Vector<float> decoded;
+	decoded.resize(width * depth);
+
+	float *w = decoded.ptrw();
+	for (int z = 0; z < depth; z++) {
+		for (int x = 0; x < width; x++) {
+			w[(z * width) + x] = _get_height(x, z);
+		}
+	}
+
+	return decoded;
 }
 
 int HeightMapShape3DSW::get_width() const {
@@ -1647,6 +1672,10 @@ int HeightMapShape3DSW::get_depth() const {
 	return depth;
 }
 
+bool HeightMapShape3DSW::is_compressed() const {
+	return compressed;
+}
+
 void HeightMapShape3DSW::project_range(const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) const {
 	//not very useful, but not very used either
 	p_transform.xform(get_aabb()).project_range_in_plane(Plane(p_normal, 0), r_min, r_max);
@@ -1662,6 +1691,13 @@ struct _HeightmapSegmentCullParams {
 	Vector3 to;
 	Vector3 dir;
 
+	// Segment in grid space, used to test quadtree nodes.
+	Vector3 local_from;
+	Vector3 local_segment;
+	real_t inv_length_squared = 0.0;
+
+	bool found = false;
+	real_t min_t = 0.0;
 	Vector3 result;
 	Vector3 normal;
 
@@ -1669,12 +1705,52 @@ struct _HeightmapSegmentCullParams {
 	FaceShape3DSW *face = nullptr;
 };
 
+_FORCE_INLINE_ bool _heightmap_segment_intersects_aabb(const Vector3 &p_from, const Vector3 &p_segment, const AABB &p_aabb, real_t &r_min, real_t &r_max) {
+	real_t t_min = 0.0;
+	real_t t_max = 1.0;
+
+	for (int i = 0; i < 3; i++) {
+		real_t lo = p_aabb.position[i] - HEIGHTMAP_SEGMENT_MARGIN;
+		real_t hi = p_aabb.position[i] + p_aabb.size[i] + HEIGHTMAP_SEGMENT_MARGIN;
+
+		if (Math::abs(p_segment[i]) < CMP_EPSILON) {
+			if ((p_from[i] < lo) || (p_from[i] > hi)) {
+				return false;
+			}
+			continue;
+		}
+
+		real_t inv = 1.0 / p_segment[i];
+		real_t t0 = (lo - p_from[i]) * inv;
+		real_t t1 = (hi - p_from[i]) * inv;
+		if (t0 > t1) {
+			SWAP(t0, t1);
+		}
+
+		t_min = MAX(t_min, t0);
+		t_max = MIN(t_max, t1);
+		if (t_min > t_max) {
+			return false;
+		}
+	}
+
+	r_min = t_min;
+	r_max = t_max;
+	return true;
+}
+
 _FORCE_INLINE_ bool _heightmap_face_cull_segment(_HeightmapSegmentCullParams &p_params) {
 	Vector3 res;
 	Vector3 normal;
 	if (p_params.face->intersect_segment(p_params.from, p_params.to, res, normal)) {
-		p_params.result = res;
-		p_params.normal = normal;
+		// Keep the closest hit, cells are not visited in strict order.
+		real_t t = (res - p_params.from).dot(p_params.to - p_params.from) * p_params.inv_length_squared;
+		if (!p_params.found || (t < p_params.min_t)) {
+			p_params.found = true;
+			p_params.min_t = t;
+			p_params.result = res;
+			p_params.normal = normal;
+		}
 		return true;
 	}
 
@@ -1682,13 +1758,15 @@ _FORCE_INLINE_ bool _heightmap_face_cull_segment(_HeightmapSegmentCullParams &p_
 }
 
 _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_params, int p_x, int p_z) {
+	bool hit = false;
+
 	// First triangle.
 	p_params.heightmap->_get_point(p_x, p_z, p_params.face->vertex[0]);
 	p_params.heightmap->_get_point(p_x + 1, p_z, p_params.face->vertex[1]);
 	p_params.heightmap->_get_point(p_x, p_z + 1, p_params.face->vertex[2]);
 	p_params.face->normal = Plane(p_params.face->vertex[0], p_params.face->vertex[1], p_params.face->vertex[2]).normal;
 	if (_heightmap_face_cull_segment(p_params)) {
-		return true;
+		hit = true;
 	}
 
 	// Second triangle.
@@ -1696,157 +1774,138 @@ _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_
 	p_params.heightmap->_get_point(p_x + 1, p_z + 1, p_params.face->vertex[1]);
 	p_params.face->normal = Plane(p_params.face->vertex[0], p_params.face->vertex[1], p_params.face->vertex[2]).normal;
 	if (_heightmap_face_cull_segment(p_params)) {
-		return true;
+		hit = true;
 	}
 
-	return false;
+	return hit;
 }
 
-bool HeightMapShape3DSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
-	if (heights.is_empty()) {
-		return false;
-	}
-
-	Vector3 local_begin = p_begin + local_origin;
-	Vector3 local_end = p_end + local_origin;
-
-	FaceShape3DSW face;
-	face.backface_collision = false;
-
-	_HeightmapSegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
-	params.heightmap = this;
-	params.face = &face;
-
-	// Quantize the ray begin/end.
-	int begin_x = floor(local_begin.x);
-	int begin_z = floor(local_begin.z);
-	int end_x = floor(local_end.x);
-	int end_z = floor(local_end.z);
-
-	if ((begin_x == end_x) && (begin_z == end_z)) {
-		// Simple case for rays that don't traverse the grid horizontally.
-		// Just perform a test on the given cell.
-		int x = CLAMP(begin_x, 0, width - 2);
-		int z = CLAMP(begin_z, 0, depth - 2);
-		if (_heightmap_cell_cull_segment(params, x, z)) {
-			r_point = params.result;
-			r_normal = params.normal;
-			return true;
-		}
-	} else {
-		// Perform grid query from projected ray.
-		Vector2 ray_dir_proj(local_end.x - local_begin.x, local_end.z - local_begin.z);
-		real_t ray_dist_proj = ray_dir_proj.length();
+void HeightMapShape3DSW::_get_node_aabb(int p_level, int p_x, int p_z, AABB &r_aabb) const {
+	const Level &level = levels[p_level];
+	const Range &range = level.ranges[(p_z * level.width) + p_x];
 
-		if (ray_dist_proj < CMP_EPSILON) {
-			ray_dir_proj = Vector2();
-		} else {
-			ray_dir_proj /= ray_dist_proj;
-		}
+	const int span = LEAF_SIZE << p_level;
+	const int start_x = p_x * span;
+	const int start_z = p_z * span;
+	const int end_x = MIN(start_x + span, width - 1);
+	const int end_z = MIN(start_z + span, depth - 1);
 
-		const int x_step = (ray_dir_proj.x > CMP_EPSILON) ? 1 : ((ray_dir_proj.x < -CMP_EPSILON) ? -1 : 0);
-		const int z_step = (ray_dir_proj.y > CMP_EPSILON) ? 1 : ((ray_dir_proj.y < -CMP_EPSILON) ? -1 : 0);
+	r_aabb.position = Vector3(start_x, range.min_height, start_z);
+	r_aabb.size = Vector3(end_x - start_x, range.max_height - range.min_height, end_z - start_z);
+}
 
-		const real_t infinite = 1e20;
-		const real_t delta_x = (x_step != 0) ? 1.f / Math::abs(ray_dir_proj.x) : infinite;
-		const real_t delta_z = (z_step != 0) ? 1.f / Math::abs(ray_dir_proj.y) : infinite;
+bool HeightMapShape3DSW::_intersect_segment_node(int p_level, int p_x, int p_z, _HeightmapSegmentCullParams &p_params) const {
+	if (p_level == 0) {
+		AABB leaf_aabb;
+		_get_node_aabb(0, p_x, p_z, leaf_aabb);
 
-		real_t cross_x; // At which value of `param` we will cross a x-axis lane?
-		real_t cross_z; // At which value of `param` we will cross a z-axis lane?
+		const int start_x = leaf_aabb.position.x;
+		const int start_z = leaf_aabb.position.z;
+		const int end_x = start_x + leaf_aabb.size.x;
+		const int end_z = start_z + leaf_aabb.size.z;
 
-		// X initialization.
-		if (x_step != 0) {
-			if (x_step == 1) {
-				cross_x = (ceil(local_begin.x) - local_begin.x) * delta_x;
-			} else {
-				cross_x = (local_begin.x - floor(local_begin.x)) * delta_x;
+		bool hit = false;
+		for (int z = start_z; z < end_z; z++) {
+			for (int x = start_x; x < end_x; x++) {
+				// Only test the triangles of cells crossed by the segment.
+				AABB cell_aabb(Vector3(x, leaf_aabb.position.y, z), Vector3(1.0, leaf_aabb.size.y, 1.0));
+				real_t t_min, t_max;
+				if (!_heightmap_segment_intersects_aabb(p_params.local_from, p_params.local_segment, cell_aabb, t_min, t_max)) {
+					continue;
+				}
+				if (p_params.found && (t_min > p_params.min_t)) {
+					continue;
+				}
+				if (_heightmap_cell_cull_segment(p_params, x, z)) {
+					hit = true;
+				}
 			}
-		} else {
-			cross_x = infinite; // Will never cross on X.
 		}
-
-		// Z initialization.
-		if (z_step != 0) {
-			if (z_step == 1) {
-				cross_z = (ceil(local_begin.z) - local_begin.z) * delta_z;
-			} else {
-				cross_z = (local_begin.z - floor(local_begin.z)) * delta_z;
-			}
-		} else {
-			cross_z = infinite; // Will never cross on Z.
+		return hit;
+	}
+
+	// Visit children front to back, so farther ones can be skipped once a hit is found.
+	struct Child {
+		int x = 0;
+		int z = 0;
+		real_t t = 0.0;
+	} children[4];
+	int child_count = 0;
+
+	const Level &child_level = levels[p_level - 1];
+	for (int i = 0; i < 4; i++) {
+		const int child_x = (p_x << 1) + (i & 1);
+		const int child_z = (p_z << 1) + (i >> 1);
+		if ((child_x >= child_level.width) || (child_z >= child_level.depth)) {
+			continue;
 		}
 
-		int x = floor(local_begin.x);
-		int z = floor(local_begin.z);
+		AABB child_aabb;
+		_get_node_aabb(p_level - 1, child_x, child_z, child_aabb);
+		real_t t_min, t_max;
+		if (!_heightmap_segment_intersects_aabb(p_params.local_from, p_params.local_segment, child_aabb, t_min, t_max)) {
+			continue;
+		}
 
-		// Workaround cases where the ray starts at an integer position.
-		if (Math::abs(cross_x) < CMP_EPSILON) {
-			cross_x += delta_x;
-			// If going backwards, we should ignore the position we would get by the above flooring,
-			// because the ray is not heading in that direction.
-			if (x_step == -1) {
-				x -= 1;
-			}
+		int j = child_count++;
+		while ((j > 0) && (children[j - 1].t > t_min)) {
+			children[j] = children[j - 1];
+			j--;
 		}
+		children[j].x = child_x;
+		children[j].z = child_z;
+		children[j].t = t_min;
+	}
 
-		if (Math::abs(cross_z) < CMP_EPSILON) {
-			cross_z += delta_z;
-			if (z_step == -1) {
-				z -= 1;
-			}
+	bool hit = false;
+	for (int i = 0; i < child_count; i++) {
+		if (p_params.found && (children[i].t > p_params.min_t)) {
+			break;
 		}
+		if (_intersect_segment_node(p_level - 1, children[i].x, children[i].z, p_params)) {
+			hit = true;
+		}
+	}
 
-		// Start inside the grid.
-		int x_start = CLAMP(x, 0, width - 2);
-		int z_start = CLAMP(z, 0, depth - 2);
+	return hit;
+}
 
-		// Adjust initial cross values.
-		cross_x += delta_x * x_step * (x_start - x);
-		cross_z += delta_z * z_step * (z_start - z);
+bool HeightMapShape3DSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+	if (_is_empty() || levels.is_empty()) {
+		return false;
+	}
 
-		x = x_start;
-		z = z_start;
+	real_t length_squared = (p_end - p_begin).length_squared();
+	if (length_squared < CMP_EPSILON2) {
+		return false;
+	}
 
-		if (_heightmap_cell_cull_segment(params, x, z)) {
-			r_point = params.result;
-			r_normal = params.normal;
-			return true;
-		}
+	FaceShape3DSW face;
+	face.backface_collision = false;
 
-		real_t dist = 0.0;
-		while (true) {
-			if (cross_x < cross_z) {
-				// X lane.
-				x += x_step;
-				// Assign before advancing the param,
-				// to be in sync with the initialization step.
-				dist = cross_x;
-				cross_x += delta_x;
-			} else {
-				// Z lane.
-				z += z_step;
-				dist = cross_z;
-				cross_z += delta_z;
-			}
+	_HeightmapSegmentCullParams params;
+	params.from = p_begin;
+	params.to = p_end;
+	params.dir = (p_end - p_begin).normalized();
+	params.local_from = p_begin + local_origin;
+	params.local_segment = p_end - p_begin;
+	params.inv_length_squared = 1.0 / length_squared;
+	params.heightmap = this;
+	params.face = &face;
 
-			// Stop when outside the grid.
-			if ((x < 0) || (z < 0) || (x >= width - 1) || (z >= depth - 1)) {
-				break;
-			}
+	const int root = levels.size() - 1;
 
-			if (_heightmap_cell_cull_segment(params, x, z)) {
-				r_point = params.result;
-				r_normal = params.normal;
-				return true;
-			}
+	AABB root_aabb;
+	_get_node_aabb(root, 0, 0, root_aabb);
+	real_t t_min, t_max;
+	if (!_heightmap_segment_intersects_aabb(params.local_from, params.local_segment, root_aabb, t_min, t_max)) {
+		return false;
+	}
 
-			if (dist > ray_dist_proj) {
-				break;
-			}
-		}
+	if (_intersect_segment_node(root, 0, 0, params)) {
+		r_point = params.result;
+		r_normal = params.normal;
+		return true;
 	}
 
 	return false;
@@ -1875,8 +1934,82 @@ void HeightMapShape3DSW::_get_cell(const Vector3 &p_point, int &r_x, int &r_y, i
 	r_z = (clamped_point.z < 0.0) ? (clamped_point.z - 0.5) : (clamped_point.z + 0.5);
 }
 
+struct _HeightmapCullParams {
+	real_t min_y = 0.0;
+	real_t max_y = 0.0;
+
+	int start_x = 0;
+	int start_z = 0;
+	int end_x = 0;
+	int end_z = 0;
+
+	ConcaveShape3DSW::Callback callback = nullptr;
+	void *userdata = nullptr;
+	FaceShape3DSW *face = nullptr;
+};
+
+void HeightMapShape3DSW::_cull_node(int p_level, int p_x, int p_z, _HeightmapCullParams &p_params) const {
+	const Level &level = levels[p_level];
+	const Range &range = level.ranges[(p_z * level.width) + p_x];
+	if ((range.min_height > p_params.max_y) || (range.max_height < p_params.min_y)) {
+		return;
+	}
+
+	const int span = LEAF_SIZE << p_level;
+	const int start_x = MAX(p_x * span, p_params.start_x);
+	const int start_z = MAX(p_z * span, p_params.start_z);
+	const int end_x = MIN((p_x + 1) * span, p_params.end_x);
+	const int end_z = MIN((p_z + 1) * span, p_params.end_z);
+	if ((start_x >= end_x) || (start_z >= end_z)) {
+		return;
+	}
+
+	if (p_level > 0) {
+		const Level &child_level = levels[p_level - 1];
+		for (int i = 0; i < 4; i++) {
+			const int child_x = (p_x << 1) + (i & 1);
+			const int child_z = (p_z << 1) + (i >> 1);
+			if ((child_x < child_level.width) && (child_z < child_level.depth)) {
+				_cull_node(p_level - 1, child_x, child_z, p_params);
+			}
+		}
+		return;
+	}
+
+	FaceShape3DSW &face = *p_params.face;
+	Vector3 points[4];
+
+	for (int z = start_z; z < end_z; z++) {
+		for (int x = start_x; x < end_x; x++) {
+			_get_point(x, z, points[0]);
+			_get_point(x + 1, z, points[1]);
+			_get_point(x, z + 1, points[2]);
+			_get_point(x + 1, z + 1, points[3]);
+
+			real_t cell_min = MIN(MIN(points[0].y, points[1].y), MIN(points[2].y, points[3].y));
+			real_t cell_max = MAX(MAX(points[0].y, points[1].y), MAX(points[2].y, points[3].y));
+			if ((cell_min > p_params.max_y) || (cell_max < p_params.min_y)) {
+				continue;
+			}
+
+			// First triangle.
+			face.vertex[0] = points[0];
+			face.vertex[1] = points[1];
+			face.vertex[2] = points[2];
+			face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
+			p_params.callback(p_params.userdata, &face);
+
+			// Second triangle.
+			face.vertex[0] = points[1];
+			face.vertex[1] = points[3];
+			face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
+			p_params.callback(p_params.userdata, &face);
+		}
+	}
+}
+
 void HeightMapShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
-	if (heights.is_empty()) {
+	if (_is_empty() || levels.is_empty()) {
 		return;
 	}
 
@@ -1896,30 +2029,22 @@ void HeightMapShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback, voi
 		aabb_max[i]++;
 	}
 
-	int start_x = MAX(0, aabb_min[0]);
-	int end_x = MIN(width - 1, aabb_max[0]);
-	int start_z = MAX(0, aabb_min[2]);
-	int end_z = MIN(depth - 1, aabb_max[2]);
-
 	FaceShape3DSW face;
 	face.backface_collision = true;
 
-	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
-			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
-			p_callback(p_userdata, &face);
+	_HeightmapCullParams params;
+	params.min_y = local_aabb.position.y;
+	params.max_y = local_aabb.position.y + local_aabb.size.y;
+	params.start_x = MAX(0, aabb_min[0]);
+	params.end_x = MIN(width - 1, aabb_max[0]);
+	params.start_z = MAX(0, aabb_min[2]);
+	params.end_z = MIN(depth - 1, aabb_max[2]);
+	params.callback = p_callback;
+	params.userdata = p_userdata;
+	params.face = &face;
 
-			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
-			p_callback(p_userdata, &face);
-		}
-	}
+	// Descend the min/max quadtree, skipping whole blocks outside of the aabb height range.
+	_cull_node(levels.size() - 1, 0, 0, params);
 }
 
 Vector3 HeightMapShape3DSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1932,11 +2057,135 @@ Vector3 HeightMapShape3DSW::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.x * extents.x + extents.y * extents.y));
 }
 
-void HeightMapShape3DSW::_setup(const Vector<float> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
-	heights = p_heights;
+void HeightMapShape3DSW::_store_heights(const uint8_t *p_data, bool p_half, int p_width, int p_depth) {
+	compressed = false;
+	quantized_heights.clear();
+	tiles.clear();
+	tiles_width = 0;
+
+	heights.resize(p_width * p_depth);
+
+	float *w = heights.ptrw();
+	for (int i = 0; i < heights.size(); ++i) {
+		w[i] = _heightmap_fetch(p_data, p_half, i);
+	}
+}
+
+void HeightMapShape3DSW::_store_compressed_heights(const uint8_t *p_data, bool p_half, int p_width, int p_depth) {
+	compressed = true;
+	heights.clear();
+
+	quantized_heights.resize(p_width * p_depth);
+	tiles_width = (p_width + TILE_SIZE - 1) >> TILE_SHIFT;
+	const int tiles_depth = (p_depth + TILE_SIZE - 1) >> TILE_SHIFT;
+	tiles.resize(tiles_width * tiles_depth);
+
+	uint16_t *w = quantized_heights.ptrw();
+
+	for (int tile_z = 0; tile_z < tiles_depth; tile_z++) {
+		for (int tile_x = 0; tile_x < tiles_width; tile_x++) {
+			const int start_x = tile_x << TILE_SHIFT;
+			const int start_z = tile_z << TILE_SHIFT;
+			const int end_x = MIN(start_x + TILE_SIZE, p_width);
+			const int end_z = MIN(start_z + TILE_SIZE, p_depth);
+
+			real_t min_height = _heightmap_fetch(p_data, p_half, (start_z * p_width) + start_x);
+			real_t max_height = min_height;
+			for (int z = start_z; z < end_z; z++) {
+				for (int x = start_x; x < end_x; x++) {
+					real_t h = _heightmap_fetch(p_data, p_half, (z * p_width) + x);
+					min_height = MIN(min_height, h);
+					max_height = MAX(max_height, h);
+				}
+			}
+
+			Tile &tile = tiles[(tile_z * tiles_width) + tile_x];
+			tile.min_height = min_height;
+			tile.scale = (max_height - min_height) / 65535.0;
+
+			const real_t inv_scale = (tile.scale > 0.0) ? (1.0 / tile.scale) : 0.0;
+			for (int z = start_z; z < end_z; z++) {
+				for (int x = start_x; x < end_x; x++) {
+					const int index = (z * p_width) + x;
+					real_t q = Math::round((_heightmap_fetch(p_data, p_half, index) - min_height) * inv_scale);
+					w[index] = CLAMP(q, 0, 65535);
+				}
+			}
+		}
+	}
+}
+
+void HeightMapShape3DSW::_build_levels() {
+	levels.clear();
+
+	const int cells_x = width - 1;
+	const int cells_z = depth - 1;
+	if ((cells_x <= 0) || (cells_z <= 0)) {
+		return;
+	}
+
+	// Leaves store the range of the (decoded) heights of the cells they cover,
+	// so culling stays conservative with respect to quantization.
+	levels.resize(1);
+	{
+		Level &leaves = levels[0];
+		leaves.width = (cells_x + LEAF_SIZE - 1) >> LEAF_SHIFT;
+		leaves.depth = (cells_z + LEAF_SIZE - 1) >> LEAF_SHIFT;
+		leaves.ranges.resize(leaves.width * leaves.depth);
+
+		for (int leaf_z = 0; leaf_z < leaves.depth; leaf_z++) {
+			for (int leaf_x = 0; leaf_x < leaves.width; leaf_x++) {
+				const int start_x = leaf_x << LEAF_SHIFT;
+				const int start_z = leaf_z << LEAF_SHIFT;
+				const int end_x = MIN(start_x + LEAF_SIZE, cells_x);
+				const int end_z = MIN(start_z + LEAF_SIZE, cells_z);
+
+				Range &range = leaves.ranges[(leaf_z * leaves.width) + leaf_x];
+				range.min_height = _get_height(start_x, start_z);
+				range.max_height = range.min_height;
+				for (int z = start_z; z <= end_z; z++) {
+					for (int x = start_x; x <= end_x; x++) {
+						real_t h = _get_height(x, z);
+						range.min_height = MIN(range.min_height, h);
+						range.max_height = MAX(range.max_height, h);
+					}
+				}
+			}
+		}
+	}
+
+	while ((levels[levels.size() - 1].width > 1) || (levels[levels.size() - 1].depth > 1)) {
+		levels.resize(levels.size() + 1);
+		const Level &children = levels[levels.size() - 2];
+		Level &level = levels[levels.size() - 1];
+		level.width = (children.width + 1) >> 1;
+		level.depth = (children.depth + 1) >> 1;
+		level.ranges.resize(level.width * level.depth);
+
+		for (int z = 0; z < level.depth; z++) {
+			for (int x = 0; x < level.width; x++) {
+				Range &range = level.ranges[(z * level.width) + x];
+				range = children.ranges[((z << 1) * children.width) + (x << 1)];
+				for (int i = 1; i < 4; i++) {
+					const int child_x = (x << 1) + (i & 1);
+					const int child_z = (z << 1) + (i >> 1);
+					if ((child_x < children.width) && (child_z < children.depth)) {
+						const Range &child = children.ranges[(child_z * children.width) + child_x];
+						range.min_height = MIN(range.min_height, child.min_height);
+						range.max_height = MAX(range.max_height, child.max_height);
+					}
+				}
+			}
+		}
+	}
+}
+
+void HeightMapShape3DSW::_setup(int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
 	width = p_width;
 	depth = p_depth;
 
+	_build_levels();
+
 	// Initialize aabb.
 	AABB aabb;
 	aabb.position = Vector3(0.0, p_min_height, 0.0);
@@ -1965,40 +2214,51 @@ void HeightMapShape3DSW::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(width <= 0.0);
 	ERR_FAIL_COND(depth <= 0.0);
 
+	// Heights are stored as 16-bit values relative to per-tile ranges when compressed.
+	bool use_compression = d.has("compressed") && bool(d["compressed"]);
+
+	// Heights are read straight from the source buffer, so no intermediate float array is needed
+	// when building compressed data from an image.
 	Variant heights_variant = d["heights"];
 	Vector<float> heights_buffer;
+	PackedByteArray im_data;
+	const uint8_t *heights_data = nullptr;
+	bool heights_half = false;
+	int heights_size = 0;
+
 	if (heights_variant.get_type() == Variant::PACKED_FLOAT32_ARRAY) {
 		// Ready-to-use heights can be passed.
 		heights_buffer = heights_variant;
+		heights_data = (const uint8_t *)heights_buffer.ptr();
+		heights_size = heights_buffer.size();
 	} else if (heights_variant.get_type() == Variant::OBJECT) {
 		// If an image is passed, we have to convert it.
 		// This would be expensive to do with a script, so it's nice to have it here.
 		Ref<Image> image = heights_variant;
 		ERR_FAIL_COND(image.is_null());
-		ERR_FAIL_COND(image->get_format() != Image::FORMAT_RF);
-
-		PackedByteArray im_data = image->get_data();
-		heights_buffer.resize(image->get_width() * image->get_height());
+		ERR_FAIL_COND(image->get_format() != Image::FORMAT_RF && image->get_format() != Image::FORMAT_RH);
 
-		float *w = heights_buffer.ptrw();
-		float *rp = (float *)im_data.ptr();
-		for (int i = 0; i < heights_buffer.size(); ++i) {
-			w[i] = rp[i];
-		}
+		im_data = image->get_data();
+		heights_data = im_data.ptr();
+		heights_half = image->get_format() == Image::FORMAT_RH;
+		heights_size = image->get_width() * image->get_height();
 	} else {
 		ERR_FAIL_MSG("Expected PackedFloat32Array or float Image.");
 	}
 
+	ERR_FAIL_COND(heights_size != (width * depth));
+
 	// Compute min and max heights or use precomputed values.
 	real_t min_height = 0.0;
 	real_t max_height = 0.0;
 	if (d.has("min_height") && d.has("max_height")) {
 		min_height = d["min_height"];
 		max_height = d["max_height"];
-	} else {
-		int heights_size = heights.size();
-		for (int i = 0; i < heights_size; ++i) {
-			float h = heights[i];
+	} else if (heights_size > 0) {
+		min_height = _heightmap_fetch(heights_data, heights_half, 0);
+		max_height = min_height;
+		for (int i = 1; i < heights_size; ++i) {
+			real_t h = _heightmap_fetch(heights_data, heights_half, i);
 			if (h < min_height) {
 				min_height = h;
 			} else if (h > max_height) {
@@ -2009,10 +2269,20 @@ void HeightMapShape3DSW::set_data(const Variant &p_data) {
 
 	ERR_FAIL_COND(min_height > max_height);
 
-	ERR_FAIL_COND(heights_buffer.size() != (width * depth));
+	if (use_compression) {
+		_store_compressed_heights(heights_data, heights_half, width, depth);
+	} else if (!heights_buffer.is_empty()) {
+		compressed = false;
+		quantized_heights.clear();
+		tiles.clear();
+		tiles_width = 0;
+		heights = heights_buffer;
+	} else {
+		_store_heights(heights_data, heights_half, width, depth);
+	}
 
 	// If specified, min and max height will be used as precomputed values.
-	_setup(heights_buffer, width, depth, min_height, max_height);
+	_setup(width, depth, min_height, max_height);
 }
 
 Variant HeightMapShape3DSW::get_data() const {
@@ -2024,7 +2294,8 @@ Variant HeightMapShape3DSW::get_data() const {
 	d["min_height"] = aabb.position.y;
 	d["max_height"] = aabb.position.y + aabb.size.y;
 
-	d["heights"] = heights;
+	d["heights"] = get_heights();
+	d["compressed"] = compressed;
 
 	return d;
 }
@@ -32,6 +32,7 @@
 #define SHAPE_SW_H
 
 #include "core/math/geometry_3d.h"
+#include "core/templates/local_vector.h"
 #include "servers/physics_server_3d.h"
 /*
 
@@ -388,13 +389,54 @@ public:
 	ConcavePolygonShape3DSW();
 };
 
+struct _HeightmapSegmentCullParams;
+struct _HeightmapCullParams;
+
 struct HeightMapShape3DSW : public ConcaveShape3DSW {
+	enum {
+		// Heights are quantized to 16 bits relative to the min/max of the tile they belong to.
+		TILE_SHIFT = 4,
+		TILE_SIZE = 1 << TILE_SHIFT,
+		// Number of cells per side covered by a leaf of the min/max quadtree.
+		LEAF_SHIFT = 3,
+		LEAF_SIZE = 1 << LEAF_SHIFT,
+	};
+
+	struct Tile {
+		float min_height = 0.0;
+		float scale = 0.0;
+	};
+
+	struct Range {
+		float min_height = 0.0;
+		float max_height = 0.0;
+	};
+
+	struct Level {
+		int width = 0;
+		int depth = 0;
+		LocalVector<Range> ranges;
+	};
+
 	Vector<float> heights;
+
+	bool compressed = false;
+	Vector<uint16_t> quantized_heights;
+	LocalVector<Tile> tiles;
+	int tiles_width = 0;
+
+	// Min/max quadtree, level 0 holds the leaves and the last level the root.
+	LocalVector<Level> levels;
+
 	int width = 0;
 	int depth = 0;
 	Vector3 local_origin;
 
-	_FORCE_INLINE_ float _get_height(int p_x, int p_z) const {
+	_FORCE_INLINE_ real_t _get_height(int p_x, int p_z) const {
+		if (compressed) {
+			const Tile &tile = tiles[(p_z >> TILE_SHIFT) * tiles_width + (p_x >> TILE_SHIFT)];
+			return tile.min_height + quantized_heights[(p_z * width) + p_x] * tile.scale;
+		}
 		return heights[(p_z * width) + p_x];
 	}
 
@@ -404,14 +446,27 @@ struct HeightMapShape3DSW : public ConcaveShape3DSW {
 		r_point.z = p_z - 0.5 * (depth - 1.0);
 	}
 
+	_FORCE_INLINE_ bool _is_empty() const {
+		return compressed ? quantized_heights.is_empty() : heights.is_empty();
+	}
+
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
+	void _get_node_aabb(int p_level, int p_x, int p_z, AABB &r_aabb) const;
+
+	bool _intersect_segment_node(int p_level, int p_x, int p_z, _HeightmapSegmentCullParams &p_params) const;
+	void _cull_node(int p_level, int p_x, int p_z, _HeightmapCullParams &p_params) const;
+
+	void _store_heights(const uint8_t *p_data, bool p_half, int p_width, int p_depth);
+	void _store_compressed_heights(const uint8_t *p_data, bool p_half, int p_width, int p_depth);
+	void _build_levels();
 
-	void _setup(const Vector<float> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
+	void _setup(int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
 
 public:
 	Vector<float> get_heights() const;
 	int get_width() const;
 	int get_depth() const;
+	bool is_compressed() const;
 
 	virtual PhysicsServer3D::ShapeType get_type() const { return PhysicsServer3D::SHAPE_HEIGHTMAP; }
 
@@ -34,6 +34,13 @@
 #include "core/math/geometry_3d.h"
 #include "core/templates/map.h"
 
+// Amount of nodes, links or faces processed by a single work item.
+#define SOFT_BODY_CHUNK_SIZE 256
+// Below this amount of elements, the work is done on the calling thread.
+#define SOFT_BODY_THREAD_THRESHOLD 2048
+// Links that can't be assigned one of these colors are solved serially.
+#define SOFT_BODY_MAX_LINK_COLORS 64
+
 // Based on Bullet soft body.
 
 /*
@@ -58,6 +65,23 @@ SoftBody3DSW::SoftBody3DSW() :
 	_set_static(false);
 }
 
+void SoftBody3DSW::NodeData::resize(uint32_t p_size) {
+	x.resize(p_size);
+	q.resize(p_size);
+	f.resize(p_size);
+	v.resize(p_size);
+	bv.resize(p_size);
+	n.resize(p_size);
+	area.resize(p_size);
+	im.resize(p_size);
+	leaf.resize(p_size);
+	index.resize(p_size);
+}
+
+void SoftBody3DSW::NodeData::clear() {
+	resize(0);
+}
+
 void SoftBody3DSW::_shapes_changed() {
 }
 
@@ -152,41 +176,94 @@ void SoftBody3DSW::update_rendering_server(RenderingServerHandler *p_rendering_s
 	}
 
 	const uint32_t vertex_count = map_visual_to_physics.size();
-	for (uint32_t i = 0; i < vertex_count; ++i) {
-		const uint32_t node_index = map_visual_to_physics[i];
-		const Node &node = nodes[node_index];
-		const Vector3 &vertex_position = node.x;
-		const Vector3 &vertex_normal = node.n;
 
-		p_rendering_server_handler->set_vertex(i, &vertex_position);
-		p_rendering_server_handler->set_normal(i, &vertex_normal);
+	uint32_t stride = 0;
+	uint32_t offset_vertex = 0;
+	uint32_t offset_normal = 0;
+	uint8_t *write_buffer = p_rendering_server_handler->get_vertex_write_buffer(stride, offset_vertex, offset_normal);
+
+	if (write_buffer) {
+		// Write straight into the vertex buffer, without going through the handler per vertex.
+		const Vector3 *x = nodes.x.ptr();
+		const Vector3 *n = nodes.n.ptr();
+		for (uint32_t i = 0; i < vertex_count; ++i) {
+			const uint32_t node_index = map_visual_to_physics[i];
+			uint8_t *vertex_data = write_buffer + i * stride;
+
+			float *vertex_position = (float *)(vertex_data + offset_vertex);
+			vertex_position[0] = x[node_index].x;
+			vertex_position[1] = x[node_index].y;
+			vertex_position[2] = x[node_index].z;
+
+			float *vertex_normal = (float *)(vertex_data + offset_normal);
+			vertex_normal[0] = n[node_index].x;
+			vertex_normal[1] = n[node_index].y;
+			vertex_normal[2] = n[node_index].z;
+		}
+	} else {
+		for (uint32_t i = 0; i < vertex_count; ++i) {
+			const uint32_t node_index = map_visual_to_physics[i];
+			p_rendering_server_handler->set_vertex(i, &nodes.x[node_index]);
+			p_rendering_server_handler->set_normal(i, &nodes.n[node_index]);
+		}
 	}
 
 	p_rendering_server_handler->set_aabb(bounds);
 }
 
-void SoftBody3DSW::update_normals() {
-	uint32_t i, ni;
+void SoftBody3DSW::_update_face_normals(uint32_t p_chunk, SolveData *p_data) {
+	const uint32_t from = p_data->begin + p_chunk * SOFT_BODY_CHUNK_SIZE;
+	const uint32_t to = MIN(from + SOFT_BODY_CHUNK_SIZE, p_data->end);
 
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		nodes[i].n = Vector3();
-	}
-
-	for (i = 0, ni = faces.size(); i < ni; ++i) {
+	const Vector3 *x = nodes.x.ptr();
+	for (uint32_t i = from; i < to; ++i) {
 		Face &face = faces[i];
-		const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
-		face.n[0]->n += n;
-		face.n[1]->n += n;
-		face.n[2]->n += n;
-		face.normal = n;
+		const Vector3 &x0 = x[face.n[0]];
+		face.area_normal = vec3_cross(x0 - x[face.n[2]], x0 - x[face.n[1]]);
+		face.normal = face.area_normal;
 		face.normal.normalize();
 	}
+}
 
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		real_t len = node.n.length();
+void SoftBody3DSW::_update_node_normals(uint32_t p_chunk, SolveData *p_data) {
+	const uint32_t from = p_data->begin + p_chunk * SOFT_BODY_CHUNK_SIZE;
+	const uint32_t to = MIN(from + SOFT_BODY_CHUNK_SIZE, p_data->end);
+
+	Vector3 *n = nodes.n.ptr();
+	for (uint32_t i = from; i < to; ++i) {
+		// Gather from adjacent faces instead of scattering from faces to nodes,
+		// so nodes can be processed in parallel.
+		Vector3 normal;
+		for (uint32_t j = node_face_offsets[i], nj = node_face_offsets[i + 1]; j < nj; ++j) {
+			normal += faces[node_faces[j]].area_normal;
+		}
+		real_t len = normal.length();
 		if (len > CMP_EPSILON) {
-			node.n /= len;
+			normal /= len;
+		}
+		n[i] = normal;
+	}
+}
+
+void SoftBody3DSW::update_normals(ThreadWorkPool *p_work_pool) {
+	SolveData data;
+
+	data.end = faces.size();
+	_do_chunked_work(p_work_pool, &SoftBody3DSW::_update_face_normals, data);
+
+	data.end = nodes.size();
+	_do_chunked_work(p_work_pool, &SoftBody3DSW::_update_node_normals, data);
+}
+
+void SoftBody3DSW::_do_chunked_work(ThreadWorkPool *p_work_pool, void (SoftBody3DSW::*p_method)(uint32_t, SolveData *), SolveData &p_data) {
+	const uint32_t count = p_data.end - p_data.begin;
+	const uint32_t chunk_count = (count + SOFT_BODY_CHUNK_SIZE - 1) / SOFT_BODY_CHUNK_SIZE;
+
+	if (p_work_pool && count >= SOFT_BODY_THREAD_THRESHOLD) {
+		p_work_pool->do_work(chunk_count, this, p_method, &p_data);
+	} else {
+		for (uint32_t chunk = 0; chunk < chunk_count; ++chunk) {
+			(this->*p_method)(chunk, &p_data);
 		}
 	}
 }
@@ -203,19 +280,14 @@ void SoftBody3DSW::update_bounds() {
 		return;
 	}
 
-	bool first = true;
+	const Vector3 *x = nodes.x.ptr();
 	bool moved = false;
+	bounds.position = x[0];
 	for (uint32_t node_index = 0; node_index < nodes_count; ++node_index) {
-		const Node &node = nodes[node_index];
-		if (!prev_bounds.has_point(node.x)) {
+		if (!prev_bounds.has_point(x[node_index])) {
 			moved = true;
 		}
-		if (first) {
-			bounds.position = node.x;
-			first = false;
-		} else {
-			bounds.expand_to(node.x);
-		}
+		bounds.expand_to(x[node_index]);
 	}
 
 	if (get_space()) {
@@ -230,15 +302,15 @@ void SoftBody3DSW::update_constants() {
 }
 
 void SoftBody3DSW::update_area() {
-	int i, ni;
+	uint32_t i, ni;
 
 	// Face area.
 	for (i = 0, ni = faces.size(); i < ni; ++i) {
 		Face &face = faces[i];
 
-		const Vector3 &x0 = face.n[0]->x;
-		const Vector3 &x1 = face.n[1]->x;
-		const Vector3 &x2 = face.n[2]->x;
+		const Vector3 &x0 = nodes.x[face.n[0]];
+		const Vector3 &x1 = nodes.x[face.n[1]];
+		const Vector3 &x2 = nodes.x[face.n[2]];
 
 		const Vector3 a = x1 - x0;
 		const Vector3 b = x2 - x0;
@@ -247,36 +319,23 @@ void SoftBody3DSW::update_area() {
 	}
 
 	// Node area.
-	LocalVector<int> counts;
-	counts.resize(nodes.size());
-	memset(counts.ptr(), 0, counts.size() * sizeof(int));
-
 	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		nodes[i].area = 0.0;
-	}
-
-	for (i = 0, ni = faces.size(); i < ni; ++i) {
-		const Face &face = faces[i];
-		for (int j = 0; j < 3; ++j) {
-			const int index = (int)(face.n[j] - &nodes[0]);
-			counts[index]++;
-			face.n[j]->area += Math::abs(face.ra);
-		}
-	}
-
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		if (counts[i] > 0) {
-			nodes[i].area /= (real_t)counts[i];
-		} else {
-			nodes[i].area = 0.0;
+		const uint32_t face_count = node_face_offsets[i + 1] - node_face_offsets[i];
+		real_t area = 0.0;
+		if (face_count > 0) {
+			for (uint32_t j = node_face_offsets[i]; j < node_face_offsets[i + 1]; ++j) {
+				area += Math::abs(faces[node_faces[j]].ra);
+			}
+			area /= (real_t)face_count;
 		}
+		nodes.area[i] = area;
 	}
 }
 
 void SoftBody3DSW::reset_link_rest_lengths() {
 	for (uint32_t i = 0, ni = links.size(); i < ni; ++i) {
 		Link &link = links[i];
-		link.rl = (link.n[0]->x - link.n[1]->x).length();
+		link.rl = (nodes.x[link.n[0]] - nodes.x[link.n[1]]).length();
 		link.c1 = link.rl * link.rl;
 	}
 }
@@ -285,7 +344,7 @@ void SoftBody3DSW::update_link_constants() {
 	real_t inv_linear_stiffness = 1.0 / linear_stiffness;
 	for (uint32_t i = 0, ni = links.size(); i < ni; ++i) {
 		Link &link = links[i];
-		link.c0 = (link.n[0]->im + link.n[1]->im) * inv_linear_stiffness;
+		link.c0 = (nodes.im[link.n[0]] + nodes.im[link.n[1]]) * inv_linear_stiffness;
 	}
 }
 
@@ -297,15 +356,15 @@ void SoftBody3DSW::apply_nodes_transform(const Transform3D &p_transform) {
 	uint32_t node_count = nodes.size();
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
+		Vector3 &x = nodes.x[node_index];
 
-		node.x = p_transform.xform(node.x);
-		node.q = node.x;
-		node.v = Vector3();
-		node.bv = Vector3();
+		x = p_transform.xform(x);
+		nodes.q[node_index] = x;
+		nodes.v[node_index] = Vector3();
+		nodes.bv[node_index] = Vector3();
 
-		AABB node_aabb(node.x, leaf_size);
-		node_tree.update(node.leaf, node_aabb);
+		AABB node_aabb(x, leaf_size);
+		node_tree.update(nodes.leaf[node_index], node_aabb);
 	}
 
 	face_tree.clear();
@@ -324,7 +383,7 @@ Vector3 SoftBody3DSW::get_vertex_position(int p_index) const {
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND_V(node_index >= nodes.size(), Vector3());
-	return nodes[node_index].x;
+	return nodes.x[node_index];
 }
 
 void SoftBody3DSW::set_vertex_position(int p_index, const Vector3 &p_position) {
@@ -336,9 +395,8 @@ void SoftBody3DSW::set_vertex_position(int p_index, const Vector3 &p_position) {
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND(node_index >= nodes.size());
-	Node &node = nodes[node_index];
-	node.q = node.x;
-	node.x = p_position;
+	nodes.q[node_index] = nodes.x[node_index];
+	nodes.x[node_index] = p_position;
 }
 
 void SoftBody3DSW::pin_vertex(int p_index) {
@@ -353,8 +411,7 @@ void SoftBody3DSW::pin_vertex(int p_index) {
 		uint32_t node_index = map_visual_to_physics[p_index];
 
 		ERR_FAIL_COND(node_index >= nodes.size());
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		nodes.im[node_index] = 0.0;
 	}
 }
 
@@ -371,8 +428,7 @@ void SoftBody3DSW::unpin_vertex(int p_index) {
 				ERR_FAIL_COND(node_index >= nodes.size());
 				real_t inv_node_mass = nodes.size() * inv_total_mass;
 
-				Node &node = nodes[node_index];
-				node.im = inv_node_mass;
+				nodes.im[node_index] = inv_node_mass;
 			}
 
 			return;
@@ -391,8 +447,7 @@ void SoftBody3DSW::unpin_all_vertices() {
 			uint32_t node_index = map_visual_to_physics[vertex_index];
 
 			ERR_CONTINUE(node_index >= nodes.size());
-			Node &node = nodes[node_index];
-			node.im = inv_node_mass;
+			nodes.im[node_index] = inv_node_mass;
 		}
 	}
 
@@ -416,34 +471,32 @@ uint32_t SoftBody3DSW::get_node_count() const {
 
 real_t SoftBody3DSW::get_node_inv_mass(uint32_t p_node_index) const {
 	ERR_FAIL_COND_V(p_node_index >= nodes.size(), 0.0);
-	return nodes[p_node_index].im;
+	return nodes.im[p_node_index];
 }
 
 Vector3 SoftBody3DSW::get_node_position(uint32_t p_node_index) const {
 	ERR_FAIL_COND_V(p_node_index >= nodes.size(), Vector3());
-	return nodes[p_node_index].x;
+	return nodes.x[p_node_index];
 }
 
 Vector3 SoftBody3DSW::get_node_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_COND_V(p_node_index >= nodes.size(), Vector3());
-	return nodes[p_node_index].v;
+	return nodes.v[p_node_index];
 }
 
 Vector3 SoftBody3DSW::get_node_biased_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_COND_V(p_node_index >= nodes.size(), Vector3());
-	return nodes[p_node_index].bv;
+	return nodes.bv[p_node_index];
 }
 
 void SoftBody3DSW::apply_node_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_COND(p_node_index >= nodes.size());
-	Node &node = nodes[p_node_index];
-	node.v += p_impulse * node.im;
+	nodes.v[p_node_index] += p_impulse * nodes.im[p_node_index];
 }
 
 void SoftBody3DSW::apply_node_bias_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_COND(p_node_index >= nodes.size());
-	Node &node = nodes[p_node_index];
-	node.bv += p_impulse * node.im;
+	nodes.bv[p_node_index] += p_impulse * nodes.im[p_node_index];
 }
 
 uint32_t SoftBody3DSW::get_face_count() const {
@@ -453,9 +506,9 @@ uint32_t SoftBody3DSW::get_face_count() const {
 void SoftBody3DSW::get_face_points(uint32_t p_face_index, Vector3 &r_point_1, Vector3 &r_point_2, Vector3 &r_point_3) const {
 	ERR_FAIL_COND(p_face_index >= faces.size());
 	const Face &face = faces[p_face_index];
-	r_point_1 = face.n[0]->x;
-	r_point_2 = face.n[1]->x;
-	r_point_3 = face.n[2]->x;
+	r_point_1 = nodes.x[face.n[0]];
+	r_point_2 = nodes.x[face.n[1]];
+	r_point_3 = nodes.x[face.n[2]];
 }
 
 Vector3 SoftBody3DSW::get_face_normal(uint32_t p_face_index) const {
@@ -523,16 +576,14 @@ bool SoftBody3DSW::create_from_trimesh(const Vector<int> &p_indices, const Vecto
 	real_t inv_node_mass = node_count * inv_total_mass;
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t i = 0; i < node_count; ++i) {
-		Node &node = nodes[i];
-		node.s = vertices[i];
-		node.x = node.s;
-		node.q = node.s;
-		node.im = inv_node_mass;
-
-		AABB node_aabb(node.x, leaf_size);
-		node.leaf = node_tree.insert(node_aabb, &node);
-
-		node.index = i;
+		nodes.x[i] = vertices[i];
+		nodes.q[i] = vertices[i];
+		nodes.area[i] = 0.0;
+		nodes.im[i] = inv_node_mass;
+		nodes.index[i] = i;
+
+		AABB node_aabb(vertices[i], leaf_size);
+		nodes.leaf[i] = node_tree.insert(node_aabb, &nodes.index[i]);
 	}
 
 	// Create links and faces from triangles.
@@ -566,12 +617,12 @@ bool SoftBody3DSW::create_from_trimesh(const Vector<int> &p_indices, const Vecto
 		uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 		ERR_CONTINUE(node_index >= node_count);
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		nodes.im[node_index] = 0.0;
 	}
 
 	generate_bending_constraints(2);
-	reoptimize_link_order();
+	color_links();
+	build_node_face_adjacency();
 
 	update_constants();
 	update_normals();
@@ -603,8 +654,8 @@ void SoftBody3DSW::generate_bending_constraints(int p_distance) {
 			}
 		}
 		for (i = 0; i < links.size(); ++i) {
-			const int ia = (int)(links[i].n[0] - &nodes[0]);
-			const int ib = (int)(links[i].n[1] - &nodes[0]);
+			const int ia = links[i].n[0];
+			const int ib = links[i].n[1];
 			int idx = ib * n + ia;
 			int idx_inv = ia * n + ib;
 			adj[idx] = 1;
@@ -619,8 +670,8 @@ void SoftBody3DSW::generate_bending_constraints(int p_distance) {
 			node_links.resize(nodes.size());
 
 			for (i = 0; i < links.size(); ++i) {
-				const int ia = (int)(links[i].n[0] - &nodes[0]);
-				const int ib = (int)(links[i].n[1] - &nodes[0]);
+				const int ia = links[i].n[0];
+				const int ib = links[i].n[1];
 				if (node_links[ia].find(ib) == -1) {
 					node_links[ia].push_back(ib);
 				}
@@ -679,133 +730,85 @@ void SoftBody3DSW::generate_bending_constraints(int p_distance) {
 	}
 }
 
-//===================================================================
-//
-//
-// This function takes in a list of interdependent Links and tries
-// to maximize the distance between calculation
-// of dependent links. This increases the amount of parallelism that can
-// be exploited by out-of-order instruction processors with large but
-// (inevitably) finite instruction windows.
-//
-//===================================================================
-
-// A small structure to track lists of dependent link calculations.
-class LinkDeps {
-public:
-	int value; // A link calculation that is dependent on this one
-			// Positive values = "input A" while negative values = "input B"
-	LinkDeps *next; // Next dependence in the list
-};
-typedef LinkDeps *LinkDepsPtr;
-
-void SoftBody3DSW::reoptimize_link_order() {
-	const int reop_not_dependent = -1;
-	const int reop_node_complete = -2;
-
-	uint32_t i, link_count = links.size(), node_count = nodes.size();
-	Link *lr;
-	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
-	LinkDepsPtr link_dep;
-	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
-
-	// Allocate temporary buffers.
-	int *node_written_at = memnew_arr(int, node_count + 1); // What link calculation produced this node's current values?
-	int *link_dep_A = memnew_arr(int, link_count); // Link calculation input is dependent upon prior calculation #N
-	int *link_dep_B = memnew_arr(int, link_count);
-	int *ready_list = memnew_arr(int, link_count); // List of ready-to-process link calculations (# of links, maximum)
-	LinkDeps *link_dep_free_list = memnew_arr(LinkDeps, 2 * link_count); // Dependent-on-me list elements (2x# of links, maximum)
-	LinkDepsPtr *link_dep_list_starts = memnew_arr(LinkDepsPtr, link_count); // Start nodes of dependent-on-me lists, one for each link
-
-	// Copy the original, unsorted links to a side buffer.
-	Link *link_buffer = memnew_arr(Link, link_count);
-	memcpy(link_buffer, &(links[0]), sizeof(Link) * link_count);
-
-	// Clear out the node setup and ready list.
-	for (i = 0; i < node_count + 1; i++) {
-		node_written_at[i] = reop_not_dependent;
-	}
-	for (i = 0; i < link_count; i++) {
-		link_dep_list_starts[i] = nullptr;
-	}
-	ready_list_head = ready_list_tail = link_dep_frees = 0;
-
-	// Initial link analysis to set up data structures.
-	for (i = 0; i < link_count; i++) {
-		// Note which prior link calculations we are dependent upon & build up dependence lists.
-		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
-		if (node_written_at[ar] > reop_not_dependent) {
-			link_dep_A[i] = node_written_at[ar];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = i;
-			link_dep->next = link_dep_list_starts[node_written_at[ar]];
-			link_dep_list_starts[node_written_at[ar]] = link_dep;
-		} else {
-			link_dep_A[i] = reop_not_dependent;
-		}
-		if (node_written_at[br] > reop_not_dependent) {
-			link_dep_B[i] = node_written_at[br];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = -(int)(i + 1);
-			link_dep->next = link_dep_list_starts[node_written_at[br]];
-			link_dep_list_starts[node_written_at[br]] = link_dep;
-		} else {
-			link_dep_B[i] = reop_not_dependent;
+void SoftBody3DSW::color_links() {
+	// Greedy graph coloring: each link gets the lowest color not used yet by any
+	// other link sharing one of its nodes. Links of the same color are independent
+	// and can be solved concurrently, while colors are solved one after the other.
+	const uint32_t link_count = links.size();
+
+	LocalVector<uint64_t> node_colors;
+	node_colors.resize(nodes.size());
+	memset(node_colors.ptr(), 0, node_colors.size() * sizeof(uint64_t));
+
+	LocalVector<uint32_t> link_colors;
+	link_colors.resize(link_count);
+
+	uint32_t color_count = 0;
+	for (uint32_t i = 0; i < link_count; ++i) {
+		const Link &link = links[i];
+		const uint64_t used_colors = node_colors[link.n[0]] | node_colors[link.n[1]];
+
+		uint32_t color = 0;
+		while (color < SOFT_BODY_MAX_LINK_COLORS && (used_colors & (uint64_t(1) << color))) {
+			++color;
 		}
 
-		// Add this link to the initial ready list, if it is not dependent on any other links.
-		if ((link_dep_A[i] == reop_not_dependent) && (link_dep_B[i] == reop_not_dependent)) {
-			ready_list[ready_list_tail++] = i;
-			link_dep_A[i] = link_dep_B[i] = reop_node_complete; // Probably not needed now.
+		if (color < SOFT_BODY_MAX_LINK_COLORS) {
+			node_colors[link.n[0]] |= uint64_t(1) << color;
+			node_colors[link.n[1]] |= uint64_t(1) << color;
 		}
 
-		// Update the nodes to mark which ones are calculated by this link.
-		node_written_at[ar] = node_written_at[br] = i;
-	}
-
-	// Process the ready list and create the sorted list of links:
-	// -- By treating the ready list as a queue, we maximize the distance between any
-	//    inter-dependent node calculations.
-	// -- All other (non-related) nodes in the ready list will automatically be inserted
-	//    in between each set of inter-dependent link calculations by this loop.
-	i = 0;
-	while (ready_list_head != ready_list_tail) {
-		// Use ready list to select the next link to process.
-		link_num = ready_list[ready_list_head++];
-		// Copy the next-to-calculate link back into the original link array.
-		links[i++] = link_buffer[link_num];
-
-		// Free up any link inputs that are dependent on this one.
-		link_dep = link_dep_list_starts[link_num];
-		while (link_dep) {
-			dep_link = link_dep->value;
-			if (dep_link >= 0) {
-				link_dep_A[dep_link] = reop_not_dependent;
-			} else {
-				dep_link = -dep_link - 1;
-				link_dep_B[dep_link] = reop_not_dependent;
-			}
-			// Add this dependent link calculation to the ready list if *both* inputs are clear.
-			if ((link_dep_A[dep_link] == reop_not_dependent) && (link_dep_B[dep_link] == reop_not_dependent)) {
-				ready_list[ready_list_tail++] = dep_link;
-				link_dep_A[dep_link] = link_dep_B[dep_link] = reop_node_complete; // Probably not needed now.
-			}
-			link_dep = link_dep->next;
+		// Links that couldn't be colored all end up in the last group, which is solved serially.
+		link_colors[i] = color;
+		color_count = MAX(color_count, color + 1);
+	}
+
+	// Sort links by color.
+	link_color_offsets.resize(color_count + 1);
+	memset(link_color_offsets.ptr(), 0, link_color_offsets.size() * sizeof(uint32_t));
+	for (uint32_t i = 0; i < link_count; ++i) {
+		link_color_offsets[link_colors[i] + 1]++;
+	}
+	for (uint32_t i = 0; i < color_count; ++i) {
+		link_color_offsets[i + 1] += link_color_offsets[i];
+	}
+
+	LocalVector<uint32_t> insert_offsets = link_color_offsets;
+	LocalVector<Link> sorted_links;
+	sorted_links.resize(link_count);
+	for (uint32_t i = 0; i < link_count; ++i) {
+		sorted_links[insert_offsets[link_colors[i]]++] = links[i];
+	}
+
+	links = sorted_links;
+}
+
+void SoftBody3DSW::build_node_face_adjacency() {
+	const uint32_t node_count = nodes.size();
+	const uint32_t face_count = faces.size();
+
+	node_face_offsets.resize(node_count + 1);
+	memset(node_face_offsets.ptr(), 0, node_face_offsets.size() * sizeof(uint32_t));
+
+	for (uint32_t i = 0; i < face_count; ++i) {
+		const Face &face = faces[i];
+		for (int j = 0; j < 3; ++j) {
+			node_face_offsets[face.n[j] + 1]++;
 		}
 	}
+	for (uint32_t i = 0; i < node_count; ++i) {
+		node_face_offsets[i + 1] += node_face_offsets[i];
+	}
 
-	// Delete the temporary buffers.
-	memdelete_arr(node_written_at);
-	memdelete_arr(link_dep_A);
-	memdelete_arr(link_dep_B);
-	memdelete_arr(ready_list);
-	memdelete_arr(link_dep_free_list);
-	memdelete_arr(link_dep_list_starts);
-	memdelete_arr(link_buffer);
+	// Faces are added in order, so normals are accumulated in the same order as a serial pass would.
+	LocalVector<uint32_t> insert_offsets = node_face_offsets;
+	node_faces.resize(face_count * 3);
+	for (uint32_t i = 0; i < face_count; ++i) {
+		const Face &face = faces[i];
+		for (int j = 0; j < 3; ++j) {
+			node_faces[insert_offsets[face.n[j]]++] = i;
+		}
+	}
 }
 
 void SoftBody3DSW::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -813,13 +816,10 @@ void SoftBody3DSW::append_link(uint32_t p_node1, uint32_t p_node2) {
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-
 	Link link;
-	link.n[0] = node1;
-	link.n[1] = node2;
-	link.rl = (node1->x - node2->x).length();
+	link.n[0] = p_node1;
+	link.n[1] = p_node2;
+	link.rl = (nodes.x[p_node1] - nodes.x[p_node2]).length();
 
 	links.push_back(link);
 }
@@ -835,14 +835,10 @@ void SoftBody3DSW::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_no
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-	Node *node3 = &nodes[p_node3];
-
 	Face face;
-	face.n[0] = node1;
-	face.n[1] = node2;
-	face.n[2] = node3;
+	face.n[0] = p_node1;
+	face.n[1] = p_node2;
+	face.n[2] = p_node3;
 
 	face.index = faces.size();
 
@@ -862,8 +858,7 @@ void SoftBody3DSW::set_total_mass(real_t p_val) {
 
 	uint32_t node_count = nodes.size();
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
-		node.im *= mass_factor;
+		nodes.im[node_index] *= mass_factor;
 	}
 
 	update_constants();
@@ -890,10 +885,11 @@ void SoftBody3DSW::set_drag_coefficient(real_t p_val) {
 }
 
 void SoftBody3DSW::add_velocity(const Vector3 &p_velocity) {
+	const real_t *im = nodes.im.ptr();
+	Vector3 *v = nodes.v.ptr();
 	for (uint32_t i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		if (node.im > 0) {
-			node.v += p_velocity;
+		if (im[i] > 0) {
+			v[i] += p_velocity;
 		}
 	}
 }
@@ -908,27 +904,56 @@ void SoftBody3DSW::apply_forces() {
 	}
 
 	uint32_t i, ni;
+	const Vector3 *x = nodes.x.ptr();
 
 	// Calculate volume.
 	real_t volume = 0.0;
-	const Vector3 &org = nodes[0].x;
+	const Vector3 &org = x[0];
 	for (i = 0, ni = faces.size(); i < ni; ++i) {
 		const Face &face = faces[i];
-		volume += vec3_dot(face.n[0]->x - org, vec3_cross(face.n[1]->x - org, face.n[2]->x - org));
+		volume += vec3_dot(x[face.n[0]] - org, vec3_cross(x[face.n[1]] - org, x[face.n[2]] - org));
 	}
 	volume /= 6.0;
 
 	// Apply per node forces.
 	real_t ivolumetp = 1.0 / Math::abs(volume) * pressure_coefficient;
+	const real_t *im = nodes.im.ptr();
+	const real_t *area = nodes.area.ptr();
+	const Vector3 *n = nodes.n.ptr();
+	Vector3 *f = nodes.f.ptr();
 	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		if (node.im > 0) {
-			node.f += node.n * (node.area * ivolumetp);
+		if (im[i] > 0) {
+			f[i] += n[i] * (area[i] * ivolumetp);
 		}
 	}
 }
 
-void SoftBody3DSW::predict_motion(real_t p_delta) {
+void SoftBody3DSW::_integrate_nodes(uint32_t p_chunk, SolveData *p_data) {
+	const uint32_t from = p_data->begin + p_chunk * SOFT_BODY_CHUNK_SIZE;
+	const uint32_t to = MIN(from + SOFT_BODY_CHUNK_SIZE, p_data->end);
+
+	const real_t delta = p_data->delta;
+	const real_t clamp_delta_v = p_data->clamp_delta_v;
+
+	const real_t *im = nodes.im.ptr();
+	Vector3 *x = nodes.x.ptr();
+	Vector3 *q = nodes.q.ptr();
+	Vector3 *f = nodes.f.ptr();
+	Vector3 *v = nodes.v.ptr();
+
+	for (uint32_t i = from; i < to; ++i) {
+		q[i] = x[i];
+		Vector3 delta_v = f[i] * im[i] * delta;
+		for (int c = 0; c < 3; c++) {
+			delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
+		}
+		v[i] += delta_v;
+		x[i] += v[i] * delta;
+		f[i] = Vector3();
+	}
+}
+
+void SoftBody3DSW::predict_motion(real_t p_delta, ThreadWorkPool &p_work_pool) {
 	const real_t inv_delta = 1.0 / p_delta;
 
 	ERR_FAIL_COND(!get_space());
@@ -944,34 +969,26 @@ void SoftBody3DSW::predict_motion(real_t p_delta) {
 	// Avoid soft body from 'exploding' so use some upper threshold of maximum motion
 	// that a node can travel per frame.
 	const real_t max_displacement = 1000.0;
-	real_t clamp_delta_v = max_displacement * inv_delta;
 
 	// Integrate.
-	uint32_t i, ni;
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		node.q = node.x;
-		Vector3 delta_v = node.f * node.im * p_delta;
-		for (int c = 0; c < 3; c++) {
-			delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
-		}
-		node.v += delta_v;
-		node.x += node.v * p_delta;
-		node.f = Vector3();
-	}
+	SolveData data;
+	data.delta = p_delta;
+	data.clamp_delta_v = max_displacement * inv_delta;
+	data.end = nodes.size();
+	_do_chunked_work(&p_work_pool, &SoftBody3DSW::_integrate_nodes, data);
 
 	// Bounds and tree update.
 	update_bounds();
 
 	// Node tree update.
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		const Node &node = nodes[i];
-
-		AABB node_aabb(node.x, Vector3());
-		node_aabb.expand_to(node.x + node.v * p_delta);
+	const Vector3 *x = nodes.x.ptr();
+	const Vector3 *v = nodes.v.ptr();
+	for (uint32_t i = 0, ni = nodes.size(); i < ni; ++i) {
+		AABB node_aabb(x[i], Vector3());
+		node_aabb.expand_to(x[i] + v[i] * p_delta);
 		node_aabb.grow_by(collision_margin);
 
-		node_tree.update(node.leaf, node_aabb);
+		node_tree.update(nodes.leaf[i], node_aabb);
 	}
 
 	// Face tree update.
@@ -984,60 +1001,96 @@ void SoftBody3DSW::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void SoftBody3DSW::solve_constraints(real_t p_delta) {
-	const real_t inv_delta = 1.0 / p_delta;
+void SoftBody3DSW::_update_velocity_chunk(uint32_t p_chunk, SolveData *p_data) {
+	const uint32_t from = p_data->begin + p_chunk * SOFT_BODY_CHUNK_SIZE;
+	const uint32_t to = MIN(from + SOFT_BODY_CHUNK_SIZE, p_data->end);
 
-	uint32_t i, ni;
+	const real_t delta = p_data->delta;
+	const real_t vc = p_data->vc;
 
-	for (i = 0, ni = links.size(); i < ni; ++i) {
-		Link &link = links[i];
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
+	Vector3 *x = nodes.x.ptr();
+	Vector3 *q = nodes.q.ptr();
+	Vector3 *v = nodes.v.ptr();
+	Vector3 *bv = nodes.bv.ptr();
+
+	for (uint32_t i = from; i < to; ++i) {
+		x[i] += bv[i] * delta;
+		bv[i] = Vector3();
+
+		v[i] = (x[i] - q[i]) * vc;
+
+		q[i] = x[i];
 	}
+}
+
+void SoftBody3DSW::solve_constraints(real_t p_delta, ThreadWorkPool &p_work_pool) {
+	const real_t inv_delta = 1.0 / p_delta;
 
 	// Solve velocities.
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		node.x = node.q + node.v * p_delta;
+	Vector3 *x = nodes.x.ptr();
+	const Vector3 *q = nodes.q.ptr();
+	const Vector3 *v = nodes.v.ptr();
+	for (uint32_t i = 0, ni = nodes.size(); i < ni; ++i) {
+		x[i] = q[i] + v[i] * p_delta;
 	}
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
-		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		solve_links(1.0, p_work_pool);
 	}
-	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
 
-		node.x += node.bv * p_delta;
-		node.bv = Vector3();
+	SolveData data;
+	data.delta = p_delta;
+	data.vc = (1.0 - damping_coefficient) * inv_delta;
+	data.end = nodes.size();
+	_do_chunked_work(&p_work_pool, &SoftBody3DSW::_update_velocity_chunk, data);
 
-		node.v = (node.x - node.q) * vc;
+	update_normals(&p_work_pool);
+}
 
-		node.q = node.x;
-	}
+void SoftBody3DSW::_solve_link_chunk(uint32_t p_chunk, SolveData *p_data) {
+	const uint32_t from = p_data->begin + p_chunk * SOFT_BODY_CHUNK_SIZE;
+	const uint32_t to = MIN(from + SOFT_BODY_CHUNK_SIZE, p_data->end);
 
-	update_normals();
-}
+	const real_t kst = p_data->kst;
+	const real_t *im = nodes.im.ptr();
+	Vector3 *x = nodes.x.ptr();
 
-void SoftBody3DSW::solve_links(real_t kst, real_t ti) {
-	for (uint32_t i = 0, ni = links.size(); i < ni; ++i) {
-		Link &link = links[i];
+	for (uint32_t i = from; i < to; ++i) {
+		const Link &link = links[i];
 		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
+			const uint32_t node_a = link.n[0];
+			const uint32_t node_b = link.n[1];
+			const Vector3 del = x[node_b] - x[node_a];
 			const real_t len = del.length_squared();
 			if (link.c1 + len > CMP_EPSILON) {
 				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+				x[node_a] -= del * (k * im[node_a]);
+				x[node_b] += del * (k * im[node_b]);
 			}
 		}
 	}
 }
 
+void SoftBody3DSW::solve_links(real_t kst, ThreadWorkPool &p_work_pool) {
+	if (link_color_offsets.is_empty()) {
+		return;
+	}
+
+	SolveData data;
+	data.kst = kst;
+
+	const uint32_t color_count = link_color_offsets.size() - 1;
+	for (uint32_t color = 0; color < color_count; ++color) {
+		data.begin = link_color_offsets[color];
+		data.end = link_color_offsets[color + 1];
+
+		// The last color can hold links sharing nodes if coloring overflowed, never split it.
+		const bool overflow = (color == SOFT_BODY_MAX_LINK_COLORS);
+		_do_chunked_work(overflow ? nullptr : &p_work_pool, &SoftBody3DSW::_solve_link_chunk, data);
+	}
+}
+
 struct AABBQueryResult {
 	const SoftBody3DSW *soft_body = nullptr;
 	void *userdata = nullptr;
@@ -1087,9 +1140,9 @@ void SoftBody3DSW::initialize_face_tree() {
 
 		AABB face_aabb;
 
-		face_aabb.position = face.n[0]->x;
-		face_aabb.expand_to(face.n[1]->x);
-		face_aabb.expand_to(face.n[2]->x);
+		face_aabb.position = nodes.x[face.n[0]];
+		face_aabb.expand_to(nodes.x[face.n[1]]);
+		face_aabb.expand_to(nodes.x[face.n[2]]);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1103,17 +1156,17 @@ void SoftBody3DSW::update_face_tree(real_t p_delta) {
 
 		AABB face_aabb;
 
-		const Node *node0 = face.n[0];
-		face_aabb.position = node0->x;
-		face_aabb.expand_to(node0->x + node0->v * p_delta);
+		const uint32_t node0 = face.n[0];
+		face_aabb.position = nodes.x[node0];
+		face_aabb.expand_to(nodes.x[node0] + nodes.v[node0] * p_delta);
 
-		const Node *node1 = face.n[1];
-		face_aabb.expand_to(node1->x);
-		face_aabb.expand_to(node1->x + node1->v * p_delta);
+		const uint32_t node1 = face.n[1];
+		face_aabb.expand_to(nodes.x[node1]);
+		face_aabb.expand_to(nodes.x[node1] + nodes.v[node1] * p_delta);
 
-		const Node *node2 = face.n[2];
-		face_aabb.expand_to(node2->x);
-		face_aabb.expand_to(node2->x + node2->v * p_delta);
+		const uint32_t node2 = face.n[2];
+		face_aabb.expand_to(nodes.x[node2]);
+		face_aabb.expand_to(nodes.x[node2] + nodes.v[node2] * p_delta);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1149,6 +1202,10 @@ void SoftBody3DSW::destroy() {
 	links.clear();
 	faces.clear();
 
+	link_color_offsets.clear();
+	node_face_offsets.clear();
+	node_faces.clear();
+
 	bounds = AABB();
 	deinitialize_shape();
 }
@@ -38,6 +38,7 @@
 #include "core/math/vector3.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/set.h"
+#include "core/templates/thread_work_pool.h"
 #include "core/templates/vset.h"
 #include "scene/resources/mesh.h"
 
@@ -46,41 +47,55 @@ class Constraint3DSW;
 class SoftBody3DSW : public CollisionObject3DSW {
 	Ref<Mesh> soft_mesh;
 
-	struct Node {
-		Vector3 s; // Source position
-		Vector3 x; // Position
-		Vector3 q; // Previous step position/Test position
-		Vector3 f; // Force accumulator
-		Vector3 v; // Velocity
-		Vector3 bv; // Biased Velocity
-		Vector3 n; // Normal
-		real_t area = 0.0; // Area
-		real_t im = 0.0; // 1/mass
-		DynamicBVH::ID leaf; // Leaf data
-		uint32_t index = 0;
+	// Node data is stored as a structure of arrays, so the solver loops only
+	// stream through the fields they actually use.
+	struct NodeData {
+		LocalVector<Vector3> x; // Position
+		LocalVector<Vector3> q; // Previous step position/Test position
+		LocalVector<Vector3> f; // Force accumulator
+		LocalVector<Vector3> v; // Velocity
+		LocalVector<Vector3> bv; // Biased Velocity
+		LocalVector<Vector3> n; // Normal
+		LocalVector<real_t> area; // Area
+		LocalVector<real_t> im; // 1/mass
+		LocalVector<DynamicBVH::ID> leaf; // Leaf data
+		LocalVector<uint32_t> index; // Node index, used as leaf userdata
+
+		_FORCE_INLINE_ uint32_t size() const { return x.size(); }
+		_FORCE_INLINE_ bool is_empty() const { return x.is_empty(); }
+		void resize(uint32_t p_size);
+		void clear();
 	};
 
 	struct Link {
-		Vector3 c3; // gradient
-		Node *n[2] = { nullptr, nullptr }; // Node pointers
+		uint32_t n[2] = { 0, 0 }; // Node indices
 		real_t rl = 0.0; // Rest length
 		real_t c0 = 0.0; // (ima+imb)*kLST
 		real_t c1 = 0.0; // rl^2
-		real_t c2 = 0.0; // |gradient|^2/c0
 	};
 
 	struct Face {
-		Node *n[3] = { nullptr, nullptr, nullptr }; // Node pointers
+		uint32_t n[3] = { 0, 0, 0 }; // Node indices
 		Vector3 normal; // Normal
+		Vector3 area_normal; // Non normalized normal, weighted by area
 		real_t ra = 0.0; // Rest area
 		DynamicBVH::ID leaf; // Leaf data
 		uint32_t index = 0;
 	};
 
-	LocalVector<Node> nodes;
+	NodeData nodes;
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	// Links are sorted by color, so that links of the same color never share a node
+	// and can be solved in parallel. Color i spans [link_color_offsets[i], link_color_offsets[i + 1]).
+	LocalVector<uint32_t> link_color_offsets;
+
+	// Faces adjacent to each node, stored contiguously: node i uses
+	// [node_face_offsets[i], node_face_offsets[i + 1]) in node_faces.
+	LocalVector<uint32_t> node_face_offsets;
+	LocalVector<uint32_t> node_faces;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
@@ -177,10 +192,10 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
-	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	void predict_motion(real_t p_delta, ThreadWorkPool &p_work_pool);
+	void solve_constraints(real_t p_delta, ThreadWorkPool &p_work_pool);
 
-	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return ((Node *)p_node)->index; }
+	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return *(uint32_t *)p_node; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return ((Face *)p_face)->index; }
 
 	// Return true to stop the query.
@@ -194,7 +209,24 @@ protected:
 	virtual void _shapes_changed();
 
 private:
-	void update_normals();
+	struct SolveData {
+		real_t delta = 0.0;
+		real_t kst = 1.0;
+		real_t vc = 0.0;
+		real_t clamp_delta_v = 0.0;
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	void _do_chunked_work(ThreadWorkPool *p_work_pool, void (SoftBody3DSW::*p_method)(uint32_t, SolveData *), SolveData &p_data);
+
+	void _integrate_nodes(uint32_t p_chunk, SolveData *p_data);
+	void _solve_link_chunk(uint32_t p_chunk, SolveData *p_data);
+	void _update_velocity_chunk(uint32_t p_chunk, SolveData *p_data);
+	void _update_face_normals(uint32_t p_chunk, SolveData *p_data);
+	void _update_node_normals(uint32_t p_chunk, SolveData *p_data);
+
+	void update_normals(ThreadWorkPool *p_work_pool = nullptr);
 	void update_bounds();
 	void update_constants();
 	void update_area();
@@ -209,11 +241,12 @@ private:
 
 	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
-	void reoptimize_link_order();
+	void color_links();
+	void build_node_face_adjacency();
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
-	void solve_links(real_t kst, real_t ti);
+	void solve_links(real_t kst, ThreadWorkPool &p_work_pool);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
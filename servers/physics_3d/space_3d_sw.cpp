@@ -1137,6 +1137,72 @@ void Space3DSW::body_remove_from_active_list(SelfList<Body3DSW> *p_body) {
 	active_list.remove(p_body);
 }
 
+void Space3DSW::create_sleeping_island(const LocalVector<Body3DSW *> &p_bodies) {
+	int island;
+	if (free_sleeping_islands.size()) {
+		island = free_sleeping_islands[free_sleeping_islands.size() - 1];
+		free_sleeping_islands.resize(free_sleeping_islands.size() - 1);
+	} else {
+		island = sleeping_islands.size();
+		sleeping_islands.resize(island + 1);
+	}
+
+	LocalVector<Body3DSW *> &island_bodies = sleeping_islands[island];
+	island_bodies.clear();
+	for (uint32_t i = 0; i < p_bodies.size(); i++) {
+		Body3DSW *body = p_bodies[i];
+		if (body->get_sleeping_island() != -1) {
+			body_remove_from_sleeping_island(body);
+		}
+		body->set_sleeping_island(island, island_bodies.size());
+		island_bodies.push_back(body);
+	}
+}
+
+void Space3DSW::wake_sleeping_island(int p_island) {
+	LocalVector<Body3DSW *> &island_bodies = sleeping_islands[p_island];
+
+	// Clear membership first, so activating the bodies doesn't wake the island again.
+	for (uint32_t i = 0; i < island_bodies.size(); i++) {
+		island_bodies[i]->set_sleeping_island(-1, 0);
+	}
+	for (uint32_t i = 0; i < island_bodies.size(); i++) {
+		island_bodies[i]->set_active(true);
+	}
+
+	island_bodies.clear();
+	free_sleeping_islands.push_back(p_island);
+}
+
+void Space3DSW::body_remove_from_sleeping_island(Body3DSW *p_body) {
+	int island = p_body->get_sleeping_island();
+	ERR_FAIL_COND(island == -1);
+
+	LocalVector<Body3DSW *> &island_bodies = sleeping_islands[island];
+	int index = p_body->get_sleeping_island_index();
+
+	Body3DSW *last = island_bodies[island_bodies.size() - 1];
+	island_bodies[index] = last;
+	last->set_sleeping_island(island, index);
+	island_bodies.resize(island_bodies.size() - 1);
+
+	p_body->set_sleeping_island(-1, 0);
+
+	if (island_bodies.is_empty()) {
+		free_sleeping_islands.push_back(island);
+	}
+}
+
+void Space3DSW::clear_sleeping_islands() {
+	for (uint32_t i = 0; i < sleeping_islands.size(); i++) {
+		for (uint32_t j = 0; j < sleeping_islands[i].size(); j++) {
+			sleeping_islands[i][j]->set_sleeping_island(-1, 0);
+		}
+	}
+	sleeping_islands.clear();
+	free_sleeping_islands.clear();
+}
+
 void Space3DSW::body_add_to_inertia_update_list(SelfList<Body3DSW> *p_body) {
 	inertia_update_list.add(p_body);
 }
@@ -1225,8 +1291,276 @@ void Space3DSW::setup() {
 	}
 }
 
-void Space3DSW::update() {
-	broadphase->update();
+void Space3DSW::update(ThreadWorkPool &p_work_pool) {
+	broadphase->update(p_work_pool);
+}
+
+Vector<uint8_t> Space3DSW::save_state(ThreadWorkPool &p_work_pool) {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Can't save the state of a space while it's being stepped.");
+
+	// Pairs found by the broadphase depend on how the objects moved, reset them
+	// so they are the same as after restoring the state.
+	broadphase->reset_pairs(p_work_pool);
+
+	LocalVector<const Body3DSW *> bodies;
+	LocalVector<BodyPair3DSW *> pairs;
+	uint32_t bodies_size = 0;
+	uint32_t pairs_size = 0;
+
+	for (const Set<CollisionObject3DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject3DSW::TYPE_BODY) {
+			continue;
+		}
+
+		const Body3DSW *body = static_cast<const Body3DSW *>(E->get());
+		bodies.push_back(body);
+		bodies_size += sizeof(uint64_t) + sizeof(Body3DSW::SimulationState) + sizeof(uint32_t) + body->get_shape_count() * sizeof(AABB);
+
+		for (const Map<Constraint3DSW *, int, Constraint3DSW::Comparator>::Element *C = body->get_constraint_map().front(); C; C = C->next()) {
+			BodyPair3DSW *pair = C->key()->get_body_pair();
+			// Pairs are in the constraint map of both bodies, only save them once.
+			if (pair && pair->get_body_A() == body) {
+				pairs.push_back(pair);
+				pairs_size += sizeof(PairStateKey) + pair->get_state_size();
+			}
+		}
+	}
+
+	// Islands are generated in active list order, so it's part of the state.
+	uint32_t active_body_count = 0;
+	for (const SelfList<Body3DSW> *E = active_list.first(); E; E = E->next()) {
+		active_body_count++;
+	}
+
+	// So are the sleeping islands, they decide which bodies wake up together.
+	uint32_t sleeping_island_count = 0;
+	uint32_t sleeping_islands_size = 0;
+	for (uint32_t i = 0; i < sleeping_islands.size(); i++) {
+		if (sleeping_islands[i].size()) {
+			sleeping_island_count++;
+			sleeping_islands_size += sizeof(uint32_t) + sleeping_islands[i].size() * sizeof(uint64_t);
+		}
+	}
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(StateHeader) + bodies_size + active_body_count * sizeof(uint64_t) + sleeping_islands_size + pairs_size);
+	uint8_t *w = state.ptrw();
+
+	StateHeader header;
+	header.version = STATE_VERSION;
+	header.real_size = sizeof(real_t);
+	header.body_count = bodies.size();
+	header.active_body_count = active_body_count;
+	header.sleeping_island_count = sleeping_island_count;
+	header.pair_count = pairs.size();
+	memcpy(w, &header, sizeof(StateHeader));
+	w += sizeof(StateHeader);
+
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		uint64_t id = bodies[i]->get_self().get_id();
+		memcpy(w, &id, sizeof(uint64_t));
+		w += sizeof(uint64_t);
+
+		Body3DSW::SimulationState body_state;
+		memset((void *)&body_state, 0, sizeof(Body3DSW::SimulationState)); // Keep the padding deterministic.
+		bodies[i]->save_simulation_state(body_state);
+		memcpy(w, &body_state, sizeof(Body3DSW::SimulationState));
+		w += sizeof(Body3DSW::SimulationState);
+
+		uint32_t shape_count = bodies[i]->get_shape_count();
+		memcpy(w, &shape_count, sizeof(uint32_t));
+		w += sizeof(uint32_t);
+		for (uint32_t j = 0; j < shape_count; j++) {
+			memcpy(w, &bodies[i]->get_shape_aabb(j), sizeof(AABB));
+			w += sizeof(AABB);
+		}
+	}
+
+	for (const SelfList<Body3DSW> *E = active_list.first(); E; E = E->next()) {
+		uint64_t id = E->self()->get_self().get_id();
+		memcpy(w, &id, sizeof(uint64_t));
+		w += sizeof(uint64_t);
+	}
+
+	for (uint32_t i = 0; i < sleeping_islands.size(); i++) {
+		uint32_t island_size = sleeping_islands[i].size();
+		if (!island_size) {
+			continue;
+		}
+		memcpy(w, &island_size, sizeof(uint32_t));
+		w += sizeof(uint32_t);
+		for (uint32_t j = 0; j < island_size; j++) {
+			uint64_t id = sleeping_islands[i][j]->get_self().get_id();
+			memcpy(w, &id, sizeof(uint64_t));
+			w += sizeof(uint64_t);
+		}
+	}
+
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		const BodyPair3DSW *pair = pairs[i];
+
+		PairStateKey key;
+		memset(&key, 0, sizeof(PairStateKey));
+		key.body_A = pair->get_body_A()->get_self().get_id();
+		key.body_B = pair->get_body_B()->get_self().get_id();
+		key.shape_A = pair->get_shape_A();
+		key.shape_B = pair->get_shape_B();
+		key.size = pair->get_state_size();
+		memcpy(w, &key, sizeof(PairStateKey));
+		w += sizeof(PairStateKey);
+
+		pair->save_state(w);
+		w += key.size;
+	}
+
+	return state;
+}
+
+Error Space3DSW::restore_state(const Vector<uint8_t> &p_state, ThreadWorkPool &p_work_pool) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Can't restore the state of a space while it's being stepped.");
+
+	const uint8_t *r = p_state.ptr();
+	uint32_t remaining = p_state.size();
+
+	ERR_FAIL_COND_V(remaining < sizeof(StateHeader), ERR_INVALID_DATA);
+	StateHeader header;
+	memcpy(&header, r, sizeof(StateHeader));
+	r += sizeof(StateHeader);
+	remaining -= sizeof(StateHeader);
+
+	ERR_FAIL_COND_V_MSG(header.version != STATE_VERSION || header.real_size != sizeof(real_t), ERR_INVALID_DATA, "Space state was saved by an incompatible version.");
+
+	HashMap<uint64_t, Body3DSW *> bodies;
+	for (Set<CollisionObject3DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() == CollisionObject3DSW::TYPE_BODY) {
+			bodies.set(E->get()->get_self().get_id(), static_cast<Body3DSW *>(E->get()));
+		}
+	}
+
+	// Restored bodies get their own sleep state, waking an island must not override it.
+	clear_sleeping_islands();
+
+	const uint32_t body_state_size = sizeof(uint64_t) + sizeof(Body3DSW::SimulationState) + sizeof(uint32_t);
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		ERR_FAIL_COND_V(remaining < body_state_size, ERR_INVALID_DATA);
+		uint64_t id;
+		memcpy(&id, r, sizeof(uint64_t));
+		uint32_t shape_count;
+		memcpy(&shape_count, r + sizeof(uint64_t) + sizeof(Body3DSW::SimulationState), sizeof(uint32_t));
+		ERR_FAIL_COND_V(uint64_t(remaining) < body_state_size + uint64_t(shape_count) * sizeof(AABB), ERR_INVALID_DATA);
+
+		// Bodies removed since the state was saved are skipped.
+		Body3DSW **body = bodies.getptr(id);
+		if (body) {
+			Body3DSW::SimulationState body_state;
+			memcpy(&body_state, r + sizeof(uint64_t), sizeof(Body3DSW::SimulationState));
+			(*body)->restore_simulation_state(body_state);
+
+			// Bodies with a different number of shapes keep the AABBs computed from the transform.
+			if (int(shape_count) == (*body)->get_shape_count()) {
+				for (uint32_t j = 0; j < shape_count; j++) {
+					AABB aabb;
+					memcpy(&aabb, r + body_state_size + j * sizeof(AABB), sizeof(AABB));
+					(*body)->restore_shape_aabb(j, aabb);
+				}
+			}
+		}
+
+		r += body_state_size + shape_count * sizeof(AABB);
+		remaining -= body_state_size + shape_count * sizeof(AABB);
+	}
+
+	ERR_FAIL_COND_V(uint64_t(remaining) < uint64_t(header.active_body_count) * sizeof(uint64_t), ERR_INVALID_DATA);
+
+	// Activating bodies adds them at the head of the active list, move them back
+	// to the saved order. Bodies added since the state was saved stay in front.
+	HashMap<uint64_t, SelfList<Body3DSW> *> active_bodies;
+	for (SelfList<Body3DSW> *E = active_list.first(); E; E = E->next()) {
+		active_bodies.set(E->self()->get_self().get_id(), E);
+	}
+	for (uint32_t i = 0; i < header.active_body_count; i++) {
+		uint64_t id;
+		memcpy(&id, r, sizeof(uint64_t));
+		r += sizeof(uint64_t);
+		remaining -= sizeof(uint64_t);
+
+		SelfList<Body3DSW> **E = active_bodies.getptr(id);
+		if (E) {
+			active_list.remove(*E);
+			active_list.add_last(*E);
+		}
+	}
+
+	LocalVector<Body3DSW *> island_bodies;
+	for (uint32_t i = 0; i < header.sleeping_island_count; i++) {
+		ERR_FAIL_COND_V(remaining < sizeof(uint32_t), ERR_INVALID_DATA);
+		uint32_t island_size;
+		memcpy(&island_size, r, sizeof(uint32_t));
+		r += sizeof(uint32_t);
+		remaining -= sizeof(uint32_t);
+		ERR_FAIL_COND_V(uint64_t(remaining) < uint64_t(island_size) * sizeof(uint64_t), ERR_INVALID_DATA);
+
+		island_bodies.clear();
+		for (uint32_t j = 0; j < island_size; j++) {
+			uint64_t id;
+			memcpy(&id, r, sizeof(uint64_t));
+			r += sizeof(uint64_t);
+			remaining -= sizeof(uint64_t);
+
+			Body3DSW **body = bodies.getptr(id);
+			if (body && !(*body)->is_active()) {
+				island_bodies.push_back(*body);
+			}
+		}
+		if (island_bodies.size()) {
+			create_sleeping_island(island_bodies);
+		}
+	}
+
+	// Pairs are created by the broadphase, find them now, the same way as when
+	// saving, so all the pairs exist before restoring their contacts.
+	broadphase->reset_pairs(p_work_pool);
+
+	// Contacts of pairs that weren't saved must not be used for warm starting.
+	for (Set<CollisionObject3DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject3DSW::TYPE_BODY) {
+			continue;
+		}
+
+		const Body3DSW *body = static_cast<const Body3DSW *>(E->get());
+		for (const Map<Constraint3DSW *, int, Constraint3DSW::Comparator>::Element *C = body->get_constraint_map().front(); C; C = C->next()) {
+			BodyPair3DSW *pair = C->key()->get_body_pair();
+			if (pair && pair->get_body_A() == body) {
+				pair->clear_state();
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		ERR_FAIL_COND_V(remaining < sizeof(PairStateKey), ERR_INVALID_DATA);
+		PairStateKey key;
+		memcpy(&key, r, sizeof(PairStateKey));
+		r += sizeof(PairStateKey);
+		remaining -= sizeof(PairStateKey);
+		ERR_FAIL_COND_V(remaining < key.size, ERR_INVALID_DATA);
+
+		Body3DSW **body_A = bodies.getptr(key.body_A);
+		Body3DSW **body_B = bodies.getptr(key.body_B);
+		if (body_A && body_B) {
+			for (const Map<Constraint3DSW *, int, Constraint3DSW::Comparator>::Element *C = (*body_A)->get_constraint_map().front(); C; C = C->next()) {
+				BodyPair3DSW *pair = C->key()->get_body_pair();
+				if (pair && pair->get_body_A() == *body_A && pair->get_body_B() == *body_B && pair->get_shape_A() == key.shape_A && pair->get_shape_B() == key.shape_B) {
+					ERR_FAIL_COND_V(pair->restore_state(r, key.size) != key.size, ERR_INVALID_DATA);
+					break;
+				}
+			}
+		}
+
+		r += key.size;
+		remaining -= key.size;
+	}
+
+	return OK;
 }
 
 void Space3DSW::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
@@ -39,6 +39,7 @@
 #include "collision_object_3d_sw.h"
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "soft_body_3d_sw.h"
 
@@ -85,6 +86,10 @@ private:
 	SelfList<Area3DSW>::List area_moved_list;
 	SelfList<SoftBody3DSW>::List active_soft_body_list;
 
+	// Bodies that fell asleep together, so islands can be woken up without walking their constraints.
+	LocalVector<LocalVector<Body3DSW *>> sleeping_islands;
+	LocalVector<int> free_sleeping_islands;
+
 	static void *_broadphase_pair(CollisionObject3DSW *A, int p_subindex_A, CollisionObject3DSW *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(CollisionObject3DSW *A, int p_subindex_A, CollisionObject3DSW *B, int p_subindex_B, void *p_data, void *p_self);
 
@@ -125,6 +130,27 @@ private:
 
 	int _cull_aabb_for_body(Body3DSW *p_body, const AABB &p_aabb);
 
+	enum {
+		STATE_VERSION = 2
+	};
+
+	struct StateHeader {
+		uint32_t version;
+		uint32_t real_size;
+		uint32_t body_count;
+		uint32_t active_body_count;
+		uint32_t sleeping_island_count;
+		uint32_t pair_count;
+	};
+
+	struct PairStateKey {
+		uint64_t body_A;
+		uint64_t body_B;
+		int32_t shape_A;
+		int32_t shape_B;
+		uint32_t size;
+	};
+
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
@@ -138,6 +164,12 @@ public:
 	void body_add_to_inertia_update_list(SelfList<Body3DSW> *p_body);
 	void body_remove_from_inertia_update_list(SelfList<Body3DSW> *p_body);
 
+	void create_sleeping_island(const LocalVector<Body3DSW *> &p_bodies);
+	void wake_sleeping_island(int p_island);
+	void body_remove_from_sleeping_island(Body3DSW *p_body);
+	void clear_sleeping_islands();
+	int get_sleeping_island_count() const { return sleeping_islands.size() - free_sleeping_islands.size(); }
+
 	void body_add_to_state_query_list(SelfList<Body3DSW> *p_body);
 	void body_remove_from_state_query_list(SelfList<Body3DSW> *p_body);
 
@@ -166,7 +198,10 @@ public:
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_damp_ratio() const { return body_angular_velocity_damp_ratio; }
 
-	void update();
+	void update(ThreadWorkPool &p_work_pool);
+
+	Vector<uint8_t> save_state(ThreadWorkPool &p_work_pool);
+	Error restore_state(const Vector<uint8_t> &p_state, ThreadWorkPool &p_work_pool);
 	void setup();
 	void call_queries();
 
@@ -47,7 +47,7 @@ void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_bod
 		p_body_island.push_back(p_body);
 	}
 
-	for (Map<Constraint3DSW *, int>::Element *E = p_body->get_constraint_map().front(); E; E = E->next()) {
+	for (Map<Constraint3DSW *, int, Constraint3DSW::Comparator>::Element *E = p_body->get_constraint_map().front(); E; E = E->next()) {
 		Constraint3DSW *constraint = (Constraint3DSW *)E->key();
 		if (constraint->get_island_step() == _step) {
 			continue; // Already processed.
@@ -58,6 +58,10 @@ void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_bod
 		all_constraints.push_back(constraint);
 
 		// Find connected rigid bodies.
+		// Which bodies are dynamic for the constraint is decided here rather than from is_active() at setup:
+		// waking a body below also wakes its sleeping island, including bodies that earlier islands already
+		// solve as static. Those must stay static for them, they are not part of their island.
+		uint32_t static_bodies = 0;
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			if (i == E->get()) {
 				continue;
@@ -69,8 +73,20 @@ void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_bod
 			if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
+			if ((other_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) && !other_body->is_active()) {
+				if (constraint->get_body_pair() && p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+					// Sleeping bodies are not walked. The contact is solved with the sleeping body
+					// as static, and kept to find out if its island needs to be woken up.
+					static_bodies |= (1 << i);
+					continue;
+				}
+				// Joints and moving kinematic bodies can't leave the body asleep, it's woken up and
+				// merged into this island so no other island can write to it.
+				other_body->set_active(true);
+			}
 			_populate_island(other_body, p_body_island, p_constraint_island);
 		}
+		constraint->set_island_static_bodies(static_bodies);
 
 		// Find connected soft bodies.
 		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
@@ -97,6 +113,7 @@ void Step3DSW::_populate_island_soft_body(SoftBody3DSW *p_soft_body, LocalVector
 		all_constraints.push_back(constraint);
 
 		// Find connected rigid bodies.
+		uint32_t static_bodies = 0;
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			Body3DSW *body = constraint->get_body_ptr()[i];
 			if (body->get_island_step() == _step) {
@@ -105,8 +122,13 @@ void Step3DSW::_populate_island_soft_body(SoftBody3DSW *p_soft_body, LocalVector
 			if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
+			if ((body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) && !body->is_active()) {
+				static_bodies |= (1 << i);
+				continue; // Sleeping bodies are not walked.
+			}
 			_populate_island(body, p_body_island, p_constraint_island);
 		}
+		constraint->set_island_static_bodies(static_bodies);
 	}
 }
 
@@ -115,7 +137,7 @@ void Step3DSW::_setup_contraint(uint32_t p_constraint_index, void *p_userdata) {
 	constraint->setup(delta);
 }
 
-void Step3DSW::_pre_solve_island(LocalVector<Constraint3DSW *> &p_constraint_island) const {
+void Step3DSW::_pre_solve_island(LocalVector<Constraint3DSW *> &p_constraint_island, LocalVector<Body3DSW *> &r_sleeping_neighbours) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
 	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
@@ -123,6 +145,14 @@ void Step3DSW::_pre_solve_island(LocalVector<Constraint3DSW *> &p_constraint_isl
 		if (p_constraint_island[constraint_index]->pre_solve(delta)) {
 			// Keep this constraint for solving.
 			p_constraint_island[valid_constraint_count++] = constraint;
+
+			// Sleeping bodies in touch with the island are woken up with it.
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				Body3DSW *body = constraint->get_body_ptr()[i];
+				if ((body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) && !body->is_active()) {
+					r_sleeping_neighbours.push_back(body);
+				}
+			}
 		}
 	}
 	p_constraint_island.resize(valid_constraint_count);
@@ -156,7 +186,7 @@ void Step3DSW::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void Step3DSW::_check_suspend(const LocalVector<Body3DSW *> &p_body_island) const {
+void Step3DSW::_check_suspend(Space3DSW *p_space, const LocalVector<Body3DSW *> &p_body_island, const LocalVector<Body3DSW *> *p_sleeping_neighbours) const {
 	bool can_sleep = true;
 
 	uint32_t body_count = p_body_island.size();
@@ -168,14 +198,29 @@ void Step3DSW::_check_suspend(const LocalVector<Body3DSW *> &p_body_island) cons
 		}
 	}
 
-	// Put all to sleep or wake up everyone.
+	if (can_sleep) {
+		// Put all to sleep, and remember the island so it can be woken up at once.
+		for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+			p_body_island[body_index]->set_active(false);
+		}
+		p_space->create_sleeping_island(p_body_island);
+		return;
+	}
+
+	// Wake up everyone, including the sleeping islands this one is in contact with.
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		Body3DSW *body = p_body_island[body_index];
+		if (!body->is_active()) {
+			body->set_active(true);
+		}
+	}
 
-		bool active = body->is_active();
-
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+	if (p_sleeping_neighbours) {
+		for (uint32_t body_index = 0; body_index < p_sleeping_neighbours->size(); ++body_index) {
+			Body3DSW *body = (*p_sleeping_neighbours)[body_index];
+			if (!body->is_active()) {
+				body->set_active(true);
+			}
 		}
 	}
 }
@@ -210,7 +255,7 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	const SelfList<SoftBody3DSW> *sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->predict_motion(p_delta);
+		sb->self()->predict_motion(p_delta, work_pool);
 		sb = sb->next();
 		active_count++;
 	}
@@ -264,6 +309,7 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
 				body_islands.resize(body_island_count);
+				body_island_constraints.resize(body_island_count);
 			}
 			LocalVector<Body3DSW *> &body_island = body_islands[body_island_count - 1];
 			body_island.clear();
@@ -281,6 +327,8 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 			if (body_island.is_empty()) {
 				--body_island_count;
+			} else {
+				body_island_constraints[body_island_count - 1] = constraint_island.is_empty() ? -1 : int(island_count - 1);
 			}
 
 			if (constraint_island.is_empty()) {
@@ -300,6 +348,7 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
 				body_islands.resize(body_island_count);
+				body_island_constraints.resize(body_island_count);
 			}
 			LocalVector<Body3DSW *> &body_island = body_islands[body_island_count - 1];
 			body_island.clear();
@@ -317,6 +366,8 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 			if (body_island.is_empty()) {
 				--body_island_count;
+			} else {
+				body_island_constraints[body_island_count - 1] = constraint_island.is_empty() ? -1 : int(island_count - 1);
 			}
 
 			if (constraint_island.is_empty()) {
@@ -347,9 +398,14 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
+	if (sleeping_neighbours.size() < island_count) {
+		sleeping_neighbours.resize(island_count);
+	}
+
 	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+		sleeping_neighbours[island_index].clear();
+		_pre_solve_island(constraint_islands[island_index], sleeping_neighbours[island_index]);
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
@@ -380,14 +436,15 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 	/* SLEEP / WAKE UP ISLANDS */
 
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		int constraint_island = body_island_constraints[island_index];
+		_check_suspend(p_space, body_islands[island_index], (constraint_island != -1) ? &sleeping_neighbours[constraint_island] : nullptr);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
 	sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->solve_constraints(p_delta);
+		sb->self()->solve_constraints(p_delta, work_pool);
 		sb = sb->next();
 	}
 
@@ -399,7 +456,7 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	all_constraints.clear();
 
-	p_space->update();
+	p_space->update(work_pool);
 	p_space->unlock();
 	_step++;
 }
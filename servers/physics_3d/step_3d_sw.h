@@ -45,18 +45,23 @@ class Step3DSW {
 	ThreadWorkPool work_pool;
 
 	LocalVector<LocalVector<Body3DSW *>> body_islands;
+	LocalVector<int> body_island_constraints;
 	LocalVector<LocalVector<Constraint3DSW *>> constraint_islands;
+	LocalVector<LocalVector<Body3DSW *>> sleeping_neighbours;
 	LocalVector<Constraint3DSW *> all_constraints;
 
 	void _populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island);
 	void _populate_island_soft_body(SoftBody3DSW *p_soft_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island);
 	void _setup_contraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
-	void _pre_solve_island(LocalVector<Constraint3DSW *> &p_constraint_island) const;
+	void _pre_solve_island(LocalVector<Constraint3DSW *> &p_constraint_island, LocalVector<Body3DSW *> &r_sleeping_neighbours) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
-	void _check_suspend(const LocalVector<Body3DSW *> &p_body_island) const;
+	void _check_suspend(Space3DSW *p_space, const LocalVector<Body3DSW *> &p_body_island, const LocalVector<Body3DSW *> *p_sleeping_neighbours) const;
 
 public:
 	void step(Space3DSW *p_space, real_t p_delta, int p_iterations);
+
+	_FORCE_INLINE_ ThreadWorkPool &get_work_pool() { return work_pool; }
+
 	Step3DSW();
 	~Step3DSW();
 };
@@ -200,6 +200,10 @@ public:
 	virtual void set_normal(int p_vertex_id, const void *p_vector3) = 0;
 	virtual void set_aabb(const AABB &p_aabb) = 0;
 
+	// Optional direct access to the interleaved vertex buffer, so vertices can be written without a call per vertex.
+	// Positions and normals are stored as three floats at the given offsets. Returns nullptr if not supported.
+	virtual uint8_t *get_vertex_write_buffer(uint32_t &r_stride, uint32_t &r_offset_vertex, uint32_t &r_offset_normal) { return nullptr; }
+
 	virtual ~RenderingServerHandler() {}
 };
 
@@ -284,6 +288,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const = 0;
+	virtual Error space_restore_state(RID p_space, const Vector<uint8_t> &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -421,6 +428,8 @@ public:
 
 	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) = 0;
 	virtual Variant body_get_state(RID p_body, BodyState p_state) const = 0;
+	// Transform between the last two steps, for visuals updated at a higher rate than physics.
+	virtual Transform3D body_get_interpolated_transform(RID p_body, real_t p_fraction) const;
 
 	//do something about it
 	virtual void body_set_applied_force(RID p_body, const Vector3 &p_force) = 0;
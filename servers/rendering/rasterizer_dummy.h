@@ -255,6 +255,7 @@ public:
 	void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override {}
 	void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override {}
 	void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) override {}
+	void texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata) override {}
 
 	void texture_debug_usage(List<RS::TextureInfo> *r_info) override {}
 	void texture_set_force_redraw_if_visible(RID p_texture, bool p_enable) override {}
@@ -303,6 +304,7 @@ public:
 	bool material_casts_shadows(RID p_material) override { return false; }
 	void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) override {}
 	void material_update_dependency(RID p_material, DependencyTracker *p_instance) override {}
+	void material_request_texture_stream(RID p_material, uint32_t p_size) override {}
 
 	/* MESH API */
 
@@ -661,8 +663,9 @@ public:
 			DummyTexture *texture = texture_owner.getornull(p_rid);
 			texture_owner.free(p_rid);
 			memdelete(texture);
+			return true;
 		}
-		return true;
+		return false;
 	}
 
 	virtual void update_memory_info() override {}
@@ -611,6 +611,14 @@ public:
 	virtual bool free(RID p_rid) = 0;
 	virtual void update() = 0;
 
+	struct RenderInfo {
+		uint64_t draw_calls = 0;
+		uint64_t batches = 0; //instanced draws merging several rects
+	};
+
+	//accumulated while drawing canvas items, reset by the viewport renderer every frame
+	RenderInfo render_info;
+
 	RendererCanvasRender() { singleton = this; }
 	virtual ~RendererCanvasRender() {}
 };
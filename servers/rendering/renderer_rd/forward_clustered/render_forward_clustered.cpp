@@ -382,6 +382,11 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 		RS::PrimitiveType primitive = surf->primitive;
 		RID xforms_uniform_set = surf->owner->transforms_uniform_set;
 
+		bool gpu_culled = p_params->use_gpu_cull && surf->owner->gpu_cull_pass == multimesh_gpu_cull_pass;
+		if (gpu_culled) {
+			xforms_uniform_set = surf->owner->gpu_cull_transforms_uniform_set;
+		}
+
 		SceneShaderForwardClustered::ShaderVersion shader_version = SceneShaderForwardClustered::SHADER_VERSION_MAX; // Assigned to silence wrong -Wmaybe-initialized.
 
 		uint32_t pipeline_specialization = 0;
@@ -493,12 +498,19 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 
 		RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(SceneState::PushConstant));
 
-		uint32_t instance_count = surf->owner->instance_count > 1 ? surf->owner->instance_count : element_info.repeat;
+		// Clamp repeats to this range, a split draw list may end in the middle of a run of equal elements (the next one picks up the rest).
+		uint32_t instance_count = surf->owner->instance_count > 1 ? surf->owner->instance_count : MIN(uint32_t(element_info.repeat), p_to_element - i);
 		if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_PARTICLE_TRAILS) {
 			instance_count /= surf->owner->trail_steps;
 		}
 
-		RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
+		if (gpu_culled) {
+			//instance count was written by the cull shader, depth passes use the shadow surface arguments
+			uint32_t args_index = surf->surface_index + ((shadow_pass || p_pass_mode == PASS_MODE_DEPTH) ? surf->owner->gpu_cull_surface_count : 0);
+			RD::get_singleton()->draw_list_draw_indirect(draw_list, index_array_rd.is_valid(), surf->owner->gpu_cull_args_buffer, args_index * 5 * sizeof(uint32_t));
+		} else {
+			RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
+		}
 		i += element_info.repeat - 1; //skip equal elements
 	}
 }
@@ -542,7 +554,7 @@ void RenderForwardClustered::_render_list(RenderingDevice::DrawListID p_draw_lis
 
 void RenderForwardClustered::_render_list_thread_function(uint32_t p_thread, RenderListParameters *p_params) {
 	uint32_t render_total = p_params->element_count;
-	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+	uint32_t total_threads = thread_draw_lists.size();
 	uint32_t render_from = p_thread * render_total / total_threads;
 	uint32_t render_to = (p_thread + 1 == total_threads) ? render_total : ((p_thread + 1) * render_total / total_threads);
 	_render_list(thread_draw_lists[p_thread], p_params->framebuffer_format, p_params, render_from, render_to);
@@ -552,8 +564,8 @@ void RenderForwardClustered::_render_list_with_threads(RenderListParameters *p_p
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(p_framebuffer);
 	p_params->framebuffer_format = fb_format;
 
-	if ((uint32_t)p_params->element_count > render_list_thread_threshold && false) { // secondary command buffers need more testing at this time
-		//multi threaded
+	if (render_list_threaded && (uint32_t)p_params->element_count > render_list_thread_threshold) {
+		//multi threaded, each thread records a contiguous range of the list into its own split draw list
 		thread_draw_lists.resize(RendererThreadPool::singleton->thread_work_pool.get_thread_count());
 		RD::get_singleton()->draw_list_begin_split(p_framebuffer, thread_draw_lists.size(), thread_draw_lists.ptr(), p_initial_color_action, p_final_color_action, p_initial_depth_action, p_final_depth_action, p_clear_color_values, p_clear_depth, p_clear_stencil, p_region, p_storage_textures);
 		RendererThreadPool::singleton->thread_work_pool.do_work(thread_draw_lists.size(), this, &RenderForwardClustered::_render_list_thread_function, p_params);
@@ -905,6 +917,60 @@ void RenderForwardClustered::_fill_instance_data(RenderListType p_render_list, i
 	}
 }
 
+void RenderForwardClustered::_setup_multimesh_gpu_cull(const RenderDataRD *p_render_data) {
+	multimesh_gpu_cull_pass++;
+	multimesh_gpu_cull_instances.clear();
+
+	const RenderListType lists[2] = { RENDER_LIST_OPAQUE, RENDER_LIST_ALPHA };
+	for (uint32_t l = 0; l < 2; l++) {
+		RenderList *rl = &render_list[lists[l]];
+		for (uint32_t i = 0; i < rl->elements.size(); i++) {
+			GeometryInstanceSurfaceDataCache *surface = rl->elements[i];
+			GeometryInstanceForwardClustered *inst = surface->owner;
+			if (inst->gpu_cull_uniform_set.is_null()) {
+				continue;
+			}
+
+			if (inst->gpu_cull_pass != multimesh_gpu_cull_pass) {
+				inst->gpu_cull_pass = multimesh_gpu_cull_pass;
+				memset(inst->gpu_cull_args.ptr(), 0, inst->gpu_cull_args.size() * sizeof(uint32_t));
+				multimesh_gpu_cull_instances.push_back(inst);
+			}
+
+			//index count depends on the LOD picked for this frame, instance count is filled in by the cull shader
+			uint32_t lod_index = rl->element_info[i].lod_index;
+			if (surface->surface) {
+				inst->gpu_cull_args[surface->surface_index * 5] = storage->mesh_surface_get_draw_count(surface->surface, lod_index);
+			}
+			if (surface->surface_shadow) {
+				inst->gpu_cull_args[(inst->gpu_cull_surface_count + surface->surface_index) * 5] = storage->mesh_surface_get_draw_count(surface->surface_shadow, lod_index);
+			}
+		}
+	}
+
+	if (multimesh_gpu_cull_instances.is_empty()) {
+		return;
+	}
+
+	RD::get_singleton()->draw_command_begin_label("Cull MultiMeshes");
+
+	for (uint32_t i = 0; i < multimesh_gpu_cull_instances.size(); i++) {
+		GeometryInstanceForwardClustered *inst = multimesh_gpu_cull_instances[i];
+		RD::get_singleton()->buffer_update(inst->gpu_cull_args_buffer, 0, inst->gpu_cull_args.size() * sizeof(uint32_t), inst->gpu_cull_args.ptr(), RD::BARRIER_MASK_COMPUTE);
+	}
+
+	Vector<Plane> planes = p_render_data->cam_projection.get_projection_planes(p_render_data->cam_transform);
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	for (uint32_t i = 0; i < multimesh_gpu_cull_instances.size(); i++) {
+		GeometryInstanceForwardClustered *inst = multimesh_gpu_cull_instances[i];
+		storage->multimesh_cull(compute_list, inst->data->base, inst->gpu_cull_uniform_set, inst->transform, planes);
+	}
+	RD::get_singleton()->compute_list_end(RD::BARRIER_MASK_RASTER);
+
+	RD::get_singleton()->draw_command_end_label();
+}
+
 _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primitive, uint32_t p_indices) {
 	static const uint32_t divisor[RS::PRIMITIVE_MAX] = { 1, 2, 1, 3, 1 };
 	static const uint32_t subtractor[RS::PRIMITIVE_MAX] = { 0, 0, 1, 0, 1 };
@@ -1076,6 +1142,16 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 				}
 			}
 
+			// Geometry still waiting for its deferred upload is skipped until it can be drawn.
+			{
+				uint32_t lod_index = surf->sort.lod_index;
+				if (!storage->mesh_surface_request_lod(surf->surface, lod_index) || (surf->surface_shadow != surf->surface && !storage->mesh_surface_request_lod(surf->surface_shadow, lod_index))) {
+					surf = surf->next;
+					continue;
+				}
+				surf->sort.lod_index = lod_index;
+			}
+
 			// ADD Element
 			if (p_pass_mode == PASS_MODE_COLOR) {
 #ifdef DEBUG_ENABLED
@@ -1281,6 +1357,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 	render_list[RENDER_LIST_ALPHA].sort_by_reverse_depth_and_priority();
 	_fill_instance_data(RENDER_LIST_OPAQUE, p_render_data->render_info ? p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE] : (int *)nullptr);
 	_fill_instance_data(RENDER_LIST_ALPHA);
+	_setup_multimesh_gpu_cull(p_render_data);
 
 	RD::get_singleton()->draw_command_end_label();
 
@@ -1394,7 +1471,10 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 		bool finish_depth = using_ssao || using_sdfgi || using_voxelgi;
 		RenderListParameters render_list_params(render_list[RENDER_LIST_OPAQUE].elements.ptr(), render_list[RENDER_LIST_OPAQUE].element_info.ptr(), render_list[RENDER_LIST_OPAQUE].elements.size(), reverse_cull, depth_pass_mode, render_buffer == nullptr, p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold);
+		render_list_params.use_gpu_cull = true;
+		uint64_t record_from = OS::get_singleton()->get_ticks_usec();
 		_render_list_with_threads(&render_list_params, depth_framebuffer, needs_pre_resolve ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, needs_pre_resolve ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_CLEAR, finish_depth ? RD::FINAL_ACTION_READ : RD::FINAL_ACTION_CONTINUE, needs_pre_resolve ? Vector<Color>() : depth_pass_clear);
+		_add_pass_record_time(p_render_data->render_info, RS::VIEWPORT_RENDER_PASS_DEPTH_PREPASS, record_from);
 
 		RD::get_singleton()->draw_command_end_label();
 
@@ -1451,7 +1531,10 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 		RID framebuffer = using_separate_specular ? opaque_specular_framebuffer : opaque_framebuffer;
 		RenderListParameters render_list_params(render_list[RENDER_LIST_OPAQUE].elements.ptr(), render_list[RENDER_LIST_OPAQUE].element_info.ptr(), render_list[RENDER_LIST_OPAQUE].elements.size(), reverse_cull, using_separate_specular ? PASS_MODE_COLOR_SPECULAR : PASS_MODE_COLOR, render_buffer == nullptr, p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold);
+		render_list_params.use_gpu_cull = true;
+		uint64_t record_from = OS::get_singleton()->get_ticks_usec();
 		_render_list_with_threads(&render_list_params, framebuffer, keep_color ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CLEAR, will_continue_color ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, depth_pre_pass ? (continue_depth ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP) : RD::INITIAL_ACTION_CLEAR, will_continue_depth ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, c, 1.0, 0);
+		_add_pass_record_time(p_render_data->render_info, RS::VIEWPORT_RENDER_PASS_OPAQUE, record_from);
 		if (will_continue_color && using_separate_specular) {
 			// close the specular framebuffer, as it's no longer used
 			RD::get_singleton()->draw_list_begin(render_buffer->specular_only_fb, RD::INITIAL_ACTION_CONTINUE, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CONTINUE, RD::FINAL_ACTION_CONTINUE);
@@ -1548,7 +1631,10 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 	{
 		RenderListParameters render_list_params(render_list[RENDER_LIST_ALPHA].elements.ptr(), render_list[RENDER_LIST_ALPHA].element_info.ptr(), render_list[RENDER_LIST_ALPHA].elements.size(), false, PASS_MODE_COLOR, render_buffer == nullptr, p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold);
+		// No GPU culling here: its compaction doesn't keep the instance order, which sorted transparent MultiMeshes rely on.
+		uint64_t record_from = OS::get_singleton()->get_ticks_usec();
 		_render_list_with_threads(&render_list_params, alpha_framebuffer, can_continue_color ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, can_continue_depth ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ);
+		_add_pass_record_time(p_render_data->render_info, RS::VIEWPORT_RENDER_PASS_ALPHA, record_from);
 	}
 
 	RD::get_singleton()->draw_command_end_label();
@@ -1627,6 +1713,7 @@ void RenderForwardClustered::_render_shadow_append(RID p_framebuffer, const Page
 		shadow_pass.initial_depth_action = p_begin ? (p_clear_region ? RD::INITIAL_ACTION_CLEAR_REGION : RD::INITIAL_ACTION_CLEAR) : (p_clear_region ? RD::INITIAL_ACTION_CLEAR_REGION_CONTINUE : RD::INITIAL_ACTION_CONTINUE);
 		shadow_pass.final_depth_action = p_end ? RD::FINAL_ACTION_READ : RD::FINAL_ACTION_CONTINUE;
 		shadow_pass.rect = p_rect;
+		shadow_pass.render_info = p_render_info;
 
 		scene_state.shadow_passes.push_back(shadow_pass);
 	}
@@ -1650,7 +1737,9 @@ void RenderForwardClustered::_render_shadow_end(uint32_t p_barrier) {
 	for (uint32_t i = 0; i < scene_state.shadow_passes.size(); i++) {
 		SceneState::ShadowPass &shadow_pass = scene_state.shadow_passes[i];
 		RenderListParameters render_list_parameters(render_list[RENDER_LIST_SECONDARY].elements.ptr() + shadow_pass.element_from, render_list[RENDER_LIST_SECONDARY].element_info.ptr() + shadow_pass.element_from, shadow_pass.element_count, shadow_pass.flip_cull, shadow_pass.pass_mode, true, false, shadow_pass.rp_uniform_set, false, Vector2(), shadow_pass.camera_plane, shadow_pass.lod_distance_multiplier, shadow_pass.screen_lod_threshold, shadow_pass.element_from, RD::BARRIER_MASK_NO_BARRIER);
+		uint64_t record_from = OS::get_singleton()->get_ticks_usec();
 		_render_list_with_threads(&render_list_parameters, shadow_pass.framebuffer, RD::INITIAL_ACTION_DROP, RD::FINAL_ACTION_DISCARD, shadow_pass.initial_depth_action, shadow_pass.final_depth_action, Vector<Color>(), 1.0, 0, shadow_pass.rect);
+		_add_pass_record_time(shadow_pass.render_info, RS::VIEWPORT_RENDER_PASS_SHADOW, record_from);
 	}
 
 	if (p_barrier != RD::BARRIER_MASK_NO_BARRIER) {
@@ -2683,6 +2772,30 @@ void RenderForwardClustered::_geometry_instance_update(GeometryInstance *p_geome
 
 		ginstance->transforms_uniform_set = storage->multimesh_get_3d_uniform_set(ginstance->data->base, scene_shader.default_shader_rd, TRANSFORMS_UNIFORM_SET);
 
+		_geometry_instance_free_gpu_cull(ginstance);
+
+		RID mesh = storage->multimesh_get_mesh(ginstance->data->base);
+		uint32_t instances = storage->multimesh_get_instance_count(ginstance->data->base);
+		if (multimesh_gpu_cull_threshold > 0 && instances >= multimesh_gpu_cull_threshold && mesh.is_valid() && storage->multimesh_get_transform_format(ginstance->data->base) == RS::MULTIMESH_TRANSFORM_3D) {
+			ginstance->gpu_cull_surface_count = storage->mesh_get_surface_count(mesh);
+		}
+
+		if (ginstance->gpu_cull_surface_count > 0) {
+			//color surfaces and depth surfaces each get their own draw command
+			ginstance->gpu_cull_args.resize(ginstance->gpu_cull_surface_count * 2 * 5);
+			ginstance->gpu_cull_buffer = RD::get_singleton()->storage_buffer_create(instances * storage->multimesh_get_stride(ginstance->data->base) * sizeof(float));
+			ginstance->gpu_cull_args_buffer = RD::get_singleton()->storage_buffer_create(ginstance->gpu_cull_args.size() * sizeof(uint32_t), Vector<uint8_t>(), RD::STORAGE_BUFFER_USAGE_DRAW_INDIRECT);
+			ginstance->gpu_cull_uniform_set = storage->multimesh_get_cull_uniform_set(ginstance->data->base, ginstance->gpu_cull_buffer, ginstance->gpu_cull_args_buffer);
+
+			Vector<RD::Uniform> uniforms;
+			RD::Uniform u;
+			u.binding = 0;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.ids.push_back(ginstance->gpu_cull_buffer);
+			uniforms.push_back(u);
+			ginstance->gpu_cull_transforms_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, scene_shader.default_shader_rd, TRANSFORMS_UNIFORM_SET);
+		}
+
 	} else if (ginstance->data->base_type == RS::INSTANCE_PARTICLES) {
 		ginstance->base_flags |= INSTANCE_DATA_FLAG_MULTIMESH;
 
@@ -2723,6 +2836,23 @@ void RenderForwardClustered::_geometry_instance_update(GeometryInstance *p_geome
 	ginstance->dirty_list_element.remove_from_list();
 }
 
+void RenderForwardClustered::_geometry_instance_free_gpu_cull(GeometryInstanceForwardClustered *ginstance) {
+	//uniform sets depend on these buffers, so they are freed along with them
+	if (ginstance->gpu_cull_buffer.is_valid()) {
+		RD::get_singleton()->free(ginstance->gpu_cull_buffer);
+		ginstance->gpu_cull_buffer = RID();
+	}
+	if (ginstance->gpu_cull_args_buffer.is_valid()) {
+		RD::get_singleton()->free(ginstance->gpu_cull_args_buffer);
+		ginstance->gpu_cull_args_buffer = RID();
+	}
+	ginstance->gpu_cull_uniform_set = RID();
+	ginstance->gpu_cull_transforms_uniform_set = RID();
+	ginstance->gpu_cull_surface_count = 0;
+	ginstance->gpu_cull_pass = 0;
+	ginstance->gpu_cull_args.clear();
+}
+
 void RenderForwardClustered::_update_dirty_geometry_instances() {
 	while (geometry_instance_dirty_list.first()) {
 		_geometry_instance_update(geometry_instance_dirty_list.first()->self());
@@ -2889,6 +3019,7 @@ void RenderForwardClustered::geometry_instance_free(GeometryInstance *p_geometry
 		geometry_instance_surface_alloc.free(surf);
 		surf = next;
 	}
+	_geometry_instance_free_gpu_cull(ginstance);
 	memdelete(ginstance->data);
 	geometry_instance_alloc.free(ginstance);
 }
@@ -2976,6 +3107,8 @@ RenderForwardClustered::RenderForwardClustered(RendererStorageRD *p_storage) :
 	}
 
 	render_list_thread_threshold = GLOBAL_GET("rendering/limits/forward_renderer/threaded_render_minimum_instances");
+	render_list_threaded = GLOBAL_GET("rendering/limits/forward_renderer/threaded_render_lists");
+	multimesh_gpu_cull_threshold = GLOBAL_GET("rendering/limits/forward_renderer/gpu_culled_multimesh_minimum_instances");
 }
 
 RenderForwardClustered::~RenderForwardClustered() {
@@ -157,6 +157,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		uint32_t element_offset = 0;
 		uint32_t barrier = RD::BARRIER_MASK_ALL;
 		bool use_directional_soft_shadow = false;
+		bool use_gpu_cull = false; //draw gpu culled multimeshes with their indirect arguments, only valid for camera passes
 
 		RenderListParameters(GeometryInstanceSurfaceDataCache **p_elements, RenderElementInfo *p_element_info, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, bool p_use_directional_soft_shadows, RID p_render_pass_uniform_set, bool p_force_wireframe = false, const Vector2 &p_uv_offset = Vector2(), const Plane &p_lod_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, uint32_t p_element_offset = 0, uint32_t p_barrier = RD::BARRIER_MASK_ALL) {
 			elements = p_elements;
@@ -342,6 +343,8 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 			RD::InitialAction initial_depth_action;
 			RD::FinalAction final_depth_action;
 			Rect2i rect;
+
+			RendererScene::RenderInfo *render_info;
 		};
 
 		LocalVector<ShadowPass> shadow_passes;
@@ -374,6 +377,13 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 	void _render_list_with_threads(RenderListParameters *p_params, RID p_framebuffer, RD::InitialAction p_initial_color_action, RD::FinalAction p_final_color_action, RD::InitialAction p_initial_depth_action, RD::FinalAction p_final_depth_action, const Vector<Color> &p_clear_color_values = Vector<Color>(), float p_clear_depth = 1.0, uint32_t p_clear_stencil = 0, const Rect2 &p_region = Rect2(), const Vector<RID> &p_storage_textures = Vector<RID>());
 
 	uint32_t render_list_thread_threshold = 500;
+	bool render_list_threaded = true;
+
+	_FORCE_INLINE_ void _add_pass_record_time(RendererScene::RenderInfo *p_render_info, RS::ViewportRenderPass p_pass, uint64_t p_from_usec) {
+		if (p_render_info) {
+			p_render_info->pass_record_usec[p_pass] += OS::get_singleton()->get_ticks_usec() - p_from_usec;
+		}
+	}
 
 	void _update_instance_data_buffer(RenderListType p_render_list);
 	void _fill_instance_data(RenderListType p_render_list, int *p_render_info = nullptr, uint32_t p_offset = 0, int32_t p_max_elements = -1, bool p_update_buffer = true);
@@ -464,6 +474,15 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		bool can_sdfgi = false;
 		bool using_projectors = false;
 		bool using_softshadows = false;
+		//large multimeshes can be frustum culled on the gpu, visible instances are compacted into gpu_cull_buffer
+		//and drawn with one indirect command per surface (color surfaces first, then depth surfaces)
+		RID gpu_cull_buffer;
+		RID gpu_cull_args_buffer;
+		RID gpu_cull_uniform_set;
+		RID gpu_cull_transforms_uniform_set;
+		uint32_t gpu_cull_surface_count = 0;
+		uint64_t gpu_cull_pass = 0;
+		LocalVector<uint32_t> gpu_cull_args;
 		//used during setup
 		uint32_t base_flags = 0;
 		Transform3D transform;
@@ -511,8 +530,14 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 	void _geometry_instance_add_surface(GeometryInstanceForwardClustered *ginstance, uint32_t p_surface, RID p_material, RID p_mesh);
 	void _geometry_instance_mark_dirty(GeometryInstance *p_geometry_instance);
 	void _geometry_instance_update(GeometryInstance *p_geometry_instance);
+	void _geometry_instance_free_gpu_cull(GeometryInstanceForwardClustered *ginstance);
 	void _update_dirty_geometry_instances();
 
+	uint32_t multimesh_gpu_cull_threshold = 4096;
+	uint64_t multimesh_gpu_cull_pass = 0;
+	LocalVector<GeometryInstanceForwardClustered *> multimesh_gpu_cull_instances;
+	void _setup_multimesh_gpu_cull(const RenderDataRD *p_render_data);
+
 	/* Render List */
 
 	struct RenderList {
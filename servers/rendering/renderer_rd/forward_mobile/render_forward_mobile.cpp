@@ -1087,6 +1087,16 @@ void RenderForwardMobile::_fill_render_list(RenderListType p_render_list, const
 				}
 			}
 
+			// Geometry still waiting for its deferred upload is skipped until it can be drawn.
+			{
+				uint32_t lod_index = surf->lod_index;
+				if (!storage->mesh_surface_request_lod(surf->surface, lod_index) || (surf->surface_shadow != surf->surface && !storage->mesh_surface_request_lod(surf->surface_shadow, lod_index))) {
+					surf = surf->next;
+					continue;
+				}
+				surf->lod_index = lod_index;
+			}
+
 			// ADD Element
 			if (p_pass_mode == PASS_MODE_COLOR) {
 #ifdef DEBUG_ENABLED
@@ -31,7 +31,7 @@
 #include "pipeline_cache_rd.h"
 #include "core/os/memory.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
 
@@ -54,8 +54,29 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
-	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
-	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	return RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	RID pipeline;
+	if (async_compile && p_bool_specializations) {
+		// Registered with a null pipeline, filled in by the compile thread.
+		MutexLock lock(compile_mutex);
+		CompileRequest request;
+		request.cache = this;
+		request.shader = shader;
+		request.vertex_id = p_vertex_format_id;
+		request.framebuffer_id = p_framebuffer_format_id;
+		request.render_pass = p_render_pass;
+		request.wireframe = p_wireframe;
+		request.bool_specializations = p_bool_specializations;
+		compile_queue.push_back(request);
+		compile_semaphore.post();
+	} else {
+		pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	}
+
 	versions = (Version *)memrealloc(versions, sizeof(Version) * (version_count + 1));
 	versions[version_count].framebuffer_id = p_framebuffer_format_id;
 	versions[version_count].vertex_id = p_vertex_format_id;
@@ -67,11 +88,96 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 	return pipeline;
 }
 
+void PipelineCacheRD::_compile_thread_function(void *p_ud) {
+	while (true) {
+		compile_semaphore.wait();
+
+		compile_mutex.lock();
+		if (compile_thread_exit) {
+			compile_mutex.unlock();
+			break;
+		}
+		if (compile_queue.is_empty()) {
+			// Request was cancelled.
+			compile_mutex.unlock();
+			continue;
+		}
+		CompileRequest request = compile_queue[0];
+		compile_queue.remove(0);
+		compiling_shader = request.shader;
+		// Taken before releasing the queue, so caches being cleared know to wait for it.
+		compile_in_progress_mutex.lock();
+		compile_mutex.unlock();
+
+		PipelineCacheRD *cache = request.cache;
+		RID pipeline = cache->_create_pipeline(request.vertex_id, request.framebuffer_id, request.wireframe, request.render_pass, request.bool_specializations);
+
+		cache->spin_lock.lock();
+		for (uint32_t i = 0; i < cache->version_count; i++) {
+			Version &version = cache->versions[i];
+			if (version.vertex_id == request.vertex_id && version.framebuffer_id == request.framebuffer_id && version.wireframe == request.wireframe && version.render_pass == request.render_pass && version.bool_specializations == request.bool_specializations) {
+				version.pipeline = pipeline;
+				break;
+			}
+		}
+		cache->spin_lock.unlock();
+
+		compile_mutex.lock();
+		compiling_shader = RID();
+		compile_mutex.unlock();
+
+		compile_in_progress_mutex.unlock();
+	}
+}
+
+void PipelineCacheRD::_wait_for_compiles() {
+	if (!async_compile) {
+		return;
+	}
+
+	compile_mutex.lock();
+	for (uint32_t i = 0; i < compile_queue.size(); i++) {
+		if (compile_queue[i].cache == this) {
+			compile_queue.remove(i);
+			i--;
+		}
+	}
+	compile_mutex.unlock();
+
+	// Wait for a request of this cache that may be compiling right now.
+	compile_in_progress_mutex.lock();
+	compile_in_progress_mutex.unlock();
+}
+
+void PipelineCacheRD::cancel_compiles(RID p_shader) {
+	if (!async_compile) {
+		return;
+	}
+
+	compile_mutex.lock();
+	for (uint32_t i = 0; i < compile_queue.size(); i++) {
+		if (compile_queue[i].shader == p_shader) {
+			compile_queue.remove(i);
+			i--;
+		}
+	}
+	bool compiling = compiling_shader == p_shader;
+	compile_mutex.unlock();
+
+	if (compiling) {
+		// The shader must outlive the request being compiled right now.
+		compile_in_progress_mutex.lock();
+		compile_in_progress_mutex.unlock();
+	}
+}
+
 void PipelineCacheRD::_clear() {
+	_wait_for_compiles();
+
 	if (versions) {
 		for (uint32_t i = 0; i < version_count; i++) {
 			//shader may be gone, so this may not be valid
-			if (RD::get_singleton()->render_pipeline_is_valid(versions[i].pipeline)) {
+			if (versions[i].pipeline.is_valid() && RD::get_singleton()->render_pipeline_is_valid(versions[i].pipeline)) {
 				RD::get_singleton()->free(versions[i].pipeline);
 			}
 		}
@@ -107,6 +213,40 @@ void PipelineCacheRD::clear() {
 	input_mask = 0;
 }
 
+void PipelineCacheRD::initialize_async_compile(bool p_enable) {
+	ERR_FAIL_COND(compile_thread.is_started());
+	async_compile = p_enable;
+	if (async_compile) {
+		compile_thread_exit = false;
+		compile_thread.start(_compile_thread_function, nullptr);
+	}
+}
+
+void PipelineCacheRD::finalize_async_compile() {
+	if (!async_compile) {
+		return;
+	}
+
+	compile_mutex.lock();
+	compile_queue.clear();
+	compile_thread_exit = true;
+	compile_mutex.unlock();
+	compile_semaphore.post();
+	compile_thread.wait_to_finish();
+
+	// Anything not compiled yet from now on is compiled on demand.
+	async_compile = false;
+}
+
+bool PipelineCacheRD::async_compile = false;
+bool PipelineCacheRD::compile_thread_exit = false;
+Thread PipelineCacheRD::compile_thread;
+Semaphore PipelineCacheRD::compile_semaphore;
+Mutex PipelineCacheRD::compile_mutex;
+Mutex PipelineCacheRD::compile_in_progress_mutex;
+RID PipelineCacheRD::compiling_shader;
+LocalVector<PipelineCacheRD::CompileRequest> PipelineCacheRD::compile_queue;
+
 PipelineCacheRD::PipelineCacheRD() {
 	version_count = 0;
 	versions = nullptr;
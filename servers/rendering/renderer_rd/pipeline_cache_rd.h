@@ -31,7 +31,11 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
 #include "core/os/spin_lock.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
@@ -54,14 +58,41 @@ class PipelineCacheRD {
 		uint32_t render_pass;
 		bool wireframe;
 		uint32_t bool_specializations;
-		RID pipeline;
+		RID pipeline; // Null while it is being compiled in the background.
 	};
 
 	Version *versions;
 	uint32_t version_count;
 
+	// Specialized pipelines can be compiled on a background thread, drawing
+	// with the unspecialized (generic) version of the pipeline until they are ready.
+	// The generic version is not an ubershader, it has all the bool specializations
+	// disabled: the features they enable are missing from those draws meanwhile.
+	struct CompileRequest {
+		PipelineCacheRD *cache;
+		RID shader;
+		RD::VertexFormatID vertex_id;
+		RD::FramebufferFormatID framebuffer_id;
+		uint32_t render_pass;
+		bool wireframe;
+		uint32_t bool_specializations;
+	};
+
+	static bool async_compile;
+	static bool compile_thread_exit;
+	static Thread compile_thread;
+	static Semaphore compile_semaphore;
+	static Mutex compile_mutex; // Protects the queue.
+	static Mutex compile_in_progress_mutex; // Held by the thread while a request is compiled.
+	static RID compiling_shader; // Shader of the request being compiled, protected by compile_mutex.
+	static LocalVector<CompileRequest> compile_queue;
+
+	static void _compile_thread_function(void *p_ud);
+
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
 
+	void _wait_for_compiles();
 	void _clear();
 
 public:
@@ -80,11 +111,18 @@ public:
 			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
 				result = versions[i].pipeline;
 				spin_lock.unlock();
+				if (unlikely(result.is_null() && p_bool_specializations)) {
+					// Not compiled yet, use the generic version meanwhile.
+					return get_render_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, 0);
+				}
 				return result;
 			}
 		}
 		result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
 		spin_lock.unlock();
+		if (unlikely(result.is_null() && p_bool_specializations)) {
+			return get_render_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, 0);
+		}
 		return result;
 	}
 
@@ -92,6 +130,12 @@ public:
 		return input_mask;
 	}
 	void clear();
+
+	static void initialize_async_compile(bool p_enable);
+	static void finalize_async_compile();
+	// Must be called before freeing a shader that may be used by a pipeline cache.
+	static void cancel_compiles(RID p_shader);
+
 	PipelineCacheRD();
 	~PipelineCacheRD();
 };
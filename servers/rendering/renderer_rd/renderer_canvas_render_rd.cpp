@@ -392,6 +392,59 @@ void RendererCanvasRenderRD::_bind_canvas_texture(RD::DrawListID p_draw_list, RI
 	r_last_texture = p_texture;
 }
 
+uint32_t RendererCanvasRenderRD::_gather_item_lights(const Item *p_item, Light *p_lights, uint32_t *r_light_indices) {
+	uint32_t light_count = 0;
+	Light *light = p_lights;
+
+	while (light) {
+		if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
+			uint32_t light_index = light->render_index_cache;
+			r_light_indices[light_count >> 2] |= light_index << ((light_count & 3) * 8);
+
+			light_count++;
+
+			if (light_count == MAX_LIGHTS_PER_ITEM) {
+				break;
+			}
+		}
+		light = light->next_ptr;
+	}
+
+	return light_count;
+}
+
+void RendererCanvasRenderRD::_get_rect_src_dst(const Item::CommandRect *p_rect, const Size2 &p_texpixel_size, Rect2 &r_src_rect, Rect2 &r_dst_rect) {
+	r_dst_rect = Rect2(p_rect->rect.position, p_rect->rect.size);
+
+	if (r_dst_rect.size.width < 0) {
+		r_dst_rect.position.x += r_dst_rect.size.width;
+		r_dst_rect.size.width *= -1;
+	}
+	if (r_dst_rect.size.height < 0) {
+		r_dst_rect.position.y += r_dst_rect.size.height;
+		r_dst_rect.size.height *= -1;
+	}
+
+	if (p_rect->texture == RID()) {
+		r_src_rect = Rect2(0, 0, 1, 1);
+		return;
+	}
+
+	r_src_rect = (p_rect->flags & CANVAS_RECT_REGION) ? Rect2(p_rect->source.position * p_texpixel_size, p_rect->source.size * p_texpixel_size) : Rect2(0, 0, 1, 1);
+
+	if (p_rect->flags & CANVAS_RECT_FLIP_H) {
+		r_src_rect.size.x *= -1;
+	}
+
+	if (p_rect->flags & CANVAS_RECT_FLIP_V) {
+		r_src_rect.size.y *= -1;
+	}
+
+	if (p_rect->flags & CANVAS_RECT_TRANSPOSE) {
+		r_dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
+	}
+}
+
 void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants) {
 	//create an empty push constant
 
@@ -423,8 +476,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -433,28 +486,10 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 	uint32_t base_flags = 0;
 
-	uint16_t light_count = 0;
+	uint32_t light_count = _gather_item_lights(p_item, p_lights, push_constant.lights);
 	PipelineLightMode light_mode;
 
-	{
-		Light *light = p_lights;
-
-		while (light) {
-			if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
-				uint32_t light_index = light->render_index_cache;
-				push_constant.lights[light_count >> 2] |= light_index << ((light_count & 3) * 8);
-
-				light_count++;
-
-				if (light_count == MAX_LIGHTS_PER_ITEM) {
-					break;
-				}
-			}
-			light = light->next_ptr;
-		}
-
-		base_flags |= light_count << FLAGS_LIGHT_COUNT_SHIFT;
-	}
+	base_flags |= light_count << FLAGS_LIGHT_COUNT_SHIFT;
 
 	light_mode = (light_count > 0 || using_directional_lights) ? PIPELINE_LIGHT_MODE_ENABLED : PIPELINE_LIGHT_MODE_DISABLED;
 
@@ -492,49 +527,10 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 				Rect2 src_rect;
 				Rect2 dst_rect;
+				_get_rect_src_dst(rect, texpixel_size, src_rect, dst_rect);
 
-				if (rect->texture != RID()) {
-					src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
-
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
-
-					if (rect->flags & CANVAS_RECT_FLIP_H) {
-						src_rect.size.x *= -1;
-					}
-
-					if (rect->flags & CANVAS_RECT_FLIP_V) {
-						src_rect.size.y *= -1;
-					}
-
-					if (rect->flags & CANVAS_RECT_TRANSPOSE) {
-						dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
-					}
-
-					if (rect->flags & CANVAS_RECT_CLIP_UV) {
-						push_constant.flags |= FLAGS_CLIP_RECT_UV;
-					}
-
-				} else {
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
-
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
-
-					src_rect = Rect2(0, 0, 1, 1);
+				if (rect->texture != RID() && (rect->flags & CANVAS_RECT_CLIP_UV)) {
+					push_constant.flags |= FLAGS_CLIP_RECT_UV;
 				}
 
 				push_constant.modulation[0] = rect->modulate.r * base_color.r;
@@ -555,6 +551,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				render_info.draw_calls++;
 
 			} break;
 
@@ -619,6 +616,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				render_info.draw_calls++;
 
 				//restore if overrided
 				push_constant.color_texture_pixel_size[0] = texpixel_size.x;
@@ -664,6 +662,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 					RD::get_singleton()->draw_list_bind_index_array(p_draw_list, pb->indices);
 				}
 				RD::get_singleton()->draw_list_draw(p_draw_list, pb->indices.is_valid());
+				render_info.draw_calls++;
 
 			} break;
 			case Item::Command::TYPE_PRIMITIVE: {
@@ -694,6 +693,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 				}
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				render_info.draw_calls++;
 
 				if (primitive->point_count == 4) {
 					for (uint32_t j = 1; j < 3; j++) {
@@ -709,6 +709,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 					RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 					RD::get_singleton()->draw_list_draw(p_draw_list, true);
+					render_info.draw_calls++;
 				}
 
 			} break;
@@ -860,6 +861,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 					RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 
 					RD::get_singleton()->draw_list_draw(p_draw_list, index_array.is_valid(), instance_count);
+					render_info.draw_calls++;
 				}
 
 				for (int j = 0; j < 6; j++) {
@@ -1016,6 +1018,191 @@ RID RendererCanvasRenderRD::_create_base_uniform_set(RID p_to_render_target, boo
 	return uniform_set;
 }
 
+void RendererCanvasRenderRD::_prepare_rect_batches(int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights) {
+	rect_batching.instances.clear();
+	rect_batching.batches.clear();
+	rect_batching.item_batches.resize(p_item_count);
+
+	int32_t current_batch = -1;
+
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+		rect_batching.item_batches[i] = -1;
+
+		// Only plain rects sharing one texture can go through the batched path, anything else
+		// (custom materials, lights, other commands) still uses the regular per-command draws.
+		bool batchable = rect_batching.enabled && ci->commands != nullptr && ci->material.is_null() && ci->canvas_group == nullptr;
+		RID texture;
+
+		for (const Item::Command *c = ci->commands; batchable && c; c = c->next) {
+			if (c->type != Item::Command::TYPE_RECT) {
+				batchable = false;
+				break;
+			}
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+			if (c == ci->commands) {
+				texture = rect->texture;
+			} else if (rect->texture != texture) {
+				batchable = false;
+			}
+
+			if (rect->texture != RID() && (rect->flags & CANVAS_RECT_CLIP_UV)) {
+				batchable = false; // Needs the source rect in the fragment shader.
+			}
+		}
+
+		if (batchable) {
+			uint32_t light_indices[4] = { 0, 0, 0, 0 };
+			batchable = _gather_item_lights(ci, p_lights, light_indices) == 0;
+		}
+
+		RID uniform_set;
+		Size2i size;
+		Color specular_shininess;
+		bool use_normal = false;
+		bool use_specular = false;
+
+		if (batchable) {
+			RS::CanvasItemTextureFilter filter = ci->texture_filter != RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? ci->texture_filter : default_filter;
+			RS::CanvasItemTextureRepeat repeat = ci->texture_repeat != RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? ci->texture_repeat : default_repeat;
+
+			bool success = storage->canvas_texture_get_uniform_set(texture, filter, repeat, shader.default_version_rd_shader, CANVAS_TEXTURE_UNIFORM_SET, uniform_set, size, specular_shininess, use_normal, use_specular);
+			if (!success) {
+				success = storage->canvas_texture_get_uniform_set(default_canvas_texture, filter, repeat, shader.default_version_rd_shader, CANVAS_TEXTURE_UNIFORM_SET, uniform_set, size, specular_shininess, use_normal, use_specular);
+			}
+
+			// Normal maps are rotated by the item transform in the fragment shader, which is per instance here.
+			batchable = success && !(use_normal && using_directional_lights);
+		}
+
+		if (!batchable) {
+			current_batch = -1;
+			continue;
+		}
+
+		uint32_t flags = 0;
+		if (specular_shininess.a < 0.999) {
+			flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
+		}
+		if (use_normal) {
+			flags |= FLAGS_DEFAULT_NORMAL_MAP_USED;
+		}
+
+		if (current_batch >= 0) {
+			const RectBatching::Batch &batch = rect_batching.batches[current_batch];
+			if (batch.texture_uniform_set != uniform_set || batch.clip != ci->final_clip_owner || (batch.push_constant.flags & ~FLAGS_BATCHED_RECTS) != flags) {
+				current_batch = -1;
+			}
+		}
+
+		if (current_batch < 0) {
+			RectBatching::Batch batch;
+			batch.clip = ci->final_clip_owner;
+			batch.texture_uniform_set = uniform_set;
+
+			PushConstant &push_constant = batch.push_constant;
+			memset(&push_constant, 0, sizeof(PushConstant));
+			push_constant.flags = flags | FLAGS_BATCHED_RECTS;
+			push_constant.batch_offset = rect_batching.instances.size();
+			push_constant.color_texture_pixel_size[0] = 1.0 / float(size.x);
+			push_constant.color_texture_pixel_size[1] = 1.0 / float(size.y);
+			push_constant.specular_shininess = uint32_t(CLAMP(specular_shininess.a * 255.0, 0, 255)) << 24;
+			push_constant.specular_shininess |= uint32_t(CLAMP(specular_shininess.b * 255.0, 0, 255)) << 16;
+			push_constant.specular_shininess |= uint32_t(CLAMP(specular_shininess.g * 255.0, 0, 255)) << 8;
+			push_constant.specular_shininess |= uint32_t(CLAMP(specular_shininess.r * 255.0, 0, 255));
+
+			current_batch = rect_batching.batches.size();
+			rect_batching.batches.push_back(batch);
+			rect_batching.item_batches[i] = current_batch;
+		}
+
+		RectBatching::Batch &batch = rect_batching.batches[current_batch];
+		batch.item_to = i + 1;
+
+		Size2 texpixel_size(1.0 / float(size.x), 1.0 / float(size.y));
+		Transform2D base_transform = p_canvas_transform_inverse * ci->final_transform;
+		Color base_color = ci->final_modulate;
+
+		for (const Item::Command *c = ci->commands; c; c = c->next) {
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+
+			Rect2 src_rect;
+			Rect2 dst_rect;
+			_get_rect_src_dst(rect, texpixel_size, src_rect, dst_rect);
+
+			RectBatching::Instance instance;
+			_update_transform_2d_to_mat2x3(base_transform, instance.world);
+			instance.pad[0] = 0;
+			instance.pad[1] = 0;
+
+			instance.modulation[0] = rect->modulate.r * base_color.r;
+			instance.modulation[1] = rect->modulate.g * base_color.g;
+			instance.modulation[2] = rect->modulate.b * base_color.b;
+			instance.modulation[3] = rect->modulate.a * base_color.a;
+
+			instance.src_rect[0] = src_rect.position.x;
+			instance.src_rect[1] = src_rect.position.y;
+			instance.src_rect[2] = src_rect.size.width;
+			instance.src_rect[3] = src_rect.size.height;
+
+			instance.dst_rect[0] = dst_rect.position.x;
+			instance.dst_rect[1] = dst_rect.position.y;
+			instance.dst_rect[2] = dst_rect.size.width;
+			instance.dst_rect[3] = dst_rect.size.height;
+
+			rect_batching.instances.push_back(instance);
+			batch.instance_count++;
+		}
+	}
+
+	if (rect_batching.instances.size() == 0) {
+		return;
+	}
+
+	if (rect_batching.instances.size() > rect_batching.instance_capacity) {
+		if (rect_batching.instance_buffer.is_valid()) {
+			RD::get_singleton()->free(rect_batching.instance_buffer); //uniform set is freed by dependency
+		}
+
+		rect_batching.instance_capacity = next_power_of_2(MAX(rect_batching.instances.size(), 1024u));
+		rect_batching.instance_buffer = RD::get_singleton()->storage_buffer_create(rect_batching.instance_capacity * sizeof(RectBatching::Instance));
+
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(rect_batching.instance_buffer);
+			uniforms.push_back(u);
+		}
+
+		rect_batching.uniform_set = RD::get_singleton()->uniform_set_create(uniforms, shader.default_version_rd_shader, TRANSFORMS_UNIFORM_SET);
+	}
+
+	RD::get_singleton()->buffer_update(rect_batching.instance_buffer, 0, rect_batching.instances.size() * sizeof(RectBatching::Instance), rect_batching.instances.ptr());
+}
+
+void RendererCanvasRenderRD::_render_rect_batch(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format, const RectBatching::Batch &p_batch) {
+	PipelineLightMode light_mode = using_directional_lights ? PIPELINE_LIGHT_MODE_ENABLED : PIPELINE_LIGHT_MODE_DISABLED;
+	RID pipeline = shader.pipeline_variants.variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
+
+	RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, p_batch.texture_uniform_set, CANVAS_TEXTURE_UNIFORM_SET);
+	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, rect_batching.uniform_set, TRANSFORMS_UNIFORM_SET);
+
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &p_batch.push_constant, sizeof(PushConstant));
+	RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, true, p_batch.instance_count);
+
+	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, state.default_transforms_uniform_set, TRANSFORMS_UNIFORM_SET);
+
+	render_info.draw_calls++;
+	if (p_batch.instance_count > 1) {
+		render_info.batches++;
+	}
+}
+
 void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool p_to_backbuffer) {
 	Item *current_clip = nullptr;
 
@@ -1050,6 +1237,8 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	_prepare_rect_batches(p_item_count, canvas_transform_inverse, p_lights);
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, fb_uniform_set, BASE_UNIFORM_SET);
@@ -1100,7 +1289,14 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 			}
 		}
 
-		_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants);
+		int32_t batch_index = rect_batching.item_batches[i];
+		if (batch_index >= 0) {
+			const RectBatching::Batch &batch = rect_batching.batches[batch_index];
+			_render_rect_batch(draw_list, fb_format, batch);
+			i = batch.item_to - 1; // Items in a batch share clip and (default) material.
+		} else {
+			_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants);
+		}
 
 		prev_material = material;
 	}
@@ -2559,6 +2755,7 @@ RendererCanvasRenderRD::RendererCanvasRenderRD(RendererStorageRD *p_storage) {
 	storage->canvas_texture_initialize(default_canvas_texture);
 
 	state.shadow_texture_size = GLOBAL_GET("rendering/2d/shadow_atlas/size");
+	rect_batching.enabled = GLOBAL_GET("rendering/2d/batching/use_batching");
 
 	//create functions for shader and material
 	storage->shader_set_data_request_function(RendererStorageRD::SHADER_TYPE_2D, _create_shader_funcs);
@@ -2663,6 +2860,10 @@ RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 	}
 	RD::get_singleton()->free(state.shadow_texture);
 
+	if (rect_batching.instance_buffer.is_valid()) {
+		RD::get_singleton()->free(rect_batching.instance_buffer);
+	}
+
 	storage->free(default_canvas_texture);
 	//pipelines don't need freeing, they are all gone after shaders are gone
 }
@@ -77,6 +77,7 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		FLAGS_NINEPACH_DRAW_CENTER = (1 << 12),
 		FLAGS_USING_PARTICLES = (1 << 13),
+		FLAGS_BATCHED_RECTS = (1 << 14),
 
 		FLAGS_USE_SKELETON = (1 << 15),
 		FLAGS_NINEPATCH_H_MODE_SHIFT = 16,
@@ -391,7 +392,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 				float ninepatch_margins[4];
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t batch_offset;
+				uint32_t pad;
 			};
 			//primitive
 			struct {
@@ -404,6 +406,42 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		uint32_t lights[4];
 	};
 
+	/*******************/
+	/**** BATCHING ****/
+	/*******************/
+
+	// Runs of consecutive items made only of rects, with the default material, no lights and a shared
+	// texture and clip, are drawn with a single instanced draw. The per-rect data is gathered before the
+	// draw list is opened (buffers can't be updated while recording) and streamed through a storage buffer.
+
+	struct RectBatching {
+		struct Instance {
+			float world[6];
+			float pad[2];
+			float modulation[4];
+			float src_rect[4];
+			float dst_rect[4];
+		};
+
+		struct Batch {
+			uint32_t item_to = 0; //one past the last item drawn by this batch
+			uint32_t instance_count = 0;
+			Item *clip = nullptr;
+			RID texture_uniform_set;
+			PushConstant push_constant;
+		};
+
+		LocalVector<Instance> instances;
+		LocalVector<Batch> batches;
+		LocalVector<int32_t> item_batches; //batch starting at each item, -1 if drawn on its own
+
+		RID instance_buffer;
+		RID uniform_set;
+		uint32_t instance_capacity = 0;
+
+		bool enabled = true;
+	} rect_batching;
+
 	struct SkeletonUniform {
 		float skeleton_transform[16];
 		float skeleton_inverse[16];
@@ -422,6 +460,11 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	RID _create_base_uniform_set(RID p_to_render_target, bool p_backbuffer);
 
+	uint32_t _gather_item_lights(const Item *p_item, Light *p_lights, uint32_t *r_light_indices);
+	void _get_rect_src_dst(const Item::CommandRect *p_rect, const Size2 &p_texpixel_size, Rect2 &r_src_rect, Rect2 &r_dst_rect);
+	void _prepare_rect_batches(int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights);
+	void _render_rect_batch(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format, const RectBatching::Batch &p_batch);
+
 	inline void _bind_canvas_texture(RD::DrawListID p_draw_list, RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, RID &r_last_texture, PushConstant &push_constant, Size2 &r_texpixel_size); //recursive, so regular inline used instead.
 	void _render_item(RenderingDevice::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool p_to_backbuffer = false);
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 
 void RendererCompositorRD::prepare_for_blitting_render_targets() {
 	RD::get_singleton()->prepare_screen_for_drawing();
@@ -143,6 +144,8 @@ void RendererCompositorRD::initialize() {
 uint64_t RendererCompositorRD::frame = 1;
 
 void RendererCompositorRD::finalize() {
+	PipelineCacheRD::finalize_async_compile();
+
 	memdelete(scene);
 	memdelete(canvas);
 	memdelete(storage);
@@ -263,8 +266,15 @@ RendererCompositorRD::RendererCompositorRD() {
 				}
 			}
 		}
+
+		// Exported projects may ship with the editor's shader cache, so the first launch doesn't compile everything.
+		if (!Engine::get_singleton()->is_editor_hint() && FileAccess::exists("res://.godot/shader_cache.pack")) {
+			ShaderRD::load_shader_cache_pack("res://.godot/shader_cache.pack");
+		}
 	}
 
+	PipelineCacheRD::initialize_async_compile(GLOBAL_GET("rendering/shader_compiler/async_pipeline_compilation"));
+
 	singleton = this;
 	time = 0;
 
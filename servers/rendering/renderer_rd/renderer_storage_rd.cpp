@@ -32,6 +32,8 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_defs.h"
 #include "renderer_compositor_rd.h"
@@ -1130,10 +1132,25 @@ void RendererStorageRD::texture_replace(RID p_texture, RID p_by_texture) {
 	Vector<RID> proxies_to_update = tex->proxies;
 	Vector<RID> proxies_to_redirect = by_tex->proxies;
 
+	//streaming state belongs to the texture, not to its current data
+	RS::TextureStreamCallback stream_callback = tex->stream_callback;
+	void *stream_callback_ud = tex->stream_callback_ud;
+	uint32_t stream_min_size = tex->stream_min_size;
+	uint32_t stream_size = tex->stream_size;
+	uint32_t stream_request = tex->stream_request;
+	uint32_t stream_request_prev = tex->stream_request_prev;
+
 	*tex = *by_tex;
 
 	tex->proxies = proxies_to_update; //restore proxies, so they can be updated
 
+	tex->stream_callback = stream_callback;
+	tex->stream_callback_ud = stream_callback_ud;
+	tex->stream_min_size = stream_min_size;
+	tex->stream_size = stream_size;
+	tex->stream_request = stream_request;
+	tex->stream_request_prev = stream_request_prev;
+
 	if (tex->canvas_texture) {
 		tex->canvas_texture->diffuse = p_texture; //update
 	}
@@ -1193,6 +1210,89 @@ void RendererStorageRD::texture_set_detect_roughness_callback(RID p_texture, RS:
 	tex->detect_roughness_callback = p_callback;
 }
 
+void RendererStorageRD::texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata) {
+	Texture *tex = texture_owner.getornull(p_texture);
+	ERR_FAIL_COND(!tex);
+	ERR_FAIL_COND(tex->type != Texture::TYPE_2D);
+	tex->stream_callback_ud = p_userdata;
+	tex->stream_callback = p_callback;
+	tex->stream_request = 0;
+	tex->stream_request_prev = 0;
+
+	if (p_callback) {
+		//what is resident now is the least the texture will ever stream out to
+		tex->stream_min_size = MAX(tex->width, tex->height);
+		tex->stream_size = tex->stream_min_size;
+		streamed_textures.insert(p_texture);
+	} else {
+		streamed_textures.erase(p_texture);
+	}
+}
+
+void RendererStorageRD::_update_texture_streaming() {
+	if (streamed_textures.is_empty()) {
+		return;
+	}
+
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+	bool new_window = frame >= texture_stream_window_end;
+	if (new_window) {
+		texture_stream_window_end = frame + TEXTURE_STREAM_WINDOW_FRAMES;
+	}
+
+	// Find the smallest mip that covers what was requested for each texture.
+	texture_stream_levels.resize(streamed_textures.size());
+	uint32_t index = 0;
+	for (Set<RID>::Element *E = streamed_textures.front(); E; E = E->next(), index++) {
+		Texture *tex = texture_owner.getornull(E->get());
+		uint32_t request = MAX(MAX(tex->stream_request, tex->stream_request_prev), tex->stream_min_size);
+		if (new_window) {
+			tex->stream_request_prev = tex->stream_request;
+			tex->stream_request = 0;
+		}
+
+		uint32_t size = MAX(tex->width_2d, tex->height_2d);
+		uint32_t level = 0;
+		while ((size >> (level + 1)) >= request) {
+			level++;
+		}
+		texture_stream_levels[index] = level;
+	}
+
+	// When over budget, drop the same amount of mips from every texture until it fits.
+	uint32_t bias = 0;
+	while (texture_stream_budget > 0 && bias < 16) {
+		uint64_t total_size = 0;
+		index = 0;
+		for (Set<RID>::Element *E = streamed_textures.front(); E; E = E->next(), index++) {
+			const Texture *tex = texture_owner.getornull(E->get());
+			uint32_t level = texture_stream_levels[index] + bias;
+			while (level > 0 && MAX(tex->width_2d >> level, tex->height_2d >> level) < int(tex->stream_min_size)) {
+				level--;
+			}
+			total_size += Image::get_image_data_size(MAX(tex->width_2d >> level, 1), MAX(tex->height_2d >> level, 1), tex->validated_format, true);
+		}
+		if (total_size <= texture_stream_budget) {
+			break;
+		}
+		bias++;
+	}
+
+	index = 0;
+	for (Set<RID>::Element *E = streamed_textures.front(); E; E = E->next(), index++) {
+		Texture *tex = texture_owner.getornull(E->get());
+		uint32_t level = texture_stream_levels[index] + bias;
+		while (level > 0 && MAX(tex->width_2d >> level, tex->height_2d >> level) < int(tex->stream_min_size)) {
+			level--;
+		}
+		uint32_t size = MAX(MAX(tex->width_2d >> level, tex->height_2d >> level), 1);
+		if (size != tex->stream_size) {
+			tex->stream_size = size;
+			tex->stream_callback(tex->stream_callback_ud, size);
+		}
+	}
+}
+
 void RendererStorageRD::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 }
 
@@ -1665,6 +1765,22 @@ bool RendererStorageRD::material_casts_shadows(RID p_material) {
 	return true; //by default everything casts shadows
 }
 
+void RendererStorageRD::material_request_texture_stream(RID p_material, uint32_t p_size) {
+	Material *material = material_owner.getornull(p_material);
+	ERR_FAIL_COND(!material);
+	if (material->data) {
+		for (uint32_t i = 0; i < material->data->used_textures.size(); i++) {
+			Texture *tex = texture_owner.getornull(material->data->used_textures[i]);
+			if (tex && tex->stream_callback && p_size > tex->stream_request) {
+				tex->stream_request = p_size;
+			}
+		}
+	}
+	if (material->next_pass.is_valid()) {
+		material_request_texture_stream(material->next_pass, p_size);
+	}
+}
+
 void RendererStorageRD::material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) {
 	Material *material = material_owner.getornull(p_material);
 	ERR_FAIL_COND(!material);
@@ -2240,6 +2356,7 @@ void RendererStorageRD::MaterialData::update_textures(const Map<StringName, Vari
 
 	bool uses_global_textures = false;
 	global_textures_pass++;
+	used_textures.clear();
 
 	for (int i = 0; i < p_texture_uniforms.size(); i++) {
 		const StringName &uniform_name = p_texture_uniforms[i].name;
@@ -2313,6 +2430,7 @@ void RendererStorageRD::MaterialData::update_textures(const Map<StringName, Vari
 
 			if (tex) {
 				rd_texture = (srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
+				used_textures.push_back(texture);
 #ifdef TOOLS_ENABLED
 				if (tex->detect_3d_callback && p_use_linear_color) {
 					tex->detect_3d_callback(tex->detect_3d_callback_ud);
@@ -2616,12 +2734,28 @@ void RendererStorageRD::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_su
 
 	bool use_as_storage = (p_surface.skin_data.size() || mesh->blend_shape_count > 0);
 
-	s->vertex_buffer = RD::get_singleton()->vertex_buffer_create(p_surface.vertex_data.size(), p_surface.vertex_data, use_as_storage);
-	s->vertex_buffer_size = p_surface.vertex_data.size();
+	if (mesh_upload_deferred && !use_as_storage) {
+		// Surfaces processed by the skeleton shader need their buffers right away,
+		// everything else waits in the upload file until it is first drawn.
+		s->upload = memnew(Mesh::Surface::Upload);
+		s->upload->vertex_data = _mesh_upload_store(p_surface.vertex_data);
+		s->upload->attribute_data = _mesh_upload_store(p_surface.attribute_data);
+		s->upload->index_data = _mesh_upload_store(p_surface.index_data);
+		for (int i = 0; i < p_surface.lods.size(); i++) {
+			s->upload->lod_index_data.push_back(_mesh_upload_store(p_surface.lods[i].index_data));
+		}
+		s->upload->resident_lod = p_surface.index_count ? p_surface.lods.size() + 1 : 0;
+		s->upload->requested_lod = s->upload->resident_lod;
+		mesh_upload_file_users++;
+	} else {
+		s->vertex_buffer = RD::get_singleton()->vertex_buffer_create(p_surface.vertex_data.size(), p_surface.vertex_data, use_as_storage);
 
-	if (p_surface.attribute_data.size()) {
-		s->attribute_buffer = RD::get_singleton()->vertex_buffer_create(p_surface.attribute_data.size(), p_surface.attribute_data);
+		if (p_surface.attribute_data.size()) {
+			s->attribute_buffer = RD::get_singleton()->vertex_buffer_create(p_surface.attribute_data.size(), p_surface.attribute_data);
+		}
 	}
+	s->vertex_buffer_size = p_surface.vertex_data.size();
+
 	if (p_surface.skin_data.size()) {
 		s->skin_buffer = RD::get_singleton()->vertex_buffer_create(p_surface.skin_data.size(), p_surface.skin_data, use_as_storage);
 		s->skin_buffer_size = p_surface.skin_data.size();
@@ -2633,7 +2767,19 @@ void RendererStorageRD::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_su
 		mesh->has_bone_weights = true;
 	}
 
-	if (p_surface.index_count) {
+	if (p_surface.index_count && s->upload) {
+		s->index_count = p_surface.index_count;
+		if (p_surface.lods.size()) {
+			s->lods = memnew_arr(Mesh::Surface::LOD, p_surface.lods.size());
+			s->lod_count = p_surface.lods.size();
+
+			uint32_t index_size = p_surface.vertex_count <= 65536 ? 2 : 4;
+			for (int i = 0; i < p_surface.lods.size(); i++) {
+				s->lods[i].edge_length = p_surface.lods[i].edge_length;
+				s->lods[i].index_count = p_surface.lods[i].index_data.size() / index_size;
+			}
+		}
+	} else if (p_surface.index_count) {
 		bool is_index_16 = p_surface.vertex_count <= 65536;
 
 		s->index_buffer = RD::get_singleton()->index_buffer_create(p_surface.index_count, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.index_data, false);
@@ -2761,6 +2907,10 @@ void RendererStorageRD::mesh_surface_update_vertex_region(RID p_mesh, int p_surf
 	uint64_t data_size = p_data.size();
 	const uint8_t *r = p_data.ptr();
 
+	if (mesh->surfaces[p_surface]->upload) {
+		_mesh_surface_upload_lods(mesh->surfaces[p_surface], mesh->surfaces[p_surface]->upload->resident_lod);
+	}
+
 	RD::get_singleton()->buffer_update(mesh->surfaces[p_surface]->vertex_buffer, p_offset, data_size, r);
 }
 
@@ -2769,6 +2919,9 @@ void RendererStorageRD::mesh_surface_update_attribute_region(RID p_mesh, int p_s
 	ERR_FAIL_COND(!mesh);
 	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_surface, mesh->surface_count);
 	ERR_FAIL_COND(p_data.size() == 0);
+	if (mesh->surfaces[p_surface]->upload) {
+		_mesh_surface_upload_lods(mesh->surfaces[p_surface], mesh->surfaces[p_surface]->upload->resident_lod);
+	}
 	ERR_FAIL_COND(mesh->surfaces[p_surface]->attribute_buffer.is_null());
 	uint64_t data_size = p_data.size();
 	const uint8_t *r = p_data.ptr();
@@ -2813,6 +2966,10 @@ RS::SurfaceData RendererStorageRD::mesh_get_surface(RID p_mesh, int p_surface) c
 
 	Mesh::Surface &s = *mesh->surfaces[p_surface];
 
+	if (s.upload) {
+		_mesh_surface_upload_all(&s);
+	}
+
 	RS::SurfaceData sd;
 	sd.format = s.format;
 	sd.vertex_data = RD::get_singleton()->buffer_get_data(s.vertex_buffer);
@@ -2993,7 +3150,9 @@ void RendererStorageRD::mesh_clear(RID p_mesh) {
 	ERR_FAIL_COND(!mesh);
 	for (uint32_t i = 0; i < mesh->surface_count; i++) {
 		Mesh::Surface &s = *mesh->surfaces[i];
-		RD::get_singleton()->free(s.vertex_buffer); //clears arrays as dependency automatically, including all versions
+		if (s.vertex_buffer.is_valid()) {
+			RD::get_singleton()->free(s.vertex_buffer); //clears arrays as dependency automatically, including all versions
+		}
 		if (s.attribute_buffer.is_valid()) {
 			RD::get_singleton()->free(s.attribute_buffer);
 		}
@@ -3010,7 +3169,9 @@ void RendererStorageRD::mesh_clear(RID p_mesh) {
 
 		if (s.lod_count) {
 			for (uint32_t j = 0; j < s.lod_count; j++) {
-				RD::get_singleton()->free(s.lods[j].index_buffer);
+				if (s.lods[j].index_buffer.is_valid()) {
+					RD::get_singleton()->free(s.lods[j].index_buffer);
+				}
 			}
 			memdelete_arr(s.lods);
 		}
@@ -3019,6 +3180,13 @@ void RendererStorageRD::mesh_clear(RID p_mesh) {
 			RD::get_singleton()->free(s.blend_shape_buffer);
 		}
 
+		if (s.upload) {
+			_mesh_upload_free(&s);
+		}
+		if (s.upload_queued) {
+			mesh_upload_queue.erase(&s);
+		}
+
 		memdelete(mesh->surfaces[i]);
 	}
 	if (mesh->surfaces) {
@@ -3251,7 +3419,173 @@ void RendererStorageRD::update_mesh_instances() {
 	RD::get_singleton()->compute_list_end();
 }
 
+RendererStorageRD::Mesh::Surface::Upload::Block RendererStorageRD::_mesh_upload_store(const Vector<uint8_t> &p_data) {
+	Mesh::Surface::Upload::Block block;
+	block.offset = mesh_upload_file_end;
+	block.size = p_data.size();
+	if (block.size) {
+		mesh_upload_file->seek(block.offset);
+		mesh_upload_file->store_buffer(p_data.ptr(), block.size);
+		mesh_upload_file_end += block.size;
+	}
+	return block;
+}
+
+Vector<uint8_t> RendererStorageRD::_mesh_upload_load(const Mesh::Surface::Upload::Block &p_block) {
+	// Only held while the buffer is created, the file is the only copy meanwhile.
+	Vector<uint8_t> data;
+	if (p_block.size) {
+		FileAccess *f = base_singleton->mesh_upload_file;
+		data.resize(p_block.size);
+		f->seek(p_block.offset);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(data.ptrw(), p_block.size) != p_block.size, Vector<uint8_t>(), "Can't read deferred mesh data from: " + base_singleton->mesh_upload_file_path);
+	}
+	return data;
+}
+
+void RendererStorageRD::_mesh_upload_free(Mesh::Surface *s) {
+	memdelete(s->upload);
+	s->upload = nullptr;
+
+	base_singleton->mesh_upload_file_users--;
+	if (base_singleton->mesh_upload_file_users == 0) {
+		base_singleton->mesh_upload_file_end = 0;
+	}
+}
+
+uint64_t RendererStorageRD::_mesh_surface_upload_vertices(Mesh::Surface *s) {
+	Mesh::Surface::Upload *upload = s->upload;
+	uint64_t size = upload->vertex_data.size + upload->attribute_data.size;
+
+	s->vertex_buffer = RD::get_singleton()->vertex_buffer_create(upload->vertex_data.size, _mesh_upload_load(upload->vertex_data));
+	if (upload->attribute_data.size) {
+		s->attribute_buffer = RD::get_singleton()->vertex_buffer_create(upload->attribute_data.size, _mesh_upload_load(upload->attribute_data));
+	}
+	upload->vertices_resident = true;
+
+	return size;
+}
+
+uint64_t RendererStorageRD::_mesh_surface_upload_next_lod(Mesh::Surface *s) {
+	Mesh::Surface::Upload *upload = s->upload;
+	ERR_FAIL_COND_V(upload->resident_lod == 0, 0);
+
+	uint32_t lod = upload->resident_lod - 1;
+	RD::IndexBufferFormat index_format = s->vertex_count <= 65536 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32;
+	uint64_t size;
+
+	if (lod == 0) {
+		size = upload->index_data.size;
+		s->index_buffer = RD::get_singleton()->index_buffer_create(s->index_count, index_format, _mesh_upload_load(upload->index_data), false);
+		s->index_array = RD::get_singleton()->index_array_create(s->index_buffer, 0, s->index_count);
+	} else {
+		Mesh::Surface::LOD &l = s->lods[lod - 1];
+		size = upload->lod_index_data[lod - 1].size;
+		l.index_buffer = RD::get_singleton()->index_buffer_create(l.index_count, index_format, _mesh_upload_load(upload->lod_index_data[lod - 1]));
+		l.index_array = RD::get_singleton()->index_array_create(l.index_buffer, 0, l.index_count);
+	}
+
+	upload->resident_lod = lod;
+
+	return size;
+}
+
+uint64_t RendererStorageRD::_mesh_surface_upload_step(Mesh::Surface *s) {
+	uint64_t size;
+	if (!s->upload->vertices_resident) {
+		size = _mesh_surface_upload_vertices(s);
+	} else {
+		size = _mesh_surface_upload_next_lod(s);
+	}
+
+	if (s->upload->vertices_resident && s->upload->resident_lod == 0) {
+		_mesh_upload_free(s);
+	}
+
+	return size;
+}
+
+void RendererStorageRD::_mesh_surface_upload_lods(Mesh::Surface *s, uint32_t p_lod) {
+	while (s->upload && (!s->upload->vertices_resident || s->upload->resident_lod > p_lod)) {
+		_mesh_surface_upload_step(s);
+	}
+}
+
+void RendererStorageRD::_mesh_surface_upload_all(Mesh::Surface *s) {
+	_mesh_surface_upload_lods(s, 0);
+}
+
+bool RendererStorageRD::_mesh_surface_is_drawable(const Mesh::Surface *s) {
+	if (!s->upload) {
+		return true;
+	}
+	return s->upload->vertices_resident && s->upload->resident_lod <= s->lod_count;
+}
+
+bool RendererStorageRD::_mesh_surface_request_upload(Mesh::Surface *s, uint32_t &r_lod) {
+	Mesh::Surface::Upload *upload = s->upload;
+	bool drawable = _mesh_surface_is_drawable(s);
+
+	if (!drawable || r_lod < upload->resident_lod) {
+		upload->requested_lod = MIN(upload->requested_lod, r_lod);
+		if (!s->upload_queued) {
+			s->upload_queued = true;
+			mesh_upload_queue.push_back(s);
+		}
+	}
+
+	if (!drawable) {
+		return false;
+	}
+
+	r_lod = MAX(r_lod, upload->resident_lod);
+	return true;
+}
+
+void RendererStorageRD::_update_mesh_uploads() {
+	if (mesh_upload_queue.is_empty()) {
+		return;
+	}
+
+	// Two passes over the queue: first make everything that was requested drawable
+	// (vertices and coarsest LOD), then refine towards the requested LOD, so full
+	// detail index buffers are the last thing to take up the budget.
+	uint64_t uploaded = 0;
+	for (uint32_t pass = 0; pass < 2; pass++) {
+		for (uint32_t i = 0; i < mesh_upload_queue.size(); i++) {
+			Mesh::Surface *s = mesh_upload_queue[i];
+			while (s->upload) {
+				if (uploaded > 0 && uploaded >= mesh_upload_budget) {
+					break;
+				}
+				if (pass == 0 && _mesh_surface_is_drawable(s)) {
+					break;
+				}
+				if (pass == 1 && s->upload->vertices_resident && s->upload->resident_lod <= s->upload->requested_lod) {
+					break;
+				}
+				uploaded += _mesh_surface_upload_step(s);
+			}
+		}
+	}
+
+	uint32_t i = 0;
+	while (i < mesh_upload_queue.size()) {
+		Mesh::Surface *s = mesh_upload_queue[i];
+		if (!s->upload || (s->upload->vertices_resident && s->upload->resident_lod <= s->upload->requested_lod)) {
+			s->upload_queued = false;
+			mesh_upload_queue.remove(i);
+		} else {
+			i++;
+		}
+	}
+}
+
 void RendererStorageRD::_mesh_surface_generate_version_for_input_mask(Mesh::Surface::Version &v, Mesh::Surface *s, uint32_t p_input_mask, MeshInstance::Surface *mis) {
+	if (s->upload && !s->upload->vertices_resident) {
+		_mesh_surface_upload_step(s);
+	}
+
 	Vector<RD::VertexAttribute> attributes;
 	Vector<RID> buffers;
 
@@ -3937,6 +4271,75 @@ AABB RendererStorageRD::multimesh_get_aabb(RID p_multimesh) const {
 	return multimesh->aabb;
 }
 
+RID RendererStorageRD::multimesh_get_cull_uniform_set(RID p_multimesh, RID p_dst_buffer, RID p_args_buffer) {
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND_V(!multimesh, RID());
+	ERR_FAIL_COND_V(multimesh->buffer.is_null(), RID());
+
+	Vector<RD::Uniform> uniforms;
+	{
+		RD::Uniform u;
+		u.binding = 1;
+		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+		u.ids.push_back(multimesh->buffer);
+		uniforms.push_back(u);
+	}
+	{
+		RD::Uniform u;
+		u.binding = 2;
+		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+		u.ids.push_back(p_dst_buffer);
+		uniforms.push_back(u);
+	}
+	{
+		RD::Uniform u;
+		u.binding = 3;
+		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+		u.ids.push_back(p_args_buffer);
+		uniforms.push_back(u);
+	}
+
+	return RD::get_singleton()->uniform_set_create(uniforms, multimesh_cull_shader.version_shader, 0);
+}
+
+void RendererStorageRD::multimesh_cull(RD::ComputeListID p_compute_list, RID p_multimesh, RID p_cull_uniform_set, const Transform3D &p_transform, const Vector<Plane> &p_planes) {
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(p_planes.size() != 6);
+
+	uint32_t instances = multimesh->visible_instances >= 0 ? multimesh->visible_instances : multimesh->instances;
+	if (instances == 0 || multimesh->mesh.is_null()) {
+		return;
+	}
+
+	MultiMeshCullShader::PushConstant push_constant;
+
+	//planes are moved to the local space of the multimesh, so instance transforms can be tested as they are stored
+	for (int i = 0; i < 6; i++) {
+		const Plane &p = p_planes[i];
+		Vector3 normal = p_transform.basis.xform_inv(p.normal);
+		push_constant.planes[i][0] = normal.x;
+		push_constant.planes[i][1] = normal.y;
+		push_constant.planes[i][2] = normal.z;
+		push_constant.planes[i][3] = p.d - p.normal.dot(p_transform.origin);
+	}
+
+	AABB aabb = mesh_get_aabb(multimesh->mesh, RID());
+	Vector3 half_size = aabb.size * 0.5;
+	Vector3 center = aabb.position + half_size;
+	for (int i = 0; i < 3; i++) {
+		push_constant.aabb_center[i] = center[i];
+		push_constant.aabb_half_size[i] = half_size[i];
+	}
+	push_constant.instance_count = instances;
+	push_constant.stride = multimesh->stride_cache / 4;
+
+	RD::get_singleton()->compute_list_bind_compute_pipeline(p_compute_list, multimesh_cull_shader.pipeline);
+	RD::get_singleton()->compute_list_bind_uniform_set(p_compute_list, p_cull_uniform_set, 0);
+	RD::get_singleton()->compute_list_set_push_constant(p_compute_list, &push_constant, sizeof(MultiMeshCullShader::PushConstant));
+	RD::get_singleton()->compute_list_dispatch_threads(p_compute_list, instances, 1, 1);
+}
+
 void RendererStorageRD::_update_dirty_multimeshes() {
 	while (multimesh_dirty_list) {
 		MultiMesh *multimesh = multimesh_dirty_list;
@@ -8615,6 +9018,8 @@ void RendererStorageRD::update_dirty_resources() {
 	_update_dirty_multimeshes();
 	_update_dirty_skeletons();
 	_update_decal_atlas();
+	_update_texture_streaming();
+	_update_mesh_uploads();
 }
 
 bool RendererStorageRD::has_os_feature(const String &p_feature) const {
@@ -8668,6 +9073,10 @@ bool RendererStorageRD::free(RID p_rid) {
 			//there is not much a point of making it dirty, just let it be.
 		}
 
+		if (t->stream_callback) {
+			streamed_textures.erase(p_rid);
+		}
+
 		for (int i = 0; i < t->proxies.size(); i++) {
 			Texture *p = texture_owner.getornull(t->proxies[i]);
 			ERR_CONTINUE(!p);
@@ -9318,6 +9727,19 @@ RendererStorageRD::RendererStorageRD() {
 
 	lightmap_probe_capture_update_speed = GLOBAL_GET("rendering/lightmapping/probe_capture/update_speed");
 
+	texture_stream_budget = uint64_t(int(GLOBAL_GET("rendering/textures/streaming/memory_budget_mb"))) * 1024 * 1024;
+
+	mesh_upload_deferred = GLOBAL_GET("rendering/meshes/streaming/deferred_upload");
+	mesh_upload_budget = uint64_t(int(GLOBAL_GET("rendering/meshes/streaming/upload_budget_per_frame_kb"))) * 1024;
+	if (mesh_upload_deferred) {
+		mesh_upload_file_path = OS::get_singleton()->get_cache_path().plus_file("godot_mesh_upload_" + itos(OS::get_singleton()->get_process_id()) + ".tmp");
+		mesh_upload_file = FileAccess::open(mesh_upload_file_path, FileAccess::WRITE_READ);
+		if (!mesh_upload_file) {
+			WARN_PRINT("Can't create the deferred mesh upload file, meshes will be uploaded right away: " + mesh_upload_file_path);
+			mesh_upload_deferred = false;
+		}
+	}
+
 	/* Particles */
 
 	{
@@ -9489,6 +9911,15 @@ RendererStorageRD::RendererStorageRD() {
 			skeleton_shader.default_skeleton_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, skeleton_shader.version_shader[0], SkeletonShader::UNIFORM_SET_SKELETON);
 		}
 	}
+	{
+		Vector<String> cull_modes;
+		cull_modes.push_back("");
+
+		multimesh_cull_shader.shader.initialize(cull_modes);
+		multimesh_cull_shader.version = multimesh_cull_shader.shader.version_create();
+		multimesh_cull_shader.version_shader = multimesh_cull_shader.shader.version_get_shader(multimesh_cull_shader.version, 0);
+		multimesh_cull_shader.pipeline = RD::get_singleton()->compute_pipeline_create(multimesh_cull_shader.version_shader);
+	}
 }
 
 RendererStorageRD::~RendererStorageRD() {
@@ -9519,6 +9950,7 @@ RendererStorageRD::~RendererStorageRD() {
 	rt_sdf.shader.version_free(rt_sdf.shader_version);
 
 	skeleton_shader.shader.version_free(skeleton_shader.version);
+	multimesh_cull_shader.shader.version_free(multimesh_cull_shader.version);
 
 	RenderingServer::get_singleton()->free(particles_shader.default_material);
 	RenderingServer::get_singleton()->free(particles_shader.default_shader);
@@ -9532,4 +9964,10 @@ RendererStorageRD::~RendererStorageRD() {
 	if (decal_atlas.texture.is_valid()) {
 		RD::get_singleton()->free(decal_atlas.texture);
 	}
+
+	if (mesh_upload_file) {
+		mesh_upload_file->close();
+		memdelete(mesh_upload_file);
+		DirAccess::remove_file_or_error(mesh_upload_file_path);
+	}
 }
@@ -38,6 +38,7 @@
 #include "servers/rendering/renderer_rd/effects_rd.h"
 #include "servers/rendering/renderer_rd/shader_compiler_rd.h"
 #include "servers/rendering/renderer_rd/shaders/canvas_sdf.glsl.gen.h"
+#include "servers/rendering/renderer_rd/shaders/multimesh_cull.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/particles.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/particles_copy.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/skeleton.glsl.gen.h"
@@ -170,6 +171,8 @@ public:
 		uint64_t global_textures_pass = 0;
 		Map<StringName, uint64_t> used_global_textures;
 
+		LocalVector<RID> used_textures; // For texture streaming requests.
+
 		//internally by update_parameters_uniform_set
 		Vector<uint8_t> ubo_data;
 		RID uniform_buffer;
@@ -291,6 +294,13 @@ private:
 		RS::TextureDetectRoughnessCallback detect_roughness_callback = nullptr;
 		void *detect_roughness_callback_ud = nullptr;
 
+		RS::TextureStreamCallback stream_callback = nullptr;
+		void *stream_callback_ud = nullptr;
+		uint32_t stream_min_size = 0; // Size resident when streaming started, never go below it.
+		uint32_t stream_size = 0; // Last size passed to the callback.
+		uint32_t stream_request = 0; // Largest size requested in the current window.
+		uint32_t stream_request_prev = 0; // Largest size requested in the previous window.
+
 		CanvasTexture *canvas_texture = nullptr;
 	};
 
@@ -316,6 +326,15 @@ private:
 
 	Ref<Image> _validate_texture_format(const Ref<Image> &p_image, TextureToRDFormat &r_format);
 
+	/* TEXTURE STREAMING */
+
+	Set<RID> streamed_textures;
+	uint64_t texture_stream_budget = 0;
+	uint64_t texture_stream_window_end = 0;
+	LocalVector<uint32_t> texture_stream_levels;
+
+	void _update_texture_streaming();
+
 	RID default_rd_textures[DEFAULT_RD_TEXTURE_MAX];
 	RID default_rd_samplers[RS::CANVAS_ITEM_TEXTURE_FILTER_MAX][RS::CANVAS_ITEM_TEXTURE_REPEAT_MAX];
 	RID default_rd_storage_buffer;
@@ -473,6 +492,26 @@ private:
 			uint64_t particles_render_pass = 0;
 
 			RID uniform_set;
+
+			// When uploads are deferred, the surface data is written to the mesh upload file
+			// until it is first drawn, and is then read back and moved to VRAM a part at a time:
+			// vertices first, then index LODs from coarsest to finest.
+			struct Upload {
+				struct Block {
+					uint64_t offset = 0;
+					uint64_t size = 0;
+				};
+				Block vertex_data;
+				Block attribute_data;
+				Block index_data;
+				LocalVector<Block> lod_index_data;
+				bool vertices_resident = false;
+				uint32_t resident_lod = 0; // Finest LOD in VRAM (lod_count + 1 if none yet).
+				uint32_t requested_lod = 0;
+			};
+
+			Upload *upload = nullptr;
+			bool upload_queued = false;
 		};
 
 		uint32_t blend_shape_count = 0;
@@ -571,6 +610,30 @@ private:
 
 	void _mesh_surface_generate_version_for_input_mask(Mesh::Surface::Version &v, Mesh::Surface *s, uint32_t p_input_mask, MeshInstance::Surface *mis = nullptr);
 
+	bool mesh_upload_deferred = false;
+	uint64_t mesh_upload_budget = 0;
+	LocalVector<Mesh::Surface *> mesh_upload_queue;
+
+	// Pending surface data is kept in a temporary file rather than in system memory.
+	// Space is reused once no surface has data left in it.
+	FileAccess *mesh_upload_file = nullptr;
+	String mesh_upload_file_path;
+	uint64_t mesh_upload_file_end = 0;
+	uint32_t mesh_upload_file_users = 0;
+
+	Mesh::Surface::Upload::Block _mesh_upload_store(const Vector<uint8_t> &p_data);
+	static Vector<uint8_t> _mesh_upload_load(const Mesh::Surface::Upload::Block &p_block);
+	static void _mesh_upload_free(Mesh::Surface *s);
+
+	static uint64_t _mesh_surface_upload_vertices(Mesh::Surface *s);
+	static uint64_t _mesh_surface_upload_next_lod(Mesh::Surface *s);
+	static uint64_t _mesh_surface_upload_step(Mesh::Surface *s);
+	static void _mesh_surface_upload_lods(Mesh::Surface *s, uint32_t p_lod);
+	static void _mesh_surface_upload_all(Mesh::Surface *s);
+	static bool _mesh_surface_is_drawable(const Mesh::Surface *s);
+	bool _mesh_surface_request_upload(Mesh::Surface *s, uint32_t &r_lod);
+	void _update_mesh_uploads();
+
 	RID mesh_default_rd_buffers[DEFAULT_RD_BUFFER_MAX];
 
 	/* MultiMesh */
@@ -612,6 +675,23 @@ private:
 	_FORCE_INLINE_ void _multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances);
 	void _update_dirty_multimeshes();
 
+	struct MultiMeshCullShader {
+		struct PushConstant {
+			float planes[6][4];
+
+			float aabb_center[3];
+			uint32_t instance_count;
+
+			float aabb_half_size[3];
+			uint32_t stride;
+		};
+
+		MultimeshCullShaderRD shader;
+		RID version;
+		RID version_shader;
+		RID pipeline;
+	} multimesh_cull_shader;
+
 	/* PARTICLES */
 
 	struct ParticleData {
@@ -1328,6 +1408,7 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata);
+	virtual void texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata);
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info);
 
@@ -1431,6 +1512,7 @@ public:
 	void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters);
 
 	void material_update_dependency(RID p_material, DependencyTracker *p_instance);
+	void material_request_texture_stream(RID p_material, uint32_t p_size);
 	void material_force_update_textures(RID p_material, ShaderType p_shader_type);
 
 	void material_set_data_request_function(ShaderType p_shader_type, MaterialDataRequestFunction p_function);
@@ -1564,9 +1646,23 @@ public:
 		}
 	}
 
+	// Returns false if the surface can't be drawn yet because its upload is still pending,
+	// otherwise clamps r_lod to the finest LOD already in VRAM.
+	_FORCE_INLINE_ bool mesh_surface_request_lod(void *p_surface, uint32_t &r_lod) {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+		if (likely(!s->upload)) {
+			return true;
+		}
+		return _mesh_surface_request_upload(s, r_lod);
+	}
+
 	_FORCE_INLINE_ RID mesh_surface_get_index_array(void *p_surface, uint32_t p_lod) const {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 
+		if (unlikely(s->upload)) {
+			_mesh_surface_upload_lods(s, p_lod);
+		}
+
 		if (p_lod == 0) {
 			return s->index_array;
 		} else {
@@ -1574,6 +1670,18 @@ public:
 		}
 	}
 
+	_FORCE_INLINE_ uint32_t mesh_surface_get_draw_count(void *p_surface, uint32_t p_lod) const {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+
+		if (s->index_count == 0) {
+			return s->vertex_count;
+		} else if (p_lod == 0) {
+			return s->index_count;
+		} else {
+			return s->lods[p_lod - 1].index_count;
+		}
+	}
+
 	_FORCE_INLINE_ void mesh_surface_get_vertex_arrays_and_format(void *p_surface, uint32_t p_input_mask, RID &r_vertex_array_rd, RD::VertexFormatID &r_vertex_format) {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 
@@ -1766,6 +1874,16 @@ public:
 		return multimesh->uniform_set_2d;
 	}
 
+	_FORCE_INLINE_ uint32_t multimesh_get_stride(RID p_multimesh) const {
+		MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+		return multimesh->stride_cache;
+	}
+
+	// GPU culling copies the instances that pass the frustum test into p_dst_buffer and
+	// counts them into the instance count of every indirect draw command in p_args_buffer.
+	RID multimesh_get_cull_uniform_set(RID p_multimesh, RID p_dst_buffer, RID p_args_buffer);
+	void multimesh_cull(RD::ComputeListID p_compute_list, RID p_multimesh, RID p_cull_uniform_set, const Transform3D &p_transform, const Vector<Plane> &p_planes);
+
 	/* SKELETON API */
 
 	RID skeleton_allocate();
@@ -33,6 +33,9 @@
 #include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/marshalls.h"
+#include "pipeline_cache_rd.h"
 #include "renderer_compositor_rd.h"
 #include "servers/rendering/rendering_device.h"
 #include "thirdparty/misc/smolv.h"
@@ -144,6 +147,8 @@ void ShaderRD::_clear_version(Version *p_version) {
 	//clear versions if they exist
 	if (p_version->variants) {
 		for (int i = 0; i < variant_defines.size(); i++) {
+			// Pipelines may still be queued for compilation with this variant.
+			PipelineCacheRD::cancel_compiles(p_version->variants[i]);
 			RD::get_singleton()->free(p_version->variants[i]);
 		}
 
@@ -366,17 +371,7 @@ String ShaderRD::_version_get_sha1(Version *p_version) const {
 static const char *shader_file_header = "GDSC";
 static const uint32_t cache_file_version = 1;
 
-bool ShaderRD::_load_from_cache(Version *p_version) {
-	String sha1 = _version_get_sha1(p_version);
-	String path = shader_cache_dir.plus_file(name).plus_file(base_sha256).plus_file(sha1) + ".cache";
-
-	uint64_t time_from = OS::get_singleton()->get_ticks_usec();
-
-	FileAccessRef f = FileAccess::open(path, FileAccess::READ);
-	if (!f) {
-		return false;
-	}
-
+bool ShaderRD::_read_cache(FileAccess *f, CacheLoad &r_load) {
 	char header[5] = { 0, 0, 0, 0, 0 };
 	f->get_buffer((uint8_t *)header, 4);
 	ERR_FAIL_COND_V(header != String(shader_file_header), false);
@@ -390,57 +385,118 @@ bool ShaderRD::_load_from_cache(Version *p_version) {
 
 	ERR_FAIL_COND_V(variant_count != (uint32_t)variant_defines.size(), false); //should not happen but check
 
-	bool success = true;
+	r_load.variants.resize(variant_count);
 	for (uint32_t i = 0; i < variant_count; i++) {
 		uint32_t stage_count = f->get_32();
-		p_version->variant_stages[i].resize(stage_count);
+		ERR_FAIL_COND_V(stage_count > RD::SHADER_STAGE_MAX, false);
+
+		r_load.variants[i].resize(stage_count);
 		for (uint32_t j = 0; j < stage_count; j++) {
-			p_version->variant_stages[i].write[j].shader_stage = RD::ShaderStage(f->get_32());
+			CacheStage &stage = r_load.variants[i][j];
+			stage.shader_stage = RD::ShaderStage(f->get_32());
+			stage.compression = f->get_32();
+			stage.length = f->get_32();
+
+			// Zstd compressed smolv stores the size of the compressed buffer after the smolv size.
+			uint32_t data_size = stage.compression == 2 ? f->get_32() : stage.length;
+			stage.data.resize(data_size);
+			if (f->get_buffer(stage.data.ptrw(), data_size) != data_size) {
+				ERR_PRINT("Truncated shader cache for " + name + ", variant #" + itos(i) + " stage :" + itos(j));
+				return false;
+			}
+		}
+	}
 
-			int compression = f->get_32();
-			uint32_t length = f->get_32();
+	return true;
+}
 
-			if (compression == 0) {
-				Vector<uint8_t> data;
-				data.resize(length);
+void ShaderRD::_load_variant_from_cache(uint32_t p_variant, CacheLoad *p_load) {
+	if (!variants_enabled[p_variant]) {
+		return; //variant is disabled, return
+	}
 
-				f->get_buffer(data.ptrw(), length);
+	const LocalVector<CacheStage> &cached_stages = p_load->variants[p_variant];
+	Vector<RD::ShaderStageData> &stages = p_load->version->variant_stages[p_variant];
+	stages.resize(cached_stages.size());
 
-				p_version->variant_stages[i].write[j].spir_v = data;
-			} else {
-				Vector<uint8_t> data;
+	for (uint32_t i = 0; i < cached_stages.size(); i++) {
+		const CacheStage &cached = cached_stages[i];
+		stages.write[i].shader_stage = cached.shader_stage;
 
-				if (compression == 2) {
-					//zstd
-					int smol_length = f->get_32();
-					Vector<uint8_t> zstd_data;
+		if (cached.compression == 0) {
+			stages.write[i].spir_v = cached.data;
+			continue;
+		}
 
-					zstd_data.resize(smol_length);
-					f->get_buffer(zstd_data.ptrw(), smol_length);
+		Vector<uint8_t> data;
+		if (cached.compression == 2) {
+			//zstd
+			data.resize(cached.length);
+			if (Compression::decompress(data.ptrw(), data.size(), cached.data.ptr(), cached.data.size(), Compression::MODE_ZSTD) != (int)cached.length) {
+				ERR_PRINT("Malformed zstd input uncompressing shader " + name + ", variant #" + itos(p_variant) + " stage :" + itos(i));
+				p_load->failed.set();
+				return;
+			}
+		} else {
+			data = cached.data;
+		}
 
-					data.resize(length);
-					Compression::decompress(data.ptrw(), data.size(), zstd_data.ptr(), zstd_data.size(), Compression::MODE_ZSTD);
+		Vector<uint8_t> spirv;
+		uint32_t spirv_size = smolv::GetDecodedBufferSize(data.ptr(), data.size());
+		spirv.resize(spirv_size);
+		if (!smolv::Decode(data.ptr(), data.size(), spirv.ptrw(), spirv_size)) {
+			ERR_PRINT("Malformed smolv input uncompressing shader " + name + ", variant #" + itos(p_variant) + " stage :" + itos(i));
+			p_load->failed.set();
+			return;
+		}
+		stages.write[i].spir_v = spirv;
+	}
 
-				} else {
-					data.resize(length);
-					f->get_buffer(data.ptrw(), length);
-				}
+	RID shader = RD::get_singleton()->shader_create(stages);
+	{
+		MutexLock lock(variant_set_mutex);
+		p_load->version->variants[p_variant] = shader;
+	}
+}
 
-				Vector<uint8_t> spirv;
-				uint32_t spirv_size = smolv::GetDecodedBufferSize(data.ptr(), data.size());
-				spirv.resize(spirv_size);
-				if (!smolv::Decode(data.ptr(), data.size(), spirv.ptrw(), spirv_size)) {
-					ERR_PRINT("Malformed smolv input uncompressing shader " + name + ", variant #" + itos(i) + " stage :" + itos(j));
-					success = false;
-					break;
-				}
-				p_version->variant_stages[i].write[j].spir_v = spirv;
-			}
+bool ShaderRD::_load_from_cache(Version *p_version) {
+	String sha1 = _version_get_sha1(p_version);
+	String key = name.plus_file(base_sha256).plus_file(sha1);
+	String path = shader_cache_dir.plus_file(key) + ".cache";
+
+	uint64_t time_from = OS::get_singleton()->get_ticks_usec();
+
+	CacheLoad load;
+	load.version = p_version;
+
+	FileAccessRef f = shader_cache_dir_valid ? FileAccess::open(path, FileAccess::READ) : nullptr;
+	if (f) {
+		if (!_read_cache(f, load)) {
+			return false;
+		}
+	} else {
+		// Fall back to the prebuilt pack, which is only read and never written to.
+		const Vector<uint8_t> *packed = shader_cache_pack.getptr(key);
+		if (!packed) {
+			return false;
+		}
+		path = "shader cache pack: " + key;
+		FileAccessMemory packed_file;
+		packed_file.open_custom(packed->ptr(), packed->size());
+		if (!_read_cache(&packed_file, load)) {
+			return false;
 		}
 	}
 
-	if (!success) {
-		for (uint32_t i = 0; i < variant_count; i++) {
+	// Decoding and creating the variants is independent, spread it over the pool like compilation.
+	RendererThreadPool::singleton->thread_work_pool.do_work(load.variants.size(), this, &ShaderRD::_load_variant_from_cache, &load);
+
+	if (load.failed.is_set()) {
+		for (int i = 0; i < variant_defines.size(); i++) {
+			if (p_version->variants[i].is_valid()) {
+				RD::get_singleton()->free(p_version->variants[i]);
+				p_version->variants[i] = RID();
+			}
 			p_version->variant_stages[i].resize(0);
 		}
 		return false;
@@ -450,14 +506,6 @@ bool ShaderRD::_load_from_cache(Version *p_version) {
 
 	print_verbose("Shader cache load success '" + path + "' " + rtos(time_ms) + "ms.");
 
-	for (uint32_t i = 0; i < variant_count; i++) {
-		RID shader = RD::get_singleton()->shader_create(p_version->variant_stages[i]);
-		{
-			MutexLock lock(variant_set_mutex);
-			p_version->variants[i] = shader;
-		}
-	}
-
 	memdelete_arr(p_version->variant_stages); //clear stages
 	p_version->variant_stages = nullptr;
 	p_version->valid = true;
@@ -534,7 +582,7 @@ void ShaderRD::_compile_version(Version *p_version) {
 	typedef Vector<RD::ShaderStageData> ShaderStageArray;
 	p_version->variant_stages = memnew_arr(ShaderStageArray, variant_defines.size());
 
-	if (shader_cache_dir_valid) {
+	if (shader_cache_dir_valid || shader_cache_pack.size()) {
 		if (_load_from_cache(p_version)) {
 			return;
 		}
@@ -702,20 +750,21 @@ void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String
 		variants_enabled.push_back(true);
 	}
 
-	if (shader_cache_dir != String()) {
-		StringBuilder hash_build;
+	// Always hashed, as the prebuilt cache pack can be used even with the cache dir disabled.
+	StringBuilder hash_build;
 
-		hash_build.append("[base_hash]");
-		hash_build.append(base_sha256);
-		hash_build.append("[general_defines]");
-		hash_build.append(general_defines.get_data());
-		for (int i = 0; i < variant_defines.size(); i++) {
-			hash_build.append("[variant_defines:" + itos(i) + "]");
-			hash_build.append(variant_defines[i].get_data());
-		}
+	hash_build.append("[base_hash]");
+	hash_build.append(base_sha256);
+	hash_build.append("[general_defines]");
+	hash_build.append(general_defines.get_data());
+	for (int i = 0; i < variant_defines.size(); i++) {
+		hash_build.append("[variant_defines:" + itos(i) + "]");
+		hash_build.append(variant_defines[i].get_data());
+	}
 
-		base_sha256 = hash_build.as_string().sha256_text();
+	base_sha256 = hash_build.as_string().sha256_text();
 
+	if (shader_cache_dir != String()) {
 		DirAccessRef d = DirAccess::open(shader_cache_dir);
 		ERR_FAIL_COND(!d);
 		if (d->change_dir(name) != OK) {
@@ -754,6 +803,134 @@ void ShaderRD::set_shader_cache_save_debug(bool p_enable) {
 	shader_cache_save_debug = p_enable;
 }
 
+static const char *shader_pack_header = "GDSP";
+static const uint32_t cache_pack_version = 1;
+
+Vector<uint8_t> ShaderRD::build_shader_cache_pack(const String &p_cache_dir) {
+	// Cache files are laid out as <shader name>/<base hash>/<version hash>.cache.
+	List<String> keys;
+	DirAccessRef shaders_dir = DirAccess::open(p_cache_dir);
+	ERR_FAIL_COND_V_MSG(!shaders_dir, Vector<uint8_t>(), "Can't open shader cache dir: " + p_cache_dir);
+
+	shaders_dir->list_dir_begin();
+	for (String shader = shaders_dir->get_next(); shader != String(); shader = shaders_dir->get_next()) {
+		if (!shaders_dir->current_is_dir() || shader.begins_with(".")) {
+			continue;
+		}
+		DirAccessRef bases_dir = DirAccess::open(p_cache_dir.plus_file(shader));
+		if (!bases_dir) {
+			continue;
+		}
+		bases_dir->list_dir_begin();
+		for (String base = bases_dir->get_next(); base != String(); base = bases_dir->get_next()) {
+			if (!bases_dir->current_is_dir() || base.begins_with(".")) {
+				continue;
+			}
+			DirAccessRef versions_dir = DirAccess::open(p_cache_dir.plus_file(shader).plus_file(base));
+			if (!versions_dir) {
+				continue;
+			}
+			versions_dir->list_dir_begin();
+			for (String version = versions_dir->get_next(); version != String(); version = versions_dir->get_next()) {
+				if (!versions_dir->current_is_dir() && version.get_extension() == "cache") {
+					keys.push_back(shader.plus_file(base).plus_file(version.get_basename()));
+				}
+			}
+			versions_dir->list_dir_end();
+		}
+		bases_dir->list_dir_end();
+	}
+	shaders_dir->list_dir_end();
+
+	keys.sort();
+
+	List<CharString> entry_keys;
+	List<Vector<uint8_t>> entry_data;
+	uint64_t size = 12;
+	for (List<String>::Element *E = keys.front(); E; E = E->next()) {
+		Vector<uint8_t> data = FileAccess::get_file_as_array(p_cache_dir.plus_file(E->get()) + ".cache");
+		if (data.size() < 12 || memcmp(data.ptr(), shader_file_header, 4) != 0) {
+			continue;
+		}
+		entry_keys.push_back(E->get().utf8());
+		entry_data.push_back(data);
+		size += 8 + entry_keys.back()->get().length() + data.size();
+	}
+
+	Vector<uint8_t> pack;
+	pack.resize(size);
+
+	FileAccessMemory f;
+	f.open_custom(pack.ptrw(), pack.size());
+	f.store_buffer((const uint8_t *)shader_pack_header, 4);
+	f.store_32(cache_pack_version);
+	f.store_32(entry_keys.size());
+
+	List<Vector<uint8_t>>::Element *D = entry_data.front();
+	for (List<CharString>::Element *E = entry_keys.front(); E; E = E->next(), D = D->next()) {
+		f.store_32(E->get().length());
+		f.store_buffer((const uint8_t *)E->get().get_data(), E->get().length());
+		f.store_32(D->get().size());
+		f.store_buffer(D->get().ptr(), D->get().size());
+	}
+	f.close();
+
+	print_verbose("Built shader cache pack with " + itos(entry_keys.size()) + " entries, " + String::humanize_size(pack.size()) + ".");
+	return pack;
+}
+
+Error ShaderRD::load_shader_cache_pack(const String &p_path) {
+	uint64_t time_from = OS::get_singleton()->get_ticks_usec();
+
+	// Read at once, entries are validated and only copied out of the buffer.
+	Error err;
+	Vector<uint8_t> pack = FileAccess::get_file_as_array(p_path, &err);
+	if (err != OK) {
+		return err;
+	}
+
+	FileAccessMemory f;
+	f.open_custom(pack.ptr(), pack.size());
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f.get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V_MSG(header != String(shader_pack_header), ERR_FILE_UNRECOGNIZED, "Invalid shader cache pack: " + p_path);
+
+	if (f.get_32() != cache_pack_version) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	uint32_t count = f.get_32();
+	uint32_t loaded = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t key_length = f.get_32();
+		ERR_FAIL_COND_V_MSG(f.get_position() + key_length > f.get_length(), ERR_FILE_CORRUPT, "Truncated shader cache pack: " + p_path);
+		CharString key;
+		key.resize(key_length + 1);
+		f.get_buffer((uint8_t *)key.ptrw(), key_length);
+		key[key_length] = 0;
+
+		uint32_t data_length = f.get_32();
+		ERR_FAIL_COND_V_MSG(f.get_position() + data_length > f.get_length(), ERR_FILE_CORRUPT, "Truncated shader cache pack: " + p_path);
+		Vector<uint8_t> data;
+		data.resize(data_length);
+		f.get_buffer(data.ptrw(), data_length);
+
+		// Entries from other cache file versions would fail to load anyway, don't keep them around.
+		if (data_length < 12 || memcmp(data.ptr(), shader_file_header, 4) != 0 || decode_uint32(data.ptr() + 4) != cache_file_version) {
+			continue;
+		}
+
+		shader_cache_pack[String::utf8(key.get_data())] = data;
+		loaded++;
+	}
+
+	float time_ms = double(OS::get_singleton()->get_ticks_usec() - time_from) / 1000.0;
+	print_verbose("Shader cache pack load success '" + p_path + "', " + itos(loaded) + " of " + itos(count) + " entries usable, " + rtos(time_ms) + "ms.");
+	return OK;
+}
+
+HashMap<String, Vector<uint8_t>> ShaderRD::shader_cache_pack;
 String ShaderRD::shader_cache_dir;
 bool ShaderRD::shader_cache_save_compressed = true;
 bool ShaderRD::shader_cache_save_compressed_zstd = true;
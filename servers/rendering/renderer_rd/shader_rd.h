@@ -31,12 +31,14 @@
 #ifndef SHADER_RD_H
 #define SHADER_RD_H
 
+#include "core/io/file_access.h"
 #include "core/os/mutex.h"
 #include "core/string/string_builder.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/map.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "servers/rendering_server.h"
 
@@ -123,7 +125,25 @@ class ShaderRD {
 
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
+	// Prebuilt cache files shipped with exports, keyed by their path relative to the cache dir.
+	static HashMap<String, Vector<uint8_t>> shader_cache_pack;
+
+	struct CacheStage {
+		RD::ShaderStage shader_stage;
+		uint32_t compression = 0;
+		uint32_t length = 0;
+		Vector<uint8_t> data;
+	};
+
+	struct CacheLoad {
+		Version *version = nullptr;
+		LocalVector<LocalVector<CacheStage>> variants;
+		SafeFlag failed;
+	};
+
 	String _version_get_sha1(Version *p_version) const;
+	bool _read_cache(FileAccess *f, CacheLoad &r_load);
+	void _load_variant_from_cache(uint32_t p_variant, CacheLoad *p_load);
 	bool _load_from_cache(Version *p_version);
 	void _save_to_cache(Version *p_version);
 
@@ -167,6 +187,9 @@ public:
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
 	static void set_shader_cache_save_debug(bool p_enable);
 
+	static Vector<uint8_t> build_shader_cache_pack(const String &p_cache_dir);
+	static Error load_shader_cache_pack(const String &p_path);
+
 	RS::ShaderNativeSourceCode version_get_native_source_code(RID p_version);
 
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
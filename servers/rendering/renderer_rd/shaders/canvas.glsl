@@ -75,15 +75,33 @@ void main() {
 	vec2 vertex_base_arr[4] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
 	vec2 vertex_base = vertex_base_arr[gl_VertexIndex];
 
-	vec2 uv = draw_data.src_rect.xy + abs(draw_data.src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec4 src_rect = draw_data.src_rect;
+	vec4 dst_rect = draw_data.dst_rect;
 	vec4 color = draw_data.modulation;
-	vec2 vertex = draw_data.dst_rect.xy + abs(draw_data.dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(draw_data.src_rect.zw, vec2(0.0, 0.0)));
+
+	if (bool(draw_data.flags & FLAGS_BATCHED_RECTS)) {
+		uint offset = (draw_data.batch_offset + gl_InstanceIndex) * BATCH_INSTANCE_STRIDE;
+		color = transforms.data[offset + 2];
+		src_rect = transforms.data[offset + 3];
+		dst_rect = transforms.data[offset + 4];
+	}
+
+	vec2 uv = src_rect.xy + abs(src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec2 vertex = dst_rect.xy + abs(dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(src_rect.zw, vec2(0.0, 0.0)));
 	uvec4 bones = uvec4(0, 0, 0, 0);
 
 #endif
 
 	mat4 world_matrix = mat4(vec4(draw_data.world_x, 0.0, 0.0), vec4(draw_data.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(draw_data.world_ofs, 0.0, 1.0));
 
+#if !defined(USE_ATTRIBUTES) && !defined(USE_PRIMITIVE)
+	if (bool(draw_data.flags & FLAGS_BATCHED_RECTS)) {
+		uint offset = (draw_data.batch_offset + gl_InstanceIndex) * BATCH_INSTANCE_STRIDE;
+		vec4 world = transforms.data[offset];
+		world_matrix = mat4(vec4(world.xy, 0.0, 0.0), vec4(world.zw, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(transforms.data[offset + 1].xy, 0.0, 1.0));
+	}
+#endif
+
 #define FLAGS_INSTANCING_MASK 0x7F
 #define FLAGS_INSTANCING_HAS_COLORS (1 << 7)
 #define FLAGS_INSTANCING_HAS_CUSTOM_DATA (1 << 8)
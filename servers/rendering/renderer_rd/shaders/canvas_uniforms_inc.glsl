@@ -15,6 +15,7 @@
 #define FLAGS_USING_LIGHT_MASK (1 << 11)
 #define FLAGS_NINEPACH_DRAW_CENTER (1 << 12)
 #define FLAGS_USING_PARTICLES (1 << 13)
+#define FLAGS_BATCHED_RECTS (1 << 14)
 
 #define FLAGS_NINEPATCH_H_MODE_SHIFT 16
 #define FLAGS_NINEPATCH_V_MODE_SHIFT 18
@@ -54,7 +55,8 @@ layout(push_constant, binding = 0, std430) uniform DrawData {
 	vec4 ninepatch_margins;
 	vec4 dst_rect; //for built-in rect and UV
 	vec4 src_rect;
-	vec2 pad;
+	uint batch_offset; //first rect instance when batching
+	uint pad;
 
 #endif
 	vec2 color_texture_pixel_size;
@@ -145,7 +147,10 @@ global_variables;
 
 //
 
-/* SET2: Instancing and Skeleton */
+/* SET2: Instancing, Skeleton and Rect Batching */
+
+// Batched rects store world (2 vec4), modulation, src_rect and dst_rect per instance.
+#define BATCH_INSTANCE_STRIDE 5
 
 layout(set = 2, binding = 0, std430) restrict readonly buffer Transforms {
 	vec4 data[];
@@ -0,0 +1,69 @@
+#[compute]
+
+#version 450
+
+#VERSION_DEFINES
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+layout(set = 0, binding = 1, std430) buffer restrict readonly SrcInstances {
+	vec4 data[];
+}
+src_instances;
+
+layout(set = 0, binding = 2, std430) buffer restrict writeonly DstInstances {
+	vec4 data[];
+}
+dst_instances;
+
+// One VkDrawIndexedIndirectCommand (5 uints) per surface, instance count is the second one.
+layout(set = 0, binding = 3, std430) buffer restrict DrawArgs {
+	uint data[];
+}
+draw_args;
+
+layout(push_constant, binding = 0, std430) uniform Params {
+	vec4 planes[6]; // Frustum planes in multimesh local space, xyz normal and w distance.
+
+	vec3 aabb_center;
+	uint instance_count;
+
+	vec3 aabb_half_size;
+	uint stride; // In vec4s.
+}
+params;
+
+void main() {
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= params.instance_count) {
+		return;
+	}
+
+	uint src_offset = index * params.stride;
+
+	// Rows of the 3x4 instance transform, origin goes in w.
+	vec4 row0 = src_instances.data[src_offset + 0];
+	vec4 row1 = src_instances.data[src_offset + 1];
+	vec4 row2 = src_instances.data[src_offset + 2];
+
+	vec3 center = vec3(dot(row0.xyz, params.aabb_center) + row0.w, dot(row1.xyz, params.aabb_center) + row1.w, dot(row2.xyz, params.aabb_center) + row2.w);
+	vec3 extents = vec3(dot(abs(row0.xyz), params.aabb_half_size), dot(abs(row1.xyz), params.aabb_half_size), dot(abs(row2.xyz), params.aabb_half_size));
+
+	for (uint i = 0; i < 6; i++) {
+		vec4 plane = params.planes[i];
+		if (dot(plane.xyz, center) - plane.w > dot(abs(plane.xyz), extents)) {
+			return; // Fully outside this plane.
+		}
+	}
+
+	uint dst_index = atomicAdd(draw_args.data[1], 1);
+	uint draw_count = uint(draw_args.data.length()) / 5;
+	for (uint i = 1; i < draw_count; i++) {
+		atomicAdd(draw_args.data[i * 5 + 1], 1);
+	}
+
+	uint dst_offset = dst_index * params.stride;
+	for (uint i = 0; i < params.stride; i++) {
+		dst_instances.data[dst_offset + i] = src_instances.data[src_offset + i];
+	}
+}
@@ -30,13 +30,19 @@
 
 #include "renderer_scene_cull.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
+#include "renderer_scene_occlusion_cull_raster.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
 
 #include <new>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 /* CAMERA API */
 
 RID RendererSceneCull::camera_allocate() {
@@ -811,6 +817,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	instance->layer_mask = p_mask;
 	if (instance->scenario && instance->array_index >= 0) {
 		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+		instance->scenario->instance_aabbs.set_layer_mask(instance->array_index, p_mask);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -844,6 +851,19 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	_instance_queue_update(instance, true);
 }
 
+void RendererSceneCull::instance_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		if (!instance_owner.owns(instances[i])) {
+			continue; // May have been freed after it was queued.
+		}
+		instance_set_transform(instances[i], transforms[i]);
+	}
+}
+
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 	Instance *instance = instance_owner.getornull(p_instance);
 	ERR_FAIL_COND(!instance);
@@ -1193,6 +1213,19 @@ void RendererSceneCull::instance_geometry_set_visibility_range(RID p_instance, f
 	}
 }
 
+void RendererSceneCull::instance_geometry_set_visibility_range_hlod_error(RID p_instance, float p_error) {
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	instance->visibility_range_hlod_error = p_error;
+
+	_update_instance_visibility_dependencies(instance);
+
+	if (instance->scenario && instance->visibility_index != -1) {
+		instance->scenario->instance_visibility[instance->visibility_index].hlod_error = instance->visibility_range_hlod_error;
+	}
+}
+
 void RendererSceneCull::instance_set_visibility_parent(RID p_instance, RID p_parent_instance) {
 	Instance *instance = instance_owner.getornull(p_instance);
 	ERR_FAIL_COND(!instance);
@@ -1273,7 +1306,7 @@ void RendererSceneCull::_update_instance_visibility_depth(Instance *p_instance)
 
 void RendererSceneCull::_update_instance_visibility_dependencies(Instance *p_instance) {
 	bool is_geometry_instance = ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) && p_instance->base_data;
-	bool has_visibility_range = p_instance->visibility_range_begin > 0.0 || p_instance->visibility_range_end > 0.0;
+	bool has_visibility_range = p_instance->visibility_range_begin > 0.0 || p_instance->visibility_range_end > 0.0 || p_instance->visibility_range_hlod_error > 0.0;
 	bool needs_visibility_cull = has_visibility_range && is_geometry_instance && p_instance->array_index != -1;
 
 	if (!needs_visibility_cull && p_instance->visibility_index != -1) {
@@ -1286,6 +1319,7 @@ void RendererSceneCull::_update_instance_visibility_dependencies(Instance *p_ins
 		vd.range_end = p_instance->visibility_range_end;
 		vd.range_begin_margin = p_instance->visibility_range_begin_margin;
 		vd.range_end_margin = p_instance->visibility_range_end_margin;
+		vd.hlod_error = p_instance->visibility_range_hlod_error;
 		vd.position = p_instance->transformed_aabb.get_position() + p_instance->transformed_aabb.get_size() / 2.0f;
 		vd.array_index = p_instance->array_index;
 
@@ -1624,7 +1658,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 
 		p_instance->scenario->instance_data.push_back(idata);
-		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb), p_instance->layer_mask);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1632,7 +1666,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_aabbs.set(p_instance->array_index, InstanceBounds(p_instance->transformed_aabb));
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1715,7 +1749,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		Instance *swapped_instance = p_instance->scenario->instance_data[swap_with_index].instance;
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_aabbs.copy(swap_with_index, p_instance->array_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -2502,7 +2536,7 @@ void RendererSceneCull::render_camera(RID p_render_buffers, RID p_camera, RID p_
 	// For now just cull on the first camera
 	RendererSceneOcclusionCull::get_singleton()->buffer_update(p_viewport, camera_data.main_transform, camera_data.main_projection, camera_data.is_ortogonal, RendererThreadPool::singleton->thread_work_pool);
 
-	_render_scene(&camera_data, p_render_buffers, environment, camera->effects, camera->visible_layers, p_scenario, p_viewport, p_shadow_atlas, RID(), -1, p_screen_lod_threshold, true, r_render_info);
+	_render_scene(&camera_data, p_render_buffers, environment, camera->effects, camera->visible_layers, p_scenario, p_viewport, p_shadow_atlas, RID(), -1, p_screen_lod_threshold, p_viewport_size.width, true, r_render_info);
 #endif
 }
 
@@ -2529,7 +2563,7 @@ void RendererSceneCull::_visibility_cull(const VisibilityCullData &cull_data, ui
 			}
 		}
 
-		int range_check = _visibility_range_check(vd, cull_data.camera_position, cull_data.viewport_mask);
+		int range_check = _visibility_range_check(vd, cull_data.camera_position, cull_data.viewport_mask, cull_data.hlod_distance_scale);
 
 		if (range_check == -1) {
 			idata.flags |= InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN;
@@ -2544,17 +2578,50 @@ void RendererSceneCull::_visibility_cull(const VisibilityCullData &cull_data, ui
 	}
 }
 
-int RendererSceneCull::_visibility_range_check(InstanceVisibilityData &r_vis_data, const Vector3 &p_camera_pos, uint64_t p_viewport_mask) {
+void RendererSceneCull::_instance_request_texture_stream(Instance *p_instance) {
+	if (p_instance->material_override.is_valid()) {
+		RSG::storage->material_request_texture_stream(p_instance->material_override, p_instance->texture_stream_size);
+		return;
+	}
+
+	int surface_count = RSG::storage->mesh_get_surface_count(p_instance->base);
+	for (int i = 0; i < surface_count; i++) {
+		RID material = i < p_instance->materials.size() ? p_instance->materials[i] : RID();
+		if (material.is_null()) {
+			material = RSG::storage->mesh_surface_get_material(p_instance->base, i);
+		}
+		if (material.is_valid()) {
+			RSG::storage->material_request_texture_stream(material, p_instance->texture_stream_size);
+		}
+	}
+}
+
+float RendererSceneCull::_get_hlod_distance_scale(const CameraMatrix &p_projection, float p_screen_lod_threshold) {
+	// Same metric as mesh LOD selection: an error projects to error / (distance * lod_multiplier) of the screen width.
+	float lod_multiplier = p_projection.get_lod_multiplier();
+	if (p_screen_lod_threshold <= 0.0f || lod_multiplier <= 0.0f) {
+		return 1e20; // LOD disabled, never switch to proxies.
+	}
+	return 1.0f / (lod_multiplier * p_screen_lod_threshold);
+}
+
+int RendererSceneCull::_visibility_range_check(InstanceVisibilityData &r_vis_data, const Vector3 &p_camera_pos, uint64_t p_viewport_mask, float p_hlod_distance_scale) {
 	float dist = p_camera_pos.distance_to(r_vis_data.position);
 
 	bool in_range_last_frame = p_viewport_mask & r_vis_data.viewport_state;
 	float begin_offset = in_range_last_frame ? -r_vis_data.range_begin_margin : r_vis_data.range_begin_margin;
 	float end_offset = in_range_last_frame ? r_vis_data.range_end_margin : -r_vis_data.range_end_margin;
 
+	float range_begin = r_vis_data.range_begin;
+	if (r_vis_data.hlod_error > 0.0f) {
+		// HLOD proxies start where their error projects below the LOD threshold.
+		range_begin = MAX(range_begin, r_vis_data.hlod_error * p_hlod_distance_scale);
+	}
+
 	if (r_vis_data.range_end > 0.0f && dist > r_vis_data.range_end + end_offset) {
 		r_vis_data.viewport_state &= ~p_viewport_mask;
 		return -1;
-	} else if (r_vis_data.range_begin > 0.0f && dist < r_vis_data.range_begin + begin_offset) {
+	} else if (range_begin > 0.0f && dist < range_begin + begin_offset) {
 		r_vis_data.viewport_state &= ~p_viewport_mask;
 		return 1;
 	} else {
@@ -2563,11 +2630,74 @@ int RendererSceneCull::_visibility_range_check(InstanceVisibilityData &r_vis_dat
 	}
 }
 
+uint32_t RendererSceneCull::InstanceBoundsArray::cull_frustum(uint64_t p_block, const Frustum &p_frustum) const {
+	const Block &block = blocks[p_block];
+
+#if defined(__SSE2__) && !defined(REAL_T_IS_DOUBLE)
+	static_assert(BLOCK_SIZE == 4, "SSE culling works on blocks of 4 instances.");
+	const __m128 zero = _mm_setzero_ps();
+	__m128 outside = zero;
+
+	for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+		// Same test as InstanceBounds::in_frustum(), on the corner closest to the inside of each plane.
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+
+		__m128 distance = _mm_mul_ps(_mm_set1_ps(plane.normal.x), _mm_loadu_ps(block.bounds[signs[0]]));
+		distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal.y), _mm_loadu_ps(block.bounds[signs[1]])));
+		distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal.z), _mm_loadu_ps(block.bounds[signs[2]])));
+		distance = _mm_sub_ps(distance, _mm_set1_ps(plane.d));
+
+		outside = _mm_or_ps(outside, _mm_cmpge_ps(distance, zero));
+		if (_mm_movemask_ps(outside) == 0xF) {
+			return 0;
+		}
+	}
+
+	return ~uint32_t(_mm_movemask_ps(outside)) & 0xF;
+#else
+	uint32_t inside = (1 << BLOCK_SIZE) - 1;
+
+	for (uint32_t i = 0; i < p_frustum.plane_count && inside; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+
+		for (uint32_t j = 0; j < BLOCK_SIZE; j++) {
+			real_t distance = plane.normal.x * block.bounds[signs[0]][j] + plane.normal.y * block.bounds[signs[1]][j] + plane.normal.z * block.bounds[signs[2]][j] - plane.d;
+			if (distance >= 0.0) {
+				inside &= ~(1 << j);
+			}
+		}
+	}
+
+	return inside;
+#endif
+}
+
+uint32_t RendererSceneCull::InstanceBoundsArray::cull_layers(uint64_t p_block, uint32_t p_layers) const {
+	const Block &block = blocks[p_block];
+
+#ifdef __SSE2__
+	__m128i layers = _mm_and_si128(_mm_loadu_si128((const __m128i *)block.layer_mask), _mm_set1_epi32(p_layers));
+	return ~uint32_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(layers, _mm_setzero_si128())))) & 0xF;
+#else
+	uint32_t inside = 0;
+	for (uint32_t i = 0; i < BLOCK_SIZE; i++) {
+		if (block.layer_mask[i] & p_layers) {
+			inside |= 1 << i;
+		}
+	}
+	return inside;
+#endif
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
-	uint32_t cull_total = cull_data->scenario->instance_data.size();
+	// Split at block boundaries, so each block is only tested once.
+	uint64_t cull_total = cull_data->scenario->instance_data.size();
+	uint64_t block_total = (cull_total + InstanceBoundsArray::BLOCK_SIZE - 1) / InstanceBoundsArray::BLOCK_SIZE;
 	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
-	uint32_t cull_from = p_thread * cull_total / total_threads;
-	uint32_t cull_to = (p_thread + 1 == total_threads) ? cull_total : ((p_thread + 1) * cull_total / total_threads);
+	uint64_t cull_from = (p_thread * block_total / total_threads) * InstanceBoundsArray::BLOCK_SIZE;
+	uint64_t cull_to = (p_thread + 1 == total_threads) ? cull_total : MIN(cull_total, ((p_thread + 1) * block_total / total_threads) * InstanceBoundsArray::BLOCK_SIZE);
 
 	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
 }
@@ -2583,24 +2713,45 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
+	Plane lod_camera_plane(cull_data.cam_transform.get_origin(), -cull_data.cam_transform.basis.get_axis(Vector3::AXIS_Z));
+
+	const InstanceBoundsArray &instance_aabbs = cull_data.scenario->instance_aabbs;
+	uint32_t camera_cull_mask = 0;
+	uint32_t cascade_cull_masks[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS][RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
 
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
+		uint32_t block_lane = i % InstanceBoundsArray::BLOCK_SIZE;
+		if (i == p_from || block_lane == 0) {
+			// Test the layers and bounds of a whole block of instances at once, for the camera and every shadow cascade.
+			uint64_t block = i / InstanceBoundsArray::BLOCK_SIZE;
+			camera_cull_mask = instance_aabbs.cull_layers(block, cull_data.visible_layers);
+			if (camera_cull_mask) {
+				camera_cull_mask &= instance_aabbs.cull_frustum(block, cull_data.cull->frustum);
+			}
+			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+					cascade_cull_masks[j][k] = instance_aabbs.cull_frustum(block, cull_data.cull->shadows[j].cascades[k].frustum);
+				}
+			}
+		}
+		uint32_t lane_bit = 1 << block_lane;
+
 		InstanceData &idata = cull_data.scenario->instance_data[i];
 		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN);
 		int32_t visibility_check = -1;
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
-#define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
-#define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
+#define LAYER_CHECK_AND_IN_FRUSTUM (camera_cull_mask & lane_bit)
+#define IN_CASCADE_FRUSTUM(j, k) (cascade_cull_masks[j][k] & lane_bit)
+#define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask, cull_data.hlod_distance_scale) == 0)
 #define VIS_PARENT_CHECK ((idata.parent_array_index == -1) || ((cull_data.scenario->instance_data[idata.parent_array_index].flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if (LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) {
+			if (LAYER_CHECK_AND_IN_FRUSTUM && VIS_CHECK && !OCCLUSION_CULLED) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2661,6 +2812,20 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 					if (base_type == RS::INSTANCE_MESH) {
 						mesh_visible = true;
+
+						if (cull_data.texture_stream_scale > 0.0) {
+							// Texels needed across the mesh, assuming its textures cover it once. Distance is measured like for mesh LOD.
+							Instance *instance = idata.instance;
+							float distance_min = lod_camera_plane.distance_to(instance->transformed_aabb.get_support(-lod_camera_plane.normal));
+							float distance = MAX(distance_min, z_near);
+							float size = instance->transformed_aabb.get_longest_axis_size() * cull_data.texture_stream_scale / distance;
+							uint32_t stream_size = next_power_of_2(uint32_t(MIN(size, 16384.0f)));
+							if (stream_size > instance->texture_stream_size || frame_number - instance->texture_stream_frame >= RendererStorage::TEXTURE_STREAM_WINDOW_FRAMES) {
+								instance->texture_stream_size = stream_size;
+								instance->texture_stream_frame = frame_number;
+								cull_result.texture_stream_instances.push_back(instance);
+							}
+						}
 					} else if (base_type == RS::INSTANCE_PARTICLES) {
 						//particles visible? process them
 						if (RSG::storage->particles_is_inactive(idata.base_rid)) {
@@ -2767,7 +2932,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
 				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+					if (IN_CASCADE_FRUSTUM(j, k) && VIS_CHECK) {
 						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS) {
@@ -2780,8 +2945,8 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 		}
 
 #undef HIDDEN_BY_VISIBILITY_CHECKS
-#undef LAYER_CHECK
-#undef IN_FRUSTUM
+#undef LAYER_CHECK_AND_IN_FRUSTUM
+#undef IN_CASCADE_FRUSTUM
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -2815,7 +2980,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	}
 }
 
-void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, RID p_render_buffers, RID p_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_lod_threshold, bool p_using_shadows, RendererScene::RenderInfo *r_render_info) {
+void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, RID p_render_buffers, RID p_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_lod_threshold, float p_texture_stream_width, bool p_using_shadows, RendererScene::RenderInfo *r_render_info) {
 	Instance *render_reflection_probe = instance_owner.getornull(p_reflection_probe); //if null, not rendering to it
 
 	Scenario *scenario = scenario_owner.getornull(p_scenario);
@@ -2840,6 +3005,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		visibility_cull_data.scenario = scenario;
 		visibility_cull_data.viewport_mask = scenario->viewport_visibility_masks[p_viewport];
 		visibility_cull_data.camera_position = p_camera_data->main_transform.origin;
+		visibility_cull_data.hlod_distance_scale = _get_hlod_distance_scale(p_camera_data->main_projection, p_screen_lod_threshold);
 
 		for (int i = scenario->instance_visibility.get_bin_count() - 1; i > 0; i--) { // We skip bin 0
 			visibility_cull_data.cull_offset = scenario->instance_visibility.get_bin_start(i);
@@ -2948,6 +3114,8 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+		cull_data.hlod_distance_scale = _get_hlod_distance_scale(p_camera_data->main_projection, p_screen_lod_threshold);
+		cull_data.texture_stream_scale = texture_streaming ? p_texture_stream_width / p_camera_data->main_projection.get_lod_multiplier() : 0.0;
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -2983,6 +3151,10 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			}
 			RSG::storage->update_mesh_instances();
 		}
+
+		for (uint64_t i = 0; i < scene_cull_result.texture_stream_instances.size(); i++) {
+			_instance_request_texture_stream(scene_cull_result.texture_stream_instances[i]);
+		}
 	}
 
 	//render shadows
@@ -3283,7 +3455,7 @@ bool RendererSceneCull::_render_reflection_probe_step(Instance *p_instance, int
 		RendererSceneRender::CameraData camera_data;
 		camera_data.set_camera(xform, cm, false, false);
 
-		_render_scene(&camera_data, RID(), environment, RID(), RSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, RID(), shadow_atlas, reflection_probe->instance, p_step, lod_threshold, use_shadows);
+		_render_scene(&camera_data, RID(), environment, RID(), RSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, RID(), shadow_atlas, reflection_probe->instance, p_step, lod_threshold, 0.0, use_shadows);
 
 	} else {
 		//do roughness postprocess step until it believes it's done
@@ -3928,9 +4100,11 @@ RendererSceneCull::RendererSceneCull() {
 
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
+	texture_streaming = bool(GLOBAL_GET("rendering/textures/streaming/enabled")) && !Engine::get_singleton()->is_editor_hint();
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)RendererThreadPool::singleton->thread_work_pool.get_thread_count()); //make sure there is at least one thread per CPU
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Replaced by the raycast module when it is available, unless the project asks for the software rasterizer.
+	fallback_occlusion_culling = memnew(RendererSceneOcclusionCullRaster);
 }
 
 RendererSceneCull::~RendererSceneCull() {
@@ -3950,7 +4124,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (fallback_occlusion_culling) {
+		memdelete(fallback_occlusion_culling);
 	}
 }
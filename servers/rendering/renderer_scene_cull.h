@@ -120,7 +120,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling;
+	RendererSceneOcclusionCull *fallback_occlusion_culling;
 
 	/* SCENARIO API */
 
@@ -245,6 +245,93 @@ public:
 		}
 	};
 
+	class InstanceBoundsArray {
+		// Same as PagedArray<InstanceBounds>, but the bounds and layer masks of every BLOCK_SIZE
+		// consecutive instances are stored per component, so culling tests a whole block at once.
+	public:
+		static const uint32_t BLOCK_SIZE = 4;
+
+		struct Block {
+			real_t bounds[6][BLOCK_SIZE]; // Indexed like InstanceBounds::bounds.
+			uint32_t layer_mask[BLOCK_SIZE];
+		};
+
+	private:
+		PagedArray<Block> blocks;
+		uint64_t count = 0;
+
+	public:
+		_FORCE_INLINE_ uint64_t size() const { return count; }
+
+		_FORCE_INLINE_ InstanceBounds operator[](uint64_t p_index) const {
+			const Block &block = blocks[p_index / BLOCK_SIZE];
+			uint32_t lane = p_index % BLOCK_SIZE;
+			InstanceBounds bounds;
+			for (uint32_t i = 0; i < 6; i++) {
+				bounds.bounds[i] = block.bounds[i][lane];
+			}
+			return bounds;
+		}
+
+		_FORCE_INLINE_ void set(uint64_t p_index, const InstanceBounds &p_bounds) {
+			Block &block = blocks[p_index / BLOCK_SIZE];
+			uint32_t lane = p_index % BLOCK_SIZE;
+			for (uint32_t i = 0; i < 6; i++) {
+				block.bounds[i][lane] = p_bounds.bounds[i];
+			}
+		}
+
+		_FORCE_INLINE_ void set_layer_mask(uint64_t p_index, uint32_t p_layer_mask) {
+			blocks[p_index / BLOCK_SIZE].layer_mask[p_index % BLOCK_SIZE] = p_layer_mask;
+		}
+
+		_FORCE_INLINE_ void copy(uint64_t p_from, uint64_t p_to) {
+			set(p_to, (*this)[p_from]);
+			set_layer_mask(p_to, blocks[p_from / BLOCK_SIZE].layer_mask[p_from % BLOCK_SIZE]);
+		}
+
+		void push_back(const InstanceBounds &p_bounds, uint32_t p_layer_mask) {
+			if (count % BLOCK_SIZE == 0) {
+				// Fill the unused lanes too, so they never hold garbage floats.
+				Block block;
+				for (uint32_t i = 0; i < 6; i++) {
+					for (uint32_t j = 0; j < BLOCK_SIZE; j++) {
+						block.bounds[i][j] = p_bounds.bounds[i];
+					}
+				}
+				for (uint32_t j = 0; j < BLOCK_SIZE; j++) {
+					block.layer_mask[j] = 0;
+				}
+				blocks.push_back(block);
+			}
+			set(count, p_bounds);
+			set_layer_mask(count, p_layer_mask);
+			count++;
+		}
+
+		void pop_back() {
+			ERR_FAIL_COND(count == 0);
+			count--;
+			set_layer_mask(count, 0);
+			if (count % BLOCK_SIZE == 0) {
+				blocks.pop_back();
+			}
+		}
+
+		void reset() {
+			blocks.reset();
+			count = 0;
+		}
+
+		void set_page_pool(PagedArrayPool<Block> *p_page_pool) {
+			blocks.set_page_pool(p_page_pool);
+		}
+
+		// Both return one bit per instance of the block, set when it passes the test.
+		uint32_t cull_frustum(uint64_t p_block, const Frustum &p_frustum) const;
+		uint32_t cull_layers(uint64_t p_block, uint32_t p_layers) const;
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -292,6 +379,7 @@ public:
 		float range_end = 0.0f;
 		float range_begin_margin = 0.0f;
 		float range_end_margin = 0.0f;
+		float hlod_error = 0.0f;
 	};
 
 	class VisibilityArray : public BinSortedArray<InstanceVisibilityData> {
@@ -303,7 +391,7 @@ public:
 		}
 	};
 
-	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
+	PagedArrayPool<InstanceBoundsArray::Block> instance_aabb_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
@@ -331,7 +419,7 @@ public:
 
 		LocalVector<RID> dynamic_lights;
 
-		PagedArray<InstanceBounds> instance_aabbs;
+		InstanceBoundsArray instance_aabbs;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
@@ -440,7 +528,11 @@ public:
 		float visibility_range_end;
 		float visibility_range_begin_margin;
 		float visibility_range_end_margin;
+		float visibility_range_hlod_error;
 		Instance *visibility_parent = nullptr;
+
+		uint32_t texture_stream_size = 0; // Last texture size requested for the materials of this instance.
+		uint64_t texture_stream_frame = 0;
 		Scenario *scenario;
 		SelfList<Instance> scenario_item;
 
@@ -543,6 +635,7 @@ public:
 			visibility_range_end = 0;
 			visibility_range_begin_margin = 0;
 			visibility_range_end_margin = 0;
+			visibility_range_hlod_error = 0;
 
 			last_frame_pass = 0;
 			version = 1;
@@ -788,6 +881,7 @@ public:
 		PagedArray<RID> decals;
 		PagedArray<RID> voxel_gi_instances;
 		PagedArray<RID> mesh_instances;
+		PagedArray<Instance *> texture_stream_instances;
 
 		struct DirectionalShadow {
 			PagedArray<RendererSceneRender::GeometryInstance *> cascade_geometry_instances[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
@@ -805,6 +899,7 @@ public:
 			decals.clear();
 			voxel_gi_instances.clear();
 			mesh_instances.clear();
+			texture_stream_instances.clear();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].clear();
@@ -829,6 +924,7 @@ public:
 			decals.reset();
 			voxel_gi_instances.reset();
 			mesh_instances.reset();
+			texture_stream_instances.reset();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].reset();
@@ -853,6 +949,7 @@ public:
 			decals.merge_unordered(p_cull_result.decals);
 			voxel_gi_instances.merge_unordered(p_cull_result.voxel_gi_instances);
 			mesh_instances.merge_unordered(p_cull_result.mesh_instances);
+			texture_stream_instances.merge_unordered(p_cull_result.texture_stream_instances);
 
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
@@ -878,6 +975,7 @@ public:
 			decals.set_page_pool(p_rid_pool);
 			voxel_gi_instances.set_page_pool(p_rid_pool);
 			mesh_instances.set_page_pool(p_rid_pool);
+			texture_stream_instances.set_page_pool(p_instance_pool);
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].set_page_pool(p_geometry_instance_pool);
@@ -905,6 +1003,8 @@ public:
 
 	uint32_t thread_cull_threshold = 200;
 
+	bool texture_streaming = false;
+
 	RID_Owner<Instance, true> instance_owner;
 
 	uint32_t geometry_instance_pair_mask; // used in traditional forward, unnecessary on clustered
@@ -916,6 +1016,7 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instance_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
@@ -942,6 +1043,7 @@ public:
 	virtual void instance_geometry_set_material_override(RID p_instance, RID p_material);
 
 	virtual void instance_geometry_set_visibility_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin);
+	virtual void instance_geometry_set_visibility_range_hlod_error(RID p_instance, float p_error);
 
 	virtual void instance_geometry_set_lightmap(RID p_instance, RID p_lightmap, const Rect2 &p_lightmap_uv_scale, int p_slice_index);
 	virtual void instance_geometry_set_lod_bias(RID p_instance, float p_lod_bias);
@@ -1007,6 +1109,7 @@ public:
 		uint64_t viewport_mask;
 		Scenario *scenario;
 		Vector3 camera_position;
+		float hlod_distance_scale;
 		uint32_t cull_offset;
 		uint32_t cull_count;
 	};
@@ -1014,7 +1117,8 @@ public:
 	void _visibility_cull_threaded(uint32_t p_thread, VisibilityCullData *cull_data);
 	void _visibility_cull(const VisibilityCullData &cull_data, uint64_t p_from, uint64_t p_to);
 	_FORCE_INLINE_ void _visibility_cull(const VisibilityCullData &cull_data, uint64_t p_idx);
-	_FORCE_INLINE_ int _visibility_range_check(InstanceVisibilityData &r_vis_data, const Vector3 &p_camera_pos, uint64_t p_viewport_mask);
+	_FORCE_INLINE_ int _visibility_range_check(InstanceVisibilityData &r_vis_data, const Vector3 &p_camera_pos, uint64_t p_viewport_mask, float p_hlod_distance_scale);
+	static float _get_hlod_distance_scale(const CameraMatrix &p_projection, float p_screen_lod_threshold);
 
 	struct CullData {
 		Cull *cull;
@@ -1026,13 +1130,16 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const CameraMatrix *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		float hlod_distance_scale;
+		float texture_stream_scale; // Viewport width / LOD multiplier, zero when not requesting streamed textures.
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
-	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, RID p_render_buffers, RID p_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_lod_threshold, bool p_using_shadows = true, RenderInfo *r_render_info = nullptr);
+	void _instance_request_texture_stream(Instance *p_instance);
+	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, RID p_render_buffers, RID p_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_lod_threshold, float p_texture_stream_width, bool p_using_shadows = true, RenderInfo *r_render_info = nullptr);
 	void render_empty_scene(RID p_render_buffers, RID p_scenario, RID p_shadow_atlas);
 
 	void render_camera(RID p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, float p_screen_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RendererScene::RenderInfo *r_render_info = nullptr);
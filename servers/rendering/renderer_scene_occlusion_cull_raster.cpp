@@ -0,0 +1,499 @@
+/*************************************************************************/
+/*  renderer_scene_occlusion_cull_raster.cpp                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "renderer_scene_occlusion_cull_raster.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_bins.clear();
+	column_slopes.clear();
+	row_slopes.clear();
+	tiles_size = Size2i();
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tiles_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	tile_bins.resize(tiles_size.x * tiles_size.y);
+	column_slopes.resize(p_size.x);
+	row_slopes.resize(p_size.y);
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::rasterize(const LocalVector<const LocalVector<Triangle> *> &p_triangles, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_pool) {
+	if (is_empty()) {
+		return;
+	}
+
+	Size2i buffer_size = sizes[0];
+
+	for (uint32_t i = 0; i < tile_bins.size(); i++) {
+		tile_bins[i].clear();
+	}
+
+	for (uint32_t i = 0; i < p_triangles.size(); i++) {
+		const LocalVector<Triangle> &triangles = *p_triangles[i];
+		for (uint32_t j = 0; j < triangles.size(); j++) {
+			const Triangle &triangle = triangles[j];
+			int from_x = triangle.min_x / TILE_SIZE;
+			int to_x = triangle.max_x / TILE_SIZE;
+			int from_y = triangle.min_y / TILE_SIZE;
+			int to_y = triangle.max_y / TILE_SIZE;
+			for (int y = from_y; y <= to_y; y++) {
+				for (int x = from_x; x <= to_x; x++) {
+					tile_bins[y * tiles_size.x + x].push_back(&triangle);
+				}
+			}
+		}
+	}
+
+	if (!p_cam_orthogonal) {
+		// Pixels are laid out the same way as the camera rays of the raycast implementation.
+		CameraMatrix inv_camera_matrix = p_cam_projection.inverse();
+		for (int x = 0; x < buffer_size.x; x++) {
+			float u = (x / float(MAX(1, buffer_size.x - 1))) * 2.0f - 1.0f;
+			Plane pixel_view = inv_camera_matrix.xform4(Plane(u, 0.0, -1.0, 1.0));
+			column_slopes[x] = pixel_view.normal.x / -pixel_view.normal.z;
+		}
+		for (int y = 0; y < buffer_size.y; y++) {
+			float v = (y / float(MAX(1, buffer_size.y - 1))) * 2.0f - 1.0f;
+			Plane pixel_view = inv_camera_matrix.xform4(Plane(0.0, v, -1.0, 1.0));
+			row_slopes[y] = pixel_view.normal.y / -pixel_view.normal.z;
+		}
+	}
+
+	RasterThreadData td;
+	td.bins = tile_bins.ptr();
+	td.z_near = p_cam_projection.get_z_near();
+	td.z_far = p_cam_projection.get_z_far() * 1.05f;
+	td.orthogonal = p_cam_orthogonal;
+	debug_tex_range = td.z_far;
+
+	p_thread_pool.do_work(tile_bins.size(), this, &RasterHZBuffer::_rasterize_tile, &td);
+
+	update_mips();
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, const RasterThreadData *p_data) {
+	int width = sizes[0].x;
+	int tile_x = (p_tile % tiles_size.x) * TILE_SIZE;
+	int tile_y = (p_tile / tiles_size.x) * TILE_SIZE;
+	int tile_w = MIN(TILE_SIZE, width - tile_x);
+	int tile_h = MIN(TILE_SIZE, sizes[0].y - tile_y);
+
+	// The tile keeps the largest 1/z (or z, when orthogonal), which is the closest surface.
+	float depth[TILE_SIZE * TILE_SIZE];
+	for (int i = 0; i < TILE_SIZE * TILE_SIZE; i++) {
+		depth[i] = -FLT_MAX;
+	}
+
+	const LocalVector<const Triangle *> &bin = p_data->bins[p_tile];
+
+	for (uint32_t i = 0; i < bin.size(); i++) {
+		const Triangle &triangle = *bin[i];
+
+		int from_x = MAX(triangle.min_x, tile_x) - tile_x;
+		int to_x = MIN(triangle.max_x, tile_x + tile_w - 1) - tile_x;
+		int from_y = MAX(triangle.min_y, tile_y) - tile_y;
+		int to_y = MIN(triangle.max_y, tile_y + tile_h - 1) - tile_y;
+
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		for (int j = 0; j < 3; j++) {
+			edge_a[j] = triangle.edge_a[j];
+			edge_b[j] = triangle.edge_b[j];
+			edge_c[j] = triangle.edge_a[j] * double(tile_x) + triangle.edge_b[j] * double(tile_y) + triangle.edge_c[j];
+		}
+		float depth_a = triangle.depth_a;
+		float depth_b = triangle.depth_b;
+		float depth_c = triangle.depth_a * tile_x + triangle.depth_b * tile_y + triangle.depth_c;
+
+#ifdef __SSE2__
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 offsets = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+		__m128 top_left[3];
+		__m128 edge_a4[3];
+		for (int j = 0; j < 3; j++) {
+			top_left[j] = _mm_castsi128_ps(_mm_set1_epi32(triangle.edge_top_left[j] ? -1 : 0));
+			edge_a4[j] = _mm_set1_ps(edge_a[j]);
+		}
+		const __m128 depth_a4 = _mm_set1_ps(depth_a);
+#endif
+
+		for (int y = from_y; y <= to_y; y++) {
+			float edge_row[3];
+			for (int j = 0; j < 3; j++) {
+				edge_row[j] = edge_b[j] * y + edge_c[j];
+			}
+			float depth_row = depth_b * y + depth_c;
+			float *depth_ptr = &depth[y * TILE_SIZE];
+
+#ifdef __SSE2__
+			// Rows are TILE_SIZE wide, so groups of four pixels never leave the tile.
+			for (int x = from_x & ~3; x <= to_x; x += 4) {
+				__m128 xs = _mm_add_ps(_mm_set1_ps(x), offsets);
+				__m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				for (int j = 0; j < 3; j++) {
+					__m128 e = _mm_add_ps(_mm_mul_ps(edge_a4[j], xs), _mm_set1_ps(edge_row[j]));
+					__m128 inside = _mm_or_ps(_mm_cmpgt_ps(e, zero), _mm_and_ps(_mm_cmpeq_ps(e, zero), top_left[j]));
+					mask = _mm_and_ps(mask, inside);
+				}
+				if (_mm_movemask_ps(mask) == 0) {
+					continue;
+				}
+				__m128 z = _mm_add_ps(_mm_mul_ps(depth_a4, xs), _mm_set1_ps(depth_row));
+				__m128 prev = _mm_loadu_ps(&depth_ptr[x]);
+				_mm_storeu_ps(&depth_ptr[x], _mm_or_ps(_mm_and_ps(mask, _mm_max_ps(prev, z)), _mm_andnot_ps(mask, prev)));
+			}
+#else
+			for (int x = from_x; x <= to_x; x++) {
+				bool inside = true;
+				for (int j = 0; j < 3; j++) {
+					float e = edge_a[j] * x + edge_row[j];
+					inside = inside && (e > 0.0f || (e == 0.0f && triangle.edge_top_left[j]));
+				}
+				if (inside) {
+					depth_ptr[x] = MAX(depth_ptr[x], depth_a * x + depth_row);
+				}
+			}
+#endif
+		}
+	}
+
+	// Store the distance from the near plane along each pixel ray, which is what HZBuffer::is_occluded() expects.
+	for (int y = 0; y < tile_h; y++) {
+		float row_slope = p_data->orthogonal ? 0.0f : row_slopes[tile_y + y];
+		float *dst = &mips[0][(tile_y + y) * width + tile_x];
+		for (int x = 0; x < tile_w; x++) {
+			float z = depth[y * TILE_SIZE + x];
+			float distance;
+			if (z == -FLT_MAX) {
+				distance = p_data->z_far;
+			} else if (p_data->orthogonal) {
+				distance = -z - p_data->z_near;
+			} else {
+				float column_slope = column_slopes[tile_x + x];
+				distance = (1.0f / z - p_data->z_near) * Math::sqrt(1.0f + column_slope * column_slope + row_slope * row_slope);
+			}
+			dst[x] = CLAMP(distance, 0.0f, p_data->z_far);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RendererSceneOcclusionCullRaster::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RendererSceneOcclusionCullRaster::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RendererSceneOcclusionCullRaster::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RendererSceneOcclusionCullRaster::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+}
+
+void RendererSceneOcclusionCullRaster::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullRaster::add_scenario(RID p_scenario) {
+	if (!scenarios.has(p_scenario)) {
+		scenarios[p_scenario] = Scenario();
+	}
+}
+
+void RendererSceneOcclusionCullRaster::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RendererSceneOcclusionCullRaster::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	// Occluders are transformed and rasterized from scratch on every buffer update, so nothing needs to be marked dirty.
+	OccluderInstance &instance = scenario.instances[p_instance];
+	instance.occluder = p_occluder;
+	instance.xform = p_xform;
+	instance.enabled = p_enabled;
+}
+
+void RendererSceneOcclusionCullRaster::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	if (!scenario) {
+		return; // The scenario may be freed before its instances.
+	}
+	scenario->instances.erase(p_instance);
+}
+
+void RendererSceneOcclusionCullRaster::_setup_instance(uint32_t p_idx, const SetupThreadData *p_data) {
+	OccluderInstance *occ_inst = p_data->instances[p_idx];
+	const Occluder *occ = occluder_owner.getornull(occ_inst->occluder);
+
+	occ_inst->triangles.clear();
+	if (!occ) {
+		return;
+	}
+
+	int vertex_count = occ->vertices.size();
+	int index_count = occ->indices.size();
+	const Vector3 *vertices = occ->vertices.ptr();
+	const int32_t *indices = occ->indices.ptr();
+
+	Transform3D view_xform = p_data->cam_inv_transform * occ_inst->xform;
+	occ_inst->view_vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		occ_inst->view_vertices[i] = view_xform.xform(vertices[i]);
+	}
+
+	for (int i = 0; i + 2 < index_count; i += 3) {
+		Vector3 view[3];
+		bool valid = true;
+		for (int j = 0; j < 3; j++) {
+			int32_t index = indices[i + j];
+			if (index < 0 || index >= vertex_count) {
+				valid = false;
+				break;
+			}
+			view[j] = occ_inst->view_vertices[index];
+		}
+		if (valid) {
+			_setup_triangle(view, p_data, occ_inst->triangles);
+		}
+	}
+}
+
+void RendererSceneOcclusionCullRaster::_setup_triangle(const Vector3 *p_view, const SetupThreadData *p_data, LocalVector<Triangle> &r_triangles) {
+	const float clip_z = -p_data->z_near;
+
+	// Clip against the near plane, which leaves at most a quad.
+	Vector3 polygon[4];
+	int polygon_size = 0;
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &current = p_view[i];
+		const Vector3 &next = p_view[(i + 1) % 3];
+		bool current_inside = current.z <= clip_z;
+		bool next_inside = next.z <= clip_z;
+		if (current_inside) {
+			polygon[polygon_size++] = current;
+		}
+		if (current_inside != next_inside) {
+			Vector3 clipped = current.lerp(next, (clip_z - current.z) / (next.z - current.z));
+			clipped.z = clip_z;
+			polygon[polygon_size++] = clipped;
+		}
+	}
+
+	if (polygon_size < 3) {
+		return;
+	}
+
+	const Size2i &buffer_size = p_data->buffer_size;
+	float screen_x[4];
+	float screen_y[4];
+	double depth[4];
+	for (int i = 0; i < polygon_size; i++) {
+		Vector3 projected = p_data->cam_projection.xform(polygon[i]);
+		screen_x[i] = (projected.x * 0.5f + 0.5f) * (buffer_size.x - 1);
+		screen_y[i] = (projected.y * 0.5f + 0.5f) * (buffer_size.y - 1);
+		depth[i] = p_data->cam_orthogonal ? double(polygon[i].z) : 1.0 / -polygon[i].z;
+	}
+
+	for (int i = 1; i + 1 < polygon_size; i++) {
+		int v[3] = { 0, i, i + 1 };
+
+		double area = (double(screen_x[v[1]]) - screen_x[v[0]]) * (double(screen_y[v[2]]) - screen_y[v[0]]) - (double(screen_x[v[2]]) - screen_x[v[0]]) * (double(screen_y[v[1]]) - screen_y[v[0]]);
+		if (area == 0.0) {
+			continue;
+		}
+		if (area < 0.0) {
+			// Occluders are double sided, wind everything the same way.
+			SWAP(v[1], v[2]);
+			area = -area;
+		}
+
+		float min_x = MIN(screen_x[v[0]], MIN(screen_x[v[1]], screen_x[v[2]]));
+		float max_x = MAX(screen_x[v[0]], MAX(screen_x[v[1]], screen_x[v[2]]));
+		float min_y = MIN(screen_y[v[0]], MIN(screen_y[v[1]], screen_y[v[2]]));
+		float max_y = MAX(screen_y[v[0]], MAX(screen_y[v[1]], screen_y[v[2]]));
+
+		Triangle triangle;
+		// Pixels are sampled at integer coordinates.
+		triangle.min_x = MAX(0.0f, Math::ceil(min_x));
+		triangle.max_x = MIN(float(buffer_size.x - 1), Math::floor(max_x));
+		triangle.min_y = MAX(0.0f, Math::ceil(min_y));
+		triangle.max_y = MIN(float(buffer_size.y - 1), Math::floor(max_y));
+
+		if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+			continue;
+		}
+
+		triangle.depth_a = 0.0;
+		triangle.depth_b = 0.0;
+		triangle.depth_c = 0.0;
+
+		for (int j = 0; j < 3; j++) {
+			// Edge j goes between the two vertices opposite to vertex j.
+			int from = v[(j + 1) % 3];
+			int to = v[(j + 2) % 3];
+			float a = screen_y[from] - screen_y[to];
+			float b = screen_x[to] - screen_x[from];
+			triangle.edge_a[j] = a;
+			triangle.edge_b[j] = b;
+			triangle.edge_c[j] = double(screen_x[from]) * screen_y[to] - double(screen_x[to]) * screen_y[from];
+			triangle.edge_top_left[j] = a > 0.0f || (a == 0.0f && b > 0.0f);
+
+			triangle.depth_a += a * depth[v[j]];
+			triangle.depth_b += b * depth[v[j]];
+			triangle.depth_c += triangle.edge_c[j] * depth[v[j]];
+		}
+
+		triangle.depth_a /= area;
+		triangle.depth_b /= area;
+		triangle.depth_c /= area;
+
+		r_triangles.push_back(triangle);
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullRaster::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RendererSceneOcclusionCullRaster::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RendererSceneOcclusionCullRaster::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RendererSceneOcclusionCullRaster::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RendererSceneOcclusionCullRaster::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_pool) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty()) {
+		return;
+	}
+
+	active_instances.clear();
+	active_triangles.clear();
+
+	// A freed scenario still updates the buffer, so nothing stays culled by stale depth.
+	Scenario *scenario = scenarios.getptr(buffer.scenario_rid);
+	if (scenario) {
+		const RID *inst_rid = nullptr;
+		while ((inst_rid = scenario->instances.next(inst_rid))) {
+			OccluderInstance *occ_inst = scenario->instances.getptr(*inst_rid);
+			if (occ_inst->enabled && occluder_owner.owns(occ_inst->occluder)) {
+				active_instances.push_back(occ_inst);
+			}
+		}
+	}
+
+	if (!active_instances.is_empty()) {
+		SetupThreadData td;
+		td.instances = active_instances.ptr();
+		td.cam_inv_transform = p_cam_transform.affine_inverse();
+		td.cam_projection = p_cam_projection;
+		td.cam_orthogonal = p_cam_orthogonal;
+		td.z_near = p_cam_projection.get_z_near();
+		td.buffer_size = buffer.get_size();
+
+		p_thread_pool.do_work(active_instances.size(), this, &RendererSceneOcclusionCullRaster::_setup_instance, &td);
+
+		for (uint32_t i = 0; i < active_instances.size(); i++) {
+			active_triangles.push_back(&active_instances[i]->triangles);
+		}
+	}
+
+	buffer.rasterize(active_triangles, p_cam_projection, p_cam_orthogonal, p_thread_pool);
+}
+
+RendererSceneOcclusionCullRaster::HZBuffer *RendererSceneOcclusionCullRaster::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RendererSceneOcclusionCullRaster::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
@@ -0,0 +1,152 @@
+/*************************************************************************/
+/*  renderer_scene_occlusion_cull_raster.h                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RENDERER_SCENE_OCCLUSION_CULL_RASTER_H
+#define RENDERER_SCENE_OCCLUSION_CULL_RASTER_H
+
+#include "core/math/camera_matrix.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Portable occlusion culling that rasterizes the occluders into the HZ-Buffer on the CPU.
+// Used where the Embree based implementation is not available, or when requested in the project settings.
+class RendererSceneOcclusionCullRaster : public RendererSceneOcclusionCull {
+	static const int TILE_SIZE = 32;
+
+	struct Triangle {
+		// Edge functions are positive inside the triangle. The constant terms are kept in double precision and
+		// rebased to each tile, so an edge shared by two triangles evaluates to exactly opposite values on both.
+		float edge_a[3];
+		float edge_b[3];
+		double edge_c[3];
+		bool edge_top_left[3];
+
+		// Screen space plane of 1/z for perspective projections, or of z for orthogonal ones.
+		double depth_a;
+		double depth_b;
+		double depth_c;
+
+		int min_x;
+		int min_y;
+		int max_x;
+		int max_y;
+	};
+
+public:
+	class RasterHZBuffer : public HZBuffer {
+	private:
+		struct RasterThreadData {
+			LocalVector<const Triangle *> *bins;
+			float z_near;
+			float z_far;
+			bool orthogonal;
+		};
+
+		Size2i tiles_size;
+		LocalVector<LocalVector<const Triangle *>> tile_bins;
+
+		// View space ray slopes of each column and row, to turn view depth into distance along the pixel ray.
+		LocalVector<float> column_slopes;
+		LocalVector<float> row_slopes;
+
+		void _rasterize_tile(uint32_t p_tile, const RasterThreadData *p_data);
+
+	public:
+		RID scenario_rid;
+
+		Size2i get_size() const { return is_empty() ? Size2i() : sizes[0]; }
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+		void rasterize(const LocalVector<const LocalVector<Triangle> *> &p_triangles, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_pool);
+	};
+
+private:
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		Transform3D xform;
+		bool enabled = true;
+		LocalVector<Vector3> view_vertices;
+		LocalVector<Triangle> triangles; // Screen space triangles from the last buffer update.
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+	};
+
+	struct SetupThreadData {
+		OccluderInstance **instances;
+		Transform3D cam_inv_transform;
+		CameraMatrix cam_projection;
+		bool cam_orthogonal;
+		float z_near;
+		Size2i buffer_size;
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	LocalVector<OccluderInstance *> active_instances;
+	LocalVector<const LocalVector<Triangle> *> active_triangles;
+
+	void _setup_instance(uint32_t p_idx, const SetupThreadData *p_data);
+	static void _setup_triangle(const Vector3 *p_view, const SetupThreadData *p_data, LocalVector<Triangle> &r_triangles);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_pool) override;
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RendererSceneOcclusionCullRaster() {}
+};
+
+#endif // RENDERER_SCENE_OCCLUSION_CULL_RASTER_H
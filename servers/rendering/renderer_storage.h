@@ -153,6 +153,7 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) = 0;
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) = 0;
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) = 0;
+	virtual void texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata) = 0;
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) = 0;
 
@@ -215,6 +216,15 @@ public:
 
 	virtual void material_update_dependency(RID p_material, DependencyTracker *p_instance) = 0;
 
+	// Texture stream requests are gathered in windows of frames. Users must renew their requests at
+	// least once per window; a texture nobody asked for in two windows can be streamed out.
+	enum {
+		TEXTURE_STREAM_WINDOW_FRAMES = 30
+	};
+
+	// Asks for the streamed textures used by the material to be resident at (at least) this many pixels across.
+	virtual void material_request_texture_stream(RID p_material, uint32_t p_size) = 0;
+
 	/* MESH API */
 
 	virtual RID mesh_allocate() = 0;
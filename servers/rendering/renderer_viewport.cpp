@@ -117,6 +117,9 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport, uint32_t p_view_coun
 			p_viewport->render_info.info[i][j] = 0;
 		}
 	}
+	for (int i = 0; i < RS::VIEWPORT_RENDER_PASS_MAX; i++) {
+		p_viewport->render_info.pass_record_usec[i] = 0;
+	}
 
 	Color bgcolor = RSG::storage->get_default_clear_color();
 
@@ -532,6 +535,8 @@ void RendererViewport::draw_viewports() {
 	int objects_drawn = 0;
 	int draw_calls_used = 0;
 
+	RSG::canvas_render->render_info = RendererCanvasRender::RenderInfo();
+
 	for (int i = 0; i < active_viewports.size(); i++) {
 		Viewport *vp = active_viewports[i];
 
@@ -616,6 +621,8 @@ void RendererViewport::draw_viewports() {
 	total_objects_drawn = objects_drawn;
 	total_vertices_drawn = vertices_drawn;
 	total_draw_calls_used = draw_calls_used;
+	total_canvas_draw_calls_used = RSG::canvas_render->render_info.draw_calls;
+	total_canvas_batches_used = RSG::canvas_render->render_info.batches;
 
 	RENDER_TIMESTAMP("<Render Viewports");
 	//this needs to be called to make screen swapping more efficient
@@ -999,6 +1006,17 @@ int RendererViewport::viewport_get_render_info(RID p_viewport, RS::ViewportRende
 	return viewport->render_info.info[p_type][p_info];
 }
 
+uint64_t RendererViewport::viewport_get_render_pass_record_time(RID p_viewport, RS::ViewportRenderPass p_pass) {
+	ERR_FAIL_INDEX_V(p_pass, RS::VIEWPORT_RENDER_PASS_MAX, 0);
+
+	Viewport *viewport = viewport_owner.getornull(p_viewport);
+	if (!viewport) {
+		return 0;
+	}
+
+	return viewport->render_info.pass_record_usec[p_pass];
+}
+
 void RendererViewport::viewport_set_debug_draw(RID p_viewport, RS::ViewportDebugDraw p_draw) {
 	Viewport *viewport = viewport_owner.getornull(p_viewport);
 	ERR_FAIL_COND(!viewport);
@@ -1131,6 +1149,14 @@ int RendererViewport::get_total_draw_calls_used() const {
 	return total_draw_calls_used;
 }
 
+int RendererViewport::get_total_canvas_draw_calls_used() const {
+	return total_canvas_draw_calls_used;
+}
+
+int RendererViewport::get_total_canvas_batches_used() const {
+	return total_canvas_batches_used;
+}
+
 RendererViewport::RendererViewport() {
 	occlusion_rays_per_thread = GLOBAL_GET("rendering/occlusion_culling/occlusion_rays_per_thread");
 }
@@ -190,6 +190,8 @@ public:
 	int total_objects_drawn = 0;
 	int total_vertices_drawn = 0;
 	int total_draw_calls_used = 0;
+	int total_canvas_draw_calls_used = 0;
+	int total_canvas_batches_used = 0;
 
 private:
 	void _draw_3d(Viewport *p_viewport);
@@ -246,6 +248,7 @@ public:
 	void viewport_set_lod_threshold(RID p_viewport, float p_pixels);
 
 	virtual int viewport_get_render_info(RID p_viewport, RS::ViewportRenderInfoType p_type, RS::ViewportRenderInfo p_info);
+	virtual uint64_t viewport_get_render_pass_record_time(RID p_viewport, RS::ViewportRenderPass p_pass);
 	virtual void viewport_set_debug_draw(RID p_viewport, RS::ViewportDebugDraw p_draw);
 
 	void viewport_set_measure_render_time(RID p_viewport, bool p_enable);
@@ -270,6 +273,8 @@ public:
 	int get_total_objects_drawn() const;
 	int get_total_vertices_drawn() const;
 	int get_total_draw_calls_used() const;
+	int get_total_canvas_draw_calls_used() const;
+	int get_total_canvas_batches_used() const;
 
 	// Workaround for setting this on thread.
 	void call_set_vsync_mode(DisplayServer::VSyncMode p_mode, DisplayServer::WindowID p_window);
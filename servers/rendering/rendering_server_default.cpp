@@ -248,6 +248,10 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::viewport->get_total_vertices_drawn();
 	} else if (p_info == RENDERING_INFO_TOTAL_DRAW_CALLS_IN_FRAME) {
 		return RSG::viewport->get_total_draw_calls_used();
+	} else if (p_info == RENDERING_INFO_TOTAL_CANVAS_DRAW_CALLS_IN_FRAME) {
+		return RSG::viewport->get_total_canvas_draw_calls_used();
+	} else if (p_info == RENDERING_INFO_TOTAL_CANVAS_BATCHES_IN_FRAME) {
+		return RSG::viewport->get_total_canvas_batches_used();
 	}
 	return RSG::storage->get_rendering_info(p_info);
 }
@@ -0,0 +1,97 @@
+/*************************************************************************/
+/*  test_animation_player.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_ANIMATION_PLAYER_H
+#define TEST_ANIMATION_PLAYER_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "scene/resources/animation.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationPlayer {
+
+TEST_CASE("[SceneTree][AnimationPlayer] Crowd samples are taken at the bucket time of each player's step") {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	int track = animation->add_track(Animation::TYPE_TRANSFORM3D);
+	animation->track_set_path(track, NodePath("Target"));
+	animation->transform_track_insert_key(track, 0.0, Vector3(0, 0, 0), Quaternion(), Vector3(1, 1, 1));
+	animation->transform_track_insert_key(track, 1.0, Vector3(10, 0, 0), Quaternion(Vector3(0, 1, 0), Math_PI * 0.5), Vector3(2, 2, 2));
+
+	// Both players are in bucket 3 of their own step, that is 0.3 and 0.15 seconds. They are evaluated
+	// in the same frame, so they would read each other's samples if the cache only knew about buckets.
+	const float steps[2] = { 0.1, 0.05 };
+	const float times[2] = { 0.35, 0.17 };
+
+	Node3D *targets[2];
+	for (int i = 0; i < 2; i++) {
+		Node3D *holder = memnew(Node3D);
+		targets[i] = memnew(Node3D);
+		targets[i]->set_name("Target");
+		holder->add_child(targets[i]);
+
+		AnimationPlayer *player = memnew(AnimationPlayer);
+		player->set_crowd_time_step(steps[i]);
+		player->add_animation("move", animation);
+		holder->add_child(player);
+		SceneTree::get_singleton()->get_root()->add_child(holder);
+
+		player->play("move");
+		player->seek(times[i], true);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		float bucket_time = Math::floor(times[i] / steps[i]) * steps[i];
+		Vector3 loc;
+		Quaternion rot;
+		Vector3 scale;
+		REQUIRE(animation->transform_track_interpolate(track, bucket_time, &loc, &rot, &scale) == OK);
+
+		Transform3D expected;
+		expected.basis.set_quaternion_scale(rot, scale);
+		expected.origin = loc;
+		CHECK(targets[i]->get_transform().is_equal_approx(expected));
+	}
+
+	CHECK_FALSE(targets[0]->get_transform().is_equal_approx(targets[1]->get_transform()));
+
+	for (int i = 0; i < 2; i++) {
+		memdelete(targets[i]->get_parent());
+	}
+}
+
+} // namespace TestAnimationPlayer
+
+#endif // TEST_ANIMATION_PLAYER_H
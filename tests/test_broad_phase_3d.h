@@ -0,0 +1,271 @@
+/*************************************************************************/
+/*  test_broad_phase_3d.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_BROAD_PHASE_3D_H
+#define TEST_BROAD_PHASE_3D_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/body_3d_sw.h"
+#include "servers/physics_3d/broad_phase_3d_bvh.h"
+#include "servers/physics_3d/broad_phase_3d_sap.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBroadPhase3D {
+
+struct PairCounter {
+	int pairs = 0;
+
+	static void *pair_callback(CollisionObject3DSW *A, int p_subindex_A, CollisionObject3DSW *B, int p_subindex_B, void *p_userdata) {
+		((PairCounter *)p_userdata)->pairs++;
+		return nullptr;
+	}
+
+	static void unpair_callback(CollisionObject3DSW *A, int p_subindex_A, CollisionObject3DSW *B, int p_subindex_B, void *p_data, void *p_userdata) {
+		((PairCounter *)p_userdata)->pairs--;
+	}
+};
+
+// Boxes scattered over a large flat area, like a typical open world level.
+class BroadPhaseScene {
+	RandomPCG rng;
+	real_t extents = 0.0;
+
+public:
+	LocalVector<Body3DSW *> bodies;
+	LocalVector<AABB> aabbs;
+
+	AABB random_aabb() {
+		Vector3 pos(rng.random(-extents, extents), rng.random(0.0, 4.0), rng.random(-extents, extents));
+		return AABB(pos, Vector3(1, 1, 1));
+	}
+
+	void move_all() {
+		for (uint32_t i = 0; i < aabbs.size(); i++) {
+			aabbs[i].position += Vector3(rng.random(-0.5, 0.5), 0.0, rng.random(-0.5, 0.5));
+		}
+	}
+
+	BroadPhaseScene(int p_count, uint64_t p_seed) :
+			rng(p_seed) {
+		// Keep the density constant, so the amount of pairs scales linearly.
+		extents = Math::sqrt(real_t(p_count)) * 2.0;
+		bodies.resize(p_count);
+		aabbs.resize(p_count);
+		for (int i = 0; i < p_count; i++) {
+			bodies[i] = memnew(Body3DSW);
+			aabbs[i] = random_aabb();
+		}
+	}
+
+	~BroadPhaseScene() {
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			memdelete(bodies[i]);
+		}
+	}
+};
+
+static int count_overlaps(const BroadPhaseScene &p_scene, const LocalVector<bool> &p_alive) {
+	int count = 0;
+	for (uint32_t i = 0; i < p_scene.aabbs.size(); i++) {
+		if (!p_alive[i]) {
+			continue;
+		}
+		const AABB &a = p_scene.aabbs[i];
+		for (uint32_t j = i + 1; j < p_scene.aabbs.size(); j++) {
+			if (!p_alive[j] || ((i % 10) == 0 && (j % 10) == 0)) {
+				continue; // Static objects don't pair with each other.
+			}
+			const AABB &b = p_scene.aabbs[j];
+			if (b.position.x > a.position.x + a.size.x || b.position.x + b.size.x < a.position.x ||
+					b.position.y > a.position.y + a.size.y || b.position.y + b.size.y < a.position.y ||
+					b.position.z > a.position.z + a.size.z || b.position.z + b.size.z < a.position.z) {
+				continue;
+			}
+			count++;
+		}
+	}
+	return count;
+}
+
+static void fill_broad_phase(BroadPhase3DSW *p_broad_phase, const BroadPhaseScene &p_scene, LocalVector<BroadPhase3DSW::ID> &r_ids) {
+	r_ids.resize(p_scene.bodies.size());
+	for (uint32_t i = 0; i < p_scene.bodies.size(); i++) {
+		// Every tenth object is static, like level geometry.
+		r_ids[i] = p_broad_phase->create(p_scene.bodies[i], 0, p_scene.aabbs[i], (i % 10) == 0);
+	}
+}
+
+static void move_broad_phase(BroadPhase3DSW *p_broad_phase, const BroadPhaseScene &p_scene, const LocalVector<BroadPhase3DSW::ID> &p_ids) {
+	for (uint32_t i = 0; i < p_ids.size(); i++) {
+		if ((i % 10) != 0) {
+			p_broad_phase->move(p_ids[i], p_scene.aabbs[i]);
+		}
+	}
+}
+
+TEST_CASE("[BroadPhase3D] Sweep and prune pairs match overlapping objects") {
+	ThreadWorkPool work_pool;
+	work_pool.init();
+
+	BroadPhaseScene scene(500, 42);
+	LocalVector<bool> alive;
+	alive.resize(scene.bodies.size());
+	for (uint32_t i = 0; i < alive.size(); i++) {
+		alive[i] = true;
+	}
+
+	BroadPhase3DSW *sap = BroadPhase3DSAP::_create();
+	PairCounter counter;
+	sap->set_pair_callback(PairCounter::pair_callback, &counter);
+	sap->set_unpair_callback(PairCounter::unpair_callback, &counter);
+
+	LocalVector<BroadPhase3DSW::ID> ids;
+	fill_broad_phase(sap, scene, ids);
+	sap->update(work_pool);
+	CHECK_MESSAGE(counter.pairs > 0, "The test scene should have overlapping objects.");
+	CHECK(counter.pairs == count_overlaps(scene, alive));
+
+	for (int step = 0; step < 10; step++) {
+		scene.move_all();
+		move_broad_phase(sap, scene, ids);
+		sap->update(work_pool);
+		CHECK(counter.pairs == count_overlaps(scene, alive));
+	}
+
+	for (uint32_t i = 0; i < ids.size(); i += 2) {
+		sap->remove(ids[i]);
+		alive[i] = false;
+	}
+	CHECK_MESSAGE(counter.pairs == count_overlaps(scene, alive), "Removing objects should unpair them right away.");
+
+	memdelete(sap);
+	work_pool.finish();
+}
+
+TEST_CASE("[BroadPhase3D] BVH bulk moves") {
+	ThreadWorkPool work_pool;
+	work_pool.init();
+
+	BroadPhaseScene scene(500, 42);
+	LocalVector<bool> alive;
+	alive.resize(scene.bodies.size());
+	for (uint32_t i = 0; i < alive.size(); i++) {
+		alive[i] = true;
+	}
+
+	BroadPhase3DSW *bvh = BroadPhase3DBVH::_create();
+	PairCounter counter;
+	bvh->set_pair_callback(PairCounter::pair_callback, &counter);
+	bvh->set_unpair_callback(PairCounter::unpair_callback, &counter);
+
+	LocalVector<BroadPhase3DSW::ID> ids;
+	fill_broad_phase(bvh, scene, ids);
+	bvh->update(work_pool);
+
+	// The BVH pairs using slightly expanded AABBs, so it can report more pairs, but never less.
+	CHECK(counter.pairs >= count_overlaps(scene, alive));
+
+	for (int step = 0; step < 10; step++) {
+		scene.move_all();
+		move_broad_phase(bvh, scene, ids);
+		bvh->update(work_pool);
+	}
+
+	// After the bulk refit, every object has to be found where it was moved to.
+	// Queries also have to see moves that are still pending.
+	scene.move_all();
+	move_broad_phase(bvh, scene, ids);
+	int found = 0;
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		CollisionObject3DSW *results[64];
+		int count = bvh->cull_aabb(scene.aabbs[i], results, 64);
+		for (int j = 0; j < count; j++) {
+			if (results[j] == scene.bodies[i]) {
+				found++;
+				break;
+			}
+		}
+	}
+	CHECK(found == int(ids.size()));
+
+	memdelete(bvh);
+	work_pool.finish();
+}
+
+static void benchmark_broad_phase(BroadPhase3DSW::CreateFunction p_create, const char *p_name, int p_count) {
+	ThreadWorkPool work_pool;
+	work_pool.init();
+
+	BroadPhaseScene scene(p_count, 1234);
+	BroadPhase3DSW *broad_phase = p_create();
+	PairCounter counter;
+	broad_phase->set_pair_callback(PairCounter::pair_callback, &counter);
+	broad_phase->set_unpair_callback(PairCounter::unpair_callback, &counter);
+
+	LocalVector<BroadPhase3DSW::ID> ids;
+	fill_broad_phase(broad_phase, scene, ids);
+	broad_phase->update(work_pool);
+
+	const int steps = 60;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int step = 0; step < steps; step++) {
+		scene.move_all();
+		move_broad_phase(broad_phase, scene, ids);
+		broad_phase->update(work_pool);
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(p_name, ": ", p_count, " objects, ", counter.pairs, " pairs, ", elapsed / steps, " usec per step.");
+
+	memdelete(broad_phase);
+	work_pool.finish();
+}
+
+// Benchmarks, run them with `--test --no-skip`.
+TEST_CASE_PENDING("[BroadPhase3D] Benchmark 1k moving objects") {
+	benchmark_broad_phase(BroadPhase3DBVH::_create, "BVH", 1000);
+	benchmark_broad_phase(BroadPhase3DSAP::_create, "SAP", 1000);
+}
+
+TEST_CASE_PENDING("[BroadPhase3D] Benchmark 10k moving objects") {
+	benchmark_broad_phase(BroadPhase3DBVH::_create, "BVH", 10000);
+	benchmark_broad_phase(BroadPhase3DSAP::_create, "SAP", 10000);
+}
+
+TEST_CASE_PENDING("[BroadPhase3D] Benchmark 50k moving objects") {
+	benchmark_broad_phase(BroadPhase3DBVH::_create, "BVH", 50000);
+	benchmark_broad_phase(BroadPhase3DSAP::_create, "SAP", 50000);
+}
+
+} // namespace TestBroadPhase3D
+
+#endif // TEST_BROAD_PHASE_3D_H
@@ -0,0 +1,247 @@
+/*************************************************************************/
+/*  test_height_map_shape_3d.h                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_HEIGHT_MAP_SHAPE_3D_H
+#define TEST_HEIGHT_MAP_SHAPE_3D_H
+
+#include "core/io/image.h"
+#include "core/math/random_pcg.h"
+#include "servers/physics_3d/shape_3d_sw.h"
+
+#include "tests/test_macros.h"
+
+namespace TestHeightMapShape3D {
+
+static real_t terrain_height(int p_x, int p_z) {
+	return Math::sin(p_x * 0.1) * 4.0 + Math::cos(p_z * 0.07) * 3.0 + (p_x % 3) * 0.05;
+}
+
+static Vector<float> make_terrain(int p_width, int p_depth) {
+	Vector<float> heights;
+	heights.resize(p_width * p_depth);
+	float *w = heights.ptrw();
+	for (int z = 0; z < p_depth; z++) {
+		for (int x = 0; x < p_width; x++) {
+			w[(z * p_width) + x] = terrain_height(x, z);
+		}
+	}
+	return heights;
+}
+
+static Dictionary make_data(int p_width, int p_depth, const Variant &p_heights, bool p_compressed) {
+	Dictionary d;
+	d["width"] = p_width;
+	d["depth"] = p_depth;
+	d["heights"] = p_heights;
+	d["compressed"] = p_compressed;
+	return d;
+}
+
+struct FaceCounter {
+	int faces = 0;
+	real_t min_y = 1e20;
+	real_t max_y = -1e20;
+
+	static void callback(void *p_userdata, Shape3DSW *p_convex) {
+		FaceCounter *counter = (FaceCounter *)p_userdata;
+		const FaceShape3DSW *face = (const FaceShape3DSW *)p_convex;
+		counter->faces++;
+		for (int i = 0; i < 3; i++) {
+			counter->min_y = MIN(counter->min_y, face->vertex[i].y);
+			counter->max_y = MAX(counter->max_y, face->vertex[i].y);
+		}
+	}
+};
+
+TEST_CASE("[HeightMapShape3D] Compressed heights match float heights") {
+	const int width = 257;
+	const int depth = 193;
+	Vector<float> heights = make_terrain(width, depth);
+
+	HeightMapShape3DSW full;
+	full.set_data(make_data(width, depth, heights, false));
+	HeightMapShape3DSW compressed;
+	compressed.set_data(make_data(width, depth, heights, true));
+
+	CHECK(!full.is_compressed());
+	CHECK(compressed.is_compressed());
+	CHECK(compressed.get_aabb().is_equal_approx(full.get_aabb()));
+
+	Vector<float> decoded = compressed.get_heights();
+	REQUIRE(decoded.size() == heights.size());
+	real_t max_error = 0.0;
+	for (int i = 0; i < heights.size(); i++) {
+		max_error = MAX(max_error, Math::abs(decoded[i] - heights[i]));
+	}
+	CHECK_MESSAGE(max_error < 0.001, "Quantization error should be tiny compared to the tile height range.");
+
+	RandomPCG rng(7);
+	int hits = 0;
+	int mismatches = 0;
+	real_t max_distance = 0.0;
+	for (int i = 0; i < 500; i++) {
+		Vector3 from(rng.random(-140.0, 140.0), 20.0, rng.random(-110.0, 110.0));
+		Vector3 to = from + Vector3(rng.random(-30.0, 30.0), -40.0, rng.random(-30.0, 30.0));
+
+		Vector3 full_point, full_normal;
+		Vector3 compressed_point, compressed_normal;
+		bool full_hit = full.intersect_segment(from, to, full_point, full_normal);
+		bool compressed_hit = compressed.intersect_segment(from, to, compressed_point, compressed_normal);
+
+		if (full_hit != compressed_hit) {
+			mismatches++;
+		} else if (full_hit) {
+			hits++;
+			max_distance = MAX(max_distance, full_point.distance_to(compressed_point));
+		}
+	}
+	CHECK_MESSAGE(hits > 0, "Rays should hit the terrain.");
+	CHECK_MESSAGE(mismatches == 0, "Compressed and full heights should hit the same rays.");
+	CHECK(max_distance < 0.01);
+}
+
+TEST_CASE("[HeightMapShape3D] Segments hit the closest face") {
+	const int width = 65;
+	const int depth = 65;
+	Vector<float> heights = make_terrain(width, depth);
+
+	HeightMapShape3DSW shape;
+	shape.set_data(make_data(width, depth, heights, false));
+
+	// Vertical rays must hit at the interpolated height of the cell.
+	int misses = 0;
+	int wrong_hits = 0;
+	for (int z = 0; z < depth - 1; z += 5) {
+		for (int x = 0; x < width - 1; x += 5) {
+			Vector3 point, normal;
+			Vector3 from(x - 0.5 * (width - 1) + 0.25, 50.0, z - 0.5 * (depth - 1) + 0.25);
+			if (!shape.intersect_segment(from, from - Vector3(0.0, 100.0, 0.0), point, normal)) {
+				misses++;
+				continue;
+			}
+
+			real_t min_h = MIN(MIN(terrain_height(x, z), terrain_height(x + 1, z)), terrain_height(x, z + 1));
+			real_t max_h = MAX(MAX(terrain_height(x, z), terrain_height(x + 1, z)), terrain_height(x, z + 1));
+			if (point.y < min_h - CMP_EPSILON || point.y > max_h + CMP_EPSILON || normal.y <= 0.0) {
+				wrong_hits++;
+			}
+		}
+	}
+	CHECK_MESSAGE(misses == 0, "Vertical rays should always hit the terrain.");
+	CHECK_MESSAGE(wrong_hits == 0, "Vertical rays should hit the face of their cell, facing up.");
+
+	// A long grazing ray crosses many leaves, the first hit along it must be reported.
+	Vector3 from(-32.0, 10.0, 0.3);
+	Vector3 to(32.0, -10.0, 0.3);
+	Vector3 point, normal;
+	REQUIRE(shape.intersect_segment(from, to, point, normal));
+	// Everything before the hit along the segment must be above the terrain.
+	Vector3 dir = (to - from).normalized();
+	int probe_misses = 0;
+	for (real_t t = 0.05; t < (point - from).length() - 0.05; t += 0.05) {
+		Vector3 probe = from + dir * t;
+		Vector3 probe_point, probe_normal;
+		if (!shape.intersect_segment(probe, probe - Vector3(0.0, 100.0, 0.0), probe_point, probe_normal)) {
+			probe_misses++;
+		}
+	}
+	CHECK(probe_misses == 0);
+}
+
+TEST_CASE("[HeightMapShape3D] Culling skips faces outside of the height range") {
+	const int width = 129;
+	const int depth = 129;
+	Vector<float> heights = make_terrain(width, depth);
+
+	HeightMapShape3DSW shape;
+	shape.set_data(make_data(width, depth, heights, true));
+
+	FaceCounter above;
+	shape.cull(AABB(Vector3(-20.0, 50.0, -20.0), Vector3(40.0, 5.0, 40.0)), FaceCounter::callback, &above);
+	CHECK_MESSAGE(above.faces == 0, "No face should be reported for an area above the terrain.");
+
+	FaceCounter all;
+	shape.cull(AABB(Vector3(-20.0, -50.0, -20.0), Vector3(40.0, 100.0, 40.0)), FaceCounter::callback, &all);
+	CHECK(all.faces > 0);
+
+	FaceCounter slab;
+	AABB slab_aabb(Vector3(-20.0, 0.0, -20.0), Vector3(40.0, 0.5, 40.0));
+	shape.cull(slab_aabb, FaceCounter::callback, &slab);
+	CHECK(slab.faces > 0);
+	CHECK(slab.faces < all.faces);
+}
+
+TEST_CASE("[HeightMapShape3D] Build from images") {
+	const int width = 96;
+	const int depth = 80;
+	Vector<float> heights = make_terrain(width, depth);
+
+	Vector<uint8_t> float_data;
+	float_data.resize(width * depth * sizeof(float));
+	memcpy(float_data.ptrw(), heights.ptr(), float_data.size());
+	Ref<Image> float_image = memnew(Image(width, depth, false, Image::FORMAT_RF, float_data));
+
+	Vector<uint8_t> half_data;
+	half_data.resize(width * depth * sizeof(uint16_t));
+	uint16_t *half_w = (uint16_t *)half_data.ptrw();
+	for (int i = 0; i < heights.size(); i++) {
+		half_w[i] = Math::make_half_float(heights[i]);
+	}
+	Ref<Image> half_image = memnew(Image(width, depth, false, Image::FORMAT_RH, half_data));
+
+	HeightMapShape3DSW reference;
+	reference.set_data(make_data(width, depth, heights, false));
+
+	HeightMapShape3DSW from_float;
+	from_float.set_data(make_data(width, depth, float_image, true));
+	CHECK(from_float.is_compressed());
+	CHECK(from_float.get_aabb().is_equal_approx(reference.get_aabb()));
+
+	HeightMapShape3DSW from_half;
+	from_half.set_data(make_data(width, depth, half_image, false));
+	CHECK(!from_half.is_compressed());
+
+	Vector<float> float_heights = from_float.get_heights();
+	Vector<float> half_heights = from_half.get_heights();
+	REQUIRE(float_heights.size() == heights.size());
+	REQUIRE(half_heights.size() == heights.size());
+	real_t float_max_error = 0.0;
+	real_t half_max_error = 0.0;
+	for (int i = 0; i < heights.size(); i++) {
+		float_max_error = MAX(float_max_error, Math::abs(float_heights[i] - heights[i]));
+		half_max_error = MAX(half_max_error, Math::abs(half_heights[i] - heights[i]));
+	}
+	CHECK(float_max_error < 0.001);
+	CHECK(half_max_error < 0.01);
+}
+
+} // namespace TestHeightMapShape3D
+
+#endif // TEST_HEIGHT_MAP_SHAPE_3D_H
@@ -33,9 +33,11 @@
 #include "core/templates/list.h"
 
 #include "test_aabb.h"
+#include "test_animation_player.h"
 #include "test_array.h"
 #include "test_astar.h"
 #include "test_basis.h"
+#include "test_broad_phase_3d.h"
 #include "test_class_db.h"
 #include "test_color.h"
 #include "test_command_queue.h"
@@ -50,6 +52,7 @@
 #include "test_gradient.h"
 #include "test_gui.h"
 #include "test_hashing_context.h"
+#include "test_height_map_shape_3d.h"
 #include "test_image.h"
 #include "test_json.h"
 #include "test_list.h"
@@ -58,20 +61,27 @@
 #include "test_marshalls.h"
 #include "test_math.h"
 #include "test_method_bind.h"
+#include "test_node.h"
 #include "test_node_path.h"
 #include "test_oa_hash_map.h"
 #include "test_object.h"
+#include "test_occlusion_cull_raster.h"
 #include "test_ordered_hash_map.h"
+#include "test_packed_scene.h"
 #include "test_paged_array.h"
 #include "test_path_3d.h"
 #include "test_pck_packer.h"
 #include "test_physics_2d.h"
+#include "test_physics_2d_determinism.h"
 #include "test_physics_3d.h"
+#include "test_physics_3d_state.h"
 #include "test_random_number_generator.h"
 #include "test_rect2.h"
 #include "test_render.h"
+#include "test_renderer_scene_cull.h"
 #include "test_resource.h"
 #include "test_shader_lang.h"
+#include "test_stream_texture_2d.h"
 #include "test_string.h"
 #include "test_text_server.h"
 #include "test_time.h"
@@ -85,6 +95,98 @@
 
 #include "tests/test_macros.h"
 
+#include "core/input/input.h"
+#include "core/object/message_queue.h"
+#include "scene/main/scene_tree.h"
+#include "servers/display_server.h"
+#include "servers/navigation_server_2d.h"
+#include "servers/navigation_server_3d.h"
+#include "servers/physics_server_2d.h"
+#include "servers/physics_server_3d.h"
+#include "servers/rendering/rendering_server_default.h"
+#include "servers/text_server.h"
+
+// Test cases tagged with [SceneTree] run with a SceneTree on top of headless servers,
+// set up and torn down around each case in the same order as `Main`.
+struct GodotTestCaseListener : public doctest::IReporter {
+	GodotTestCaseListener(const doctest::ContextOptions &p_in) {}
+
+	void test_case_start(const doctest::TestCaseData &p_in) override {
+		String name = String(p_in.m_name);
+		if (name.find("[SceneTree]") == -1) {
+			return;
+		}
+
+		memnew(MessageQueue);
+
+		memnew(TextServerManager);
+		Error err = OK;
+		for (int i = 0; i < TextServerManager::get_interface_count(); i++) {
+			if (TextServerManager::initialize(i, err)) {
+				break;
+			}
+		}
+
+		memnew(Input);
+
+		for (int i = 0; i < DisplayServer::get_create_function_count(); i++) {
+			if (String("headless") == DisplayServer::get_create_function_name(i)) {
+				DisplayServer::create(i, "", DisplayServer::WINDOW_MODE_MINIMIZED, DisplayServer::VSYNC_ENABLED, 0, Vector2i(0, 0), err);
+				break;
+			}
+		}
+		memnew(RenderingServerDefault);
+		RenderingServer::get_singleton()->init();
+
+		PhysicsServer3DManager::new_default_server()->init();
+		PhysicsServer2DManager::new_default_server()->init();
+		NavigationServer3DManager::new_default_server();
+		memnew(NavigationServer2D);
+
+		memnew(SceneTree);
+		SceneTree::get_singleton()->initialize();
+	}
+
+	void test_case_end(const doctest::CurrentTestCaseStats &) override {
+		if (!SceneTree::get_singleton()) {
+			return;
+		}
+
+		SceneTree::get_singleton()->finalize();
+		MessageQueue::get_singleton()->flush();
+		memdelete(SceneTree::get_singleton());
+
+		memdelete(NavigationServer2D::get_singleton_mut());
+		memdelete(NavigationServer3D::get_singleton_mut());
+		PhysicsServer2D::get_singleton()->finish();
+		memdelete(PhysicsServer2D::get_singleton());
+		PhysicsServer3D::get_singleton()->finish();
+		memdelete(PhysicsServer3D::get_singleton());
+
+		RenderingServer::get_singleton()->finish();
+		memdelete(RenderingServer::get_singleton());
+		memdelete(DisplayServer::get_singleton());
+
+		memdelete(Input::get_singleton());
+		memdelete(TextServerManager::get_singleton());
+		MessageQueue::get_singleton()->flush();
+		memdelete(MessageQueue::get_singleton());
+	}
+
+	void report_query(const doctest::QueryData &) override {}
+	void test_run_start() override {}
+	void test_run_end(const doctest::TestRunStats &) override {}
+	void test_case_reenter(const doctest::TestCaseData &) override {}
+	void test_case_exception(const doctest::TestCaseException &) override {}
+	void subcase_start(const doctest::SubcaseSignature &) override {}
+	void subcase_end() override {}
+	void log_assert(const doctest::AssertData &) override {}
+	void log_message(const doctest::MessageData &) override {}
+	void test_case_skipped(const doctest::TestCaseData &) override {}
+};
+
+REGISTER_LISTENER("GodotTestCaseListener", 1, GodotTestCaseListener);
+
 int test_main(int argc, char *argv[]) {
 	bool run_tests = true;
 
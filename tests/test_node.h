@@ -0,0 +1,223 @@
+/*************************************************************************/
+/*  test_node.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NODE_H
+#define TEST_NODE_H
+
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNode {
+
+static Node *add_named_children(Node *p_parent, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child" + itos(i));
+		p_parent->add_child(child);
+	}
+	return p_parent;
+}
+
+TEST_CASE("[Node] Child lookup by name") {
+	// Below and above the size where the name index is built.
+	const int counts[2] = { 8, 200 };
+
+	for (int c = 0; c < 2; c++) {
+		Node *parent = add_named_children(memnew(Node), counts[c]);
+
+		for (int i = 0; i < counts[c]; i++) {
+			CHECK(parent->get_node_or_null(NodePath("Child" + itos(i))) == parent->get_child(i));
+		}
+		CHECK(parent->get_node_or_null(NodePath("Missing")) == nullptr);
+
+		// Renaming.
+		Node *renamed = parent->get_child(3);
+		renamed->set_name("Renamed");
+		CHECK(parent->get_node_or_null(NodePath("Renamed")) == renamed);
+		CHECK(parent->get_node_or_null(NodePath("Child3")) == nullptr);
+
+		// Reordering doesn't affect lookups.
+		parent->move_child(renamed, 0);
+		CHECK(parent->get_node_or_null(NodePath("Renamed")) == renamed);
+		CHECK(parent->get_node_or_null(NodePath("Child4")) == parent->get_child(4));
+
+		// Removal.
+		Node *removed = parent->get_child(5);
+		StringName removed_name = removed->get_name();
+		parent->remove_child(removed);
+		CHECK(parent->get_node_or_null(NodePath(removed_name)) == nullptr);
+
+		// Re-adding it with the same name.
+		parent->add_child(removed);
+		CHECK(removed->get_name() == removed_name);
+		CHECK(parent->get_node_or_null(NodePath(removed_name)) == removed);
+
+		memdelete(parent);
+	}
+}
+
+TEST_CASE_PENDING("[Node][Benchmark] Add and look up 100k uniquely named children") {
+	const int count = 100000;
+	Node *parent = memnew(Node);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	add_named_children(parent, count);
+	uint64_t added = OS::get_singleton()->get_ticks_usec();
+
+	int found = 0;
+	for (int i = 0; i < count; i++) {
+		if (parent->get_node_or_null(NodePath("Child" + itos(i)))) {
+			found++;
+		}
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	CHECK(found == count);
+	MESSAGE(vformat("add_child: %.2f ms, get_node: %.2f ms.", (added - begin) / 1000.0, (end - added) / 1000.0));
+
+	memdelete(parent);
+}
+
+// Moves itself on every process frame, and counts the transform notifications it receives.
+class ThreadGroupMover : public Node3D {
+	GDCLASS(ThreadGroupMover, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_READY: {
+				set_process(true);
+			} break;
+			case NOTIFICATION_PROCESS: {
+				processed_by = SceneTree::get_current_process_thread_group_owner();
+				set_position(get_position() + Vector3(1, 0, 0));
+			} break;
+			case NOTIFICATION_TRANSFORM_CHANGED: {
+				transform_changes++;
+			} break;
+		}
+	}
+
+public:
+	Node *processed_by = nullptr;
+	int transform_changes = 0;
+
+	ThreadGroupMover() {
+		set_notify_transform(true);
+	}
+};
+
+TEST_CASE("[SceneTree][Node] Transform notifications from sub-thread groups") {
+	ClassDB::register_class<ThreadGroupMover>();
+	SceneTree *tree = SceneTree::get_singleton();
+
+	Node3D *groups[2];
+	ThreadGroupMover *movers[2];
+	for (int i = 0; i < 2; i++) {
+		groups[i] = memnew(Node3D);
+		groups[i]->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		movers[i] = memnew(ThreadGroupMover);
+		groups[i]->add_child(movers[i]);
+		tree->get_root()->add_child(groups[i]);
+	}
+
+	// A sub-thread group nested in another one is processed as part of the outer group.
+	ThreadGroupMover *nested = memnew(ThreadGroupMover);
+	nested->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	ERR_PRINT_OFF;
+	movers[1]->add_child(nested);
+	ERR_PRINT_ON;
+
+	// Discard the notifications sent when entering the tree.
+	tree->flush_transform_notifications();
+	for (int i = 0; i < 2; i++) {
+		movers[i]->transform_changes = 0;
+	}
+	nested->transform_changes = 0;
+
+	const int frames = 3;
+	for (int i = 0; i < frames; i++) {
+		tree->process(0.1);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		CHECK(movers[i]->processed_by == groups[i]);
+		CHECK(movers[i]->transform_changes == frames);
+		CHECK(movers[i]->get_global_transform().origin.is_equal_approx(Vector3(frames, 0, 0)));
+	}
+
+	CHECK(nested->processed_by == groups[1]);
+	CHECK_MESSAGE(nested->transform_changes == frames, "Changes from the node and its parent in the same frame are notified once.");
+	CHECK(nested->get_global_transform().origin.is_equal_approx(Vector3(frames * 2, 0, 0)));
+
+	for (int i = 0; i < 2; i++) {
+		memdelete(groups[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][Node] Transform notifications after moving a parent twice in a frame") {
+	ClassDB::register_class<ThreadGroupMover>();
+	SceneTree *tree = SceneTree::get_singleton();
+
+	Node3D *parent = memnew(Node3D);
+	ThreadGroupMover *child = memnew(ThreadGroupMover);
+	parent->add_child(child);
+	tree->get_root()->add_child(parent);
+
+	tree->flush_transform_notifications();
+	child->transform_changes = 0;
+
+	// Both moves are pending, the child is notified once.
+	parent->set_position(Vector3(1, 0, 0));
+	parent->set_position(Vector3(2, 0, 0));
+	tree->flush_transform_notifications();
+	CHECK(child->transform_changes == 1);
+
+	// The child is notified in between the moves, so the second one must queue it again.
+	parent->set_position(Vector3(3, 0, 0));
+	child->force_update_transform();
+	CHECK(child->transform_changes == 2);
+	parent->set_position(Vector3(4, 0, 0));
+	tree->flush_transform_notifications();
+	CHECK(child->transform_changes == 3);
+	CHECK(child->get_global_transform().origin.is_equal_approx(Vector3(4, 0, 0)));
+
+	memdelete(parent);
+}
+
+} // namespace TestNode
+
+#endif // TEST_NODE_H
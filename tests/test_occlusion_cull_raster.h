@@ -0,0 +1,198 @@
+/*************************************************************************/
+/*  test_occlusion_cull_raster.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_OCCLUSION_CULL_RASTER_H
+#define TEST_OCCLUSION_CULL_RASTER_H
+
+#include "servers/rendering/renderer_scene_occlusion_cull_raster.h"
+
+#include "tests/test_macros.h"
+
+namespace TestOcclusionCullRaster {
+
+// Camera at the origin looking down -Z, with a single occlusion buffer.
+class OcclusionTestScene {
+	ThreadWorkPool work_pool;
+	uint64_t last_id = 0;
+
+public:
+	RendererSceneOcclusionCull *occlusion_cull = nullptr;
+	RID scenario;
+	RID buffer;
+	LocalVector<RID> occluders;
+	Transform3D cam_transform;
+	CameraMatrix cam_projection;
+	bool cam_orthogonal = false;
+
+	RID add_occluder(const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices, const Transform3D &p_xform = Transform3D()) {
+		RID occluder = occlusion_cull->occluder_allocate();
+		occlusion_cull->occluder_initialize(occluder);
+		occlusion_cull->occluder_set_mesh(occluder, p_vertices, p_indices);
+
+		occluders.push_back(occluder);
+
+		RID instance = RID::from_uint64(++last_id);
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, p_xform, true);
+		return instance;
+	}
+
+	// Axis aligned quad facing the camera.
+	RID add_wall(const Vector2 &p_half_size, real_t p_z) {
+		PackedVector3Array vertices;
+		vertices.push_back(Vector3(-p_half_size.x, -p_half_size.y, p_z));
+		vertices.push_back(Vector3(p_half_size.x, -p_half_size.y, p_z));
+		vertices.push_back(Vector3(p_half_size.x, p_half_size.y, p_z));
+		vertices.push_back(Vector3(-p_half_size.x, p_half_size.y, p_z));
+		PackedInt32Array indices;
+		const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+		for (int i = 0; i < 6; i++) {
+			indices.push_back(quad[i]);
+		}
+		return add_occluder(vertices, indices);
+	}
+
+	void update() {
+		occlusion_cull->buffer_update(buffer, cam_transform, cam_projection, cam_orthogonal, work_pool);
+	}
+
+	bool is_occluded(const AABB &p_aabb) {
+		const RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+		float bounds[6] = { float(p_aabb.position.x), float(p_aabb.position.y), float(p_aabb.position.z), float(p_aabb.position.x + p_aabb.size.x), float(p_aabb.position.y + p_aabb.size.y), float(p_aabb.position.z + p_aabb.size.z) };
+		return hz_buffer->is_occluded(bounds, cam_transform.origin, cam_transform.affine_inverse(), cam_projection, cam_projection.get_z_near());
+	}
+
+	OcclusionTestScene(RendererSceneOcclusionCull *p_occlusion_cull, const Size2i &p_size = Size2i(128, 72)) {
+		work_pool.init();
+		occlusion_cull = p_occlusion_cull;
+		scenario = RID::from_uint64(++last_id);
+		buffer = RID::from_uint64(++last_id);
+		occlusion_cull->add_scenario(scenario);
+		occlusion_cull->add_buffer(buffer);
+		occlusion_cull->buffer_set_scenario(buffer, scenario);
+		occlusion_cull->buffer_set_size(buffer, p_size);
+		cam_projection.set_perspective(70.0, real_t(p_size.x) / p_size.y, 0.05, 100.0);
+	}
+
+	~OcclusionTestScene() {
+		occlusion_cull->remove_buffer(buffer);
+		occlusion_cull->remove_scenario(scenario);
+		for (uint32_t i = 0; i < occluders.size(); i++) {
+			occlusion_cull->free_occluder(occluders[i]);
+		}
+		work_pool.finish();
+	}
+};
+
+static AABB box_at(const Vector3 &p_center, real_t p_half_size) {
+	return AABB(p_center - Vector3(p_half_size, p_half_size, p_half_size), Vector3(p_half_size, p_half_size, p_half_size) * 2.0);
+}
+
+TEST_CASE("[OcclusionCullRaster] Wall occludes what is behind it") {
+	RendererSceneOcclusionCullRaster occlusion_cull;
+	OcclusionTestScene scene(&occlusion_cull);
+	scene.add_wall(Vector2(5, 10), -10);
+	scene.update();
+
+	CHECK(scene.is_occluded(box_at(Vector3(0, 0, -20), 1)));
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -5), 1)), "Objects in front of the wall should be visible.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(14, 0, -20), 1)), "Objects next to the wall should be visible.");
+
+	// The stored depth has to match the wall closely, on both sides.
+	CHECK(scene.is_occluded(box_at(Vector3(0, 0, -10.4), 0.1)));
+	CHECK_FALSE(scene.is_occluded(box_at(Vector3(0, 0, -9.6), 0.1)));
+}
+
+TEST_CASE("[OcclusionCullRaster] Orthogonal camera") {
+	RendererSceneOcclusionCullRaster occlusion_cull;
+	OcclusionTestScene scene(&occlusion_cull);
+	scene.cam_projection.set_orthogonal(20.0, 128.0 / 72.0, 0.05, 100.0);
+	scene.cam_orthogonal = true;
+	scene.add_wall(Vector2(5, 5), -10);
+	scene.update();
+
+	CHECK(scene.is_occluded(box_at(Vector3(0, 0, -20), 1)));
+	CHECK(scene.is_occluded(box_at(Vector3(0, 0, -10.4), 0.1)));
+	CHECK_FALSE(scene.is_occluded(box_at(Vector3(0, 0, -9.6), 0.1)));
+	CHECK_FALSE(scene.is_occluded(box_at(Vector3(8, 0, -20), 1)));
+}
+
+TEST_CASE("[OcclusionCullRaster] Occluders crossing the near plane") {
+	RendererSceneOcclusionCullRaster occlusion_cull;
+	OcclusionTestScene scene(&occlusion_cull);
+
+	// Ground that starts behind the camera and goes past the far plane.
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-100, -1, 10));
+	vertices.push_back(Vector3(100, -1, 10));
+	vertices.push_back(Vector3(100, -1, -200));
+	vertices.push_back(Vector3(-100, -1, -200));
+	PackedInt32Array indices;
+	const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int i = 0; i < 6; i++) {
+		indices.push_back(quad[i]);
+	}
+	scene.add_occluder(vertices, indices);
+	scene.update();
+
+	CHECK_MESSAGE(scene.is_occluded(box_at(Vector3(0, -4, -20), 1)), "Objects under the ground should be occluded.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 1, -20), 1)), "Objects above the ground should be visible.");
+}
+
+TEST_CASE("[OcclusionCullRaster] Moved, disabled and removed occluders") {
+	RendererSceneOcclusionCullRaster occlusion_cull;
+	OcclusionTestScene scene(&occlusion_cull);
+	RID wall = scene.add_wall(Vector2(5, 10), -10);
+	RID occluder = scene.occluders[0];
+	const AABB behind = box_at(Vector3(0, 0, -20), 1);
+
+	scene.update();
+	REQUIRE(scene.is_occluded(behind));
+
+	occlusion_cull.scenario_set_instance(scene.scenario, wall, occluder, Transform3D(Basis(), Vector3(5, 0, 0)), true);
+	scene.update();
+	CHECK_FALSE_MESSAGE(scene.is_occluded(behind), "The occluded area should follow the instance transform.");
+	CHECK(scene.is_occluded(box_at(Vector3(10, 0, -20), 1)));
+
+	occlusion_cull.scenario_set_instance(scene.scenario, wall, occluder, Transform3D(), false);
+	scene.update();
+	CHECK_FALSE_MESSAGE(scene.is_occluded(behind), "Disabled instances should not occlude.");
+
+	occlusion_cull.scenario_set_instance(scene.scenario, wall, occluder, Transform3D(), true);
+	scene.update();
+	CHECK(scene.is_occluded(behind));
+
+	occlusion_cull.scenario_remove_instance(scene.scenario, wall);
+	scene.update();
+	CHECK_FALSE_MESSAGE(scene.is_occluded(behind), "Removed instances should not occlude.");
+}
+
+} // namespace TestOcclusionCullRaster
+
+#endif // TEST_OCCLUSION_CULL_RASTER_H
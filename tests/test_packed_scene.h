@@ -0,0 +1,160 @@
+/*************************************************************************/
+/*  test_packed_scene.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "core/io/resource_saver.h"
+#include "core/os/os.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedScene {
+
+static Ref<PackedScene> pack_test_scene() {
+	Node *root = memnew(Node);
+	root->set_name("Root");
+
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	child->set_process_priority(5);
+	child->add_to_group("enemies", true);
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> packed;
+	packed.instantiate();
+	CHECK(packed->pack(root) == OK);
+	memdelete(root);
+
+	return packed;
+}
+
+TEST_CASE("[PackedScene] Instantiate") {
+	Ref<PackedScene> packed = pack_test_scene();
+
+	// The first instantiation compiles the scene, the second one uses the compiled setters.
+	for (int i = 0; i < 2; i++) {
+		Node *instance = packed->instantiate();
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_name() == "Root");
+
+		Node *child = instance->get_node_or_null(NodePath("Child"));
+		REQUIRE(child != nullptr);
+		CHECK(child->get_owner() == instance);
+		CHECK(child->get_process_priority() == 5);
+		CHECK(child->is_in_group("enemies"));
+
+		memdelete(instance);
+	}
+}
+
+TEST_CASE("[PackedScene] Recycle instances") {
+	Ref<PackedScene> packed = pack_test_scene();
+
+	Node *instance = packed->instantiate();
+	CHECK_MESSAGE(!packed->recycle_instance(instance), "Pooling is disabled by default.");
+
+	packed->set_pool_size(1);
+	Node *child = instance->get_node(NodePath("Child"));
+	child->set_process_priority(10);
+	child->remove_from_group("enemies");
+	CHECK(packed->recycle_instance(instance));
+
+	Node *recycled = packed->instantiate();
+	CHECK(recycled == instance);
+	CHECK_MESSAGE(child->get_process_priority() == 5, "Properties stored in the scene are restored.");
+	CHECK_MESSAGE(child->is_in_group("enemies"), "Groups stored in the scene are restored.");
+
+	Node *other = packed->instantiate();
+	CHECK(other != recycled);
+
+	CHECK(packed->recycle_instance(recycled));
+	CHECK_MESSAGE(!packed->recycle_instance(other), "Pool is full.");
+	memdelete(other);
+
+	ObjectID pooled_id = recycled->get_instance_id();
+	packed->set_pool_size(0);
+	CHECK_MESSAGE(ObjectDB::get_instance(pooled_id) == nullptr, "Disabling the pool frees pooled instances.");
+
+	packed->set_pool_size(1);
+	CHECK(packed->recycle_instance(packed->instantiate()));
+	PackedScene::clear_pools();
+	Node *fresh = packed->instantiate();
+	CHECK_MESSAGE(fresh->get_instance_id() != pooled_id, "Clearing every pool leaves nothing to reuse.");
+	memdelete(fresh);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Threaded instantiation") {
+	const String path = OS::get_singleton()->get_cache_path().plus_file("threaded_instantiation.tscn");
+	REQUIRE(ResourceSaver::save(path, pack_test_scene()) == OK);
+
+	SceneTree *tree = SceneTree::get_singleton();
+	CHECK(tree->instantiate_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+
+	const int requests = 3;
+	for (int i = 0; i < requests; i++) {
+		REQUIRE(tree->instantiate_threaded_request(path) == OK);
+	}
+
+	ResourceLoader::ThreadLoadStatus status = tree->instantiate_threaded_get_status(path);
+	while (status == ResourceLoader::THREAD_LOAD_IN_PROGRESS) {
+		OS::get_singleton()->delay_usec(1000);
+		status = tree->instantiate_threaded_get_status(path);
+	}
+	CHECK(status == ResourceLoader::THREAD_LOAD_LOADED);
+
+	// Every request gets its own instance, whether it was ready, in progress or still queued.
+	Node *instances[requests];
+	for (int i = 0; i < requests; i++) {
+		instances[i] = tree->instantiate_threaded_get(path);
+		REQUIRE(instances[i] != nullptr);
+		CHECK(!instances[i]->is_inside_tree());
+		CHECK(instances[i]->get_node_or_null(NodePath("Child")) != nullptr);
+		for (int j = 0; j < i; j++) {
+			CHECK(instances[i] != instances[j]);
+		}
+	}
+	for (int i = 0; i < requests; i++) {
+		memdelete(instances[i]);
+	}
+
+	CHECK(tree->instantiate_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(tree->instantiate_threaded_get(path) == nullptr, "Each request can only be retrieved once.");
+	ERR_PRINT_ON;
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,190 @@
+/*************************************************************************/
+/*  test_physics_2d_determinism.h                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_2D_DETERMINISM_H
+#define TEST_PHYSICS_2D_DETERMINISM_H
+
+#include "core/templates/hashfuncs.h"
+#include "servers/physics_2d/physics_server_2d_sw.h"
+#include "servers/physics_2d/step_2d_sw.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics2DDeterminism {
+
+struct Scene {
+	PhysicsServer2DSW *server = nullptr;
+	RID space;
+	Space2DSW *space_sw = nullptr;
+	RID ground_shape;
+	RID box_shape;
+	RID circle_shape;
+	RID ground;
+	LocalVector<RID> bodies;
+	RID joint;
+};
+
+// A pile of boxes and circles falling on the ground, with a spring between two
+// of them.
+static void create_scene(Scene &r_scene) {
+	PhysicsServer2DSW *server = memnew(PhysicsServer2DSW(false));
+	server->init();
+	r_scene.server = server;
+
+	r_scene.space = server->space_create();
+	server->area_set_param(r_scene.space, PhysicsServer2D::AREA_PARAM_GRAVITY, 98.0);
+	server->area_set_param(r_scene.space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	r_scene.space_sw = static_cast<PhysicsDirectSpaceState2DSW *>(server->space_get_direct_state(r_scene.space))->space;
+	r_scene.space_sw->set_deterministic(true);
+
+	r_scene.ground_shape = server->rectangle_shape_create();
+	server->shape_set_data(r_scene.ground_shape, Vector2(500, 10));
+	r_scene.box_shape = server->rectangle_shape_create();
+	server->shape_set_data(r_scene.box_shape, Vector2(8, 8));
+	r_scene.circle_shape = server->circle_shape_create();
+	server->shape_set_data(r_scene.circle_shape, 6.0);
+
+	r_scene.ground = server->body_create();
+	server->body_set_mode(r_scene.ground, PhysicsServer2D::BODY_MODE_STATIC);
+	server->body_add_shape(r_scene.ground, r_scene.ground_shape);
+	server->body_set_state(r_scene.ground, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(0, 200)));
+	server->body_set_space(r_scene.ground, r_scene.space);
+
+	for (int i = 0; i < 60; i++) {
+		RID body = server->body_create();
+		server->body_add_shape(body, (i % 3) ? r_scene.box_shape : r_scene.circle_shape);
+		server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(i * 0.1, Vector2((i % 10) * 17.0 - 80.0 + (i / 10) * 3.0, -(i / 10) * 20.0)));
+		server->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, (i % 5) - 2.0);
+		server->body_set_space(body, r_scene.space);
+		r_scene.bodies.push_back(body);
+	}
+
+	r_scene.joint = server->joint_create();
+	server->joint_make_damped_spring(r_scene.joint, Vector2(), Vector2(), r_scene.bodies[0], r_scene.bodies[1]);
+}
+
+static void free_scene(Scene &p_scene) {
+	PhysicsServer2DSW *server = p_scene.server;
+	server->free(p_scene.joint);
+	for (uint32_t i = 0; i < p_scene.bodies.size(); i++) {
+		server->free(p_scene.bodies[i]);
+	}
+	server->free(p_scene.ground);
+	server->free(p_scene.ground_shape);
+	server->free(p_scene.box_shape);
+	server->free(p_scene.circle_shape);
+	server->free(p_scene.space);
+
+	server->finish();
+	memdelete(server);
+}
+
+static void step_scene(Scene &p_scene, Step2DSW &p_stepper, int p_from, int p_steps) {
+	const real_t delta = 1.0 / 60.0;
+	for (int i = p_from; i < p_from + p_steps; i++) {
+		p_scene.server->step(delta); // Only flushes shape updates, the space isn't active.
+		p_stepper.step(p_scene.space_sw, delta, 8);
+
+		if (i % 200 == 0) {
+			// Keep things moving, so the bodies don't just fall asleep.
+			p_scene.server->body_apply_central_impulse(p_scene.bodies[(i / 200) % p_scene.bodies.size()], Vector2(0, -500));
+		}
+	}
+}
+
+// Returns a hash of the final state of all bodies.
+static uint32_t simulate(int p_thread_count, int p_steps) {
+	Scene scene;
+	create_scene(scene);
+
+	Step2DSW stepper(p_thread_count);
+	step_scene(scene, stepper, 0, p_steps);
+
+	uint32_t hash = hash_djb2_one_32(0);
+	for (uint32_t i = 0; i < scene.bodies.size(); i++) {
+		Transform2D xform = scene.server->body_get_state(scene.bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM);
+		Vector2 linear_velocity = scene.server->body_get_state(scene.bodies[i], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		real_t angular_velocity = scene.server->body_get_state(scene.bodies[i], PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+		hash = hash_djb2_buffer((const uint8_t *)&xform, sizeof(Transform2D), hash);
+		hash = hash_djb2_buffer((const uint8_t *)&linear_velocity, sizeof(Vector2), hash);
+		hash = hash_djb2_buffer((const uint8_t *)&angular_velocity, sizeof(real_t), hash);
+	}
+
+	free_scene(scene);
+
+	return hash;
+}
+
+static void check_thread_counts(int p_steps) {
+	uint32_t single_thread = simulate(1, p_steps);
+	CHECK_MESSAGE(simulate(1, p_steps) == single_thread, "Running the same simulation twice should give the same results.");
+	CHECK(simulate(2, p_steps) == single_thread);
+	CHECK(simulate(4, p_steps) == single_thread);
+	CHECK(simulate(-1, p_steps) == single_thread);
+}
+
+TEST_CASE("[Physics2D] Deterministic mode gives the same results with any number of threads") {
+	check_thread_counts(300);
+}
+
+// Benchmarks, run them with `--test --no-skip`.
+TEST_CASE_PENDING("[Physics2D][Benchmark] Deterministic mode over a long simulation") {
+	// Small differences can take a while to grow big enough to change the hash.
+	check_thread_counts(10000);
+}
+
+TEST_CASE("[Physics2D] Restoring a saved state replays the same simulation") {
+	Scene scene;
+	create_scene(scene);
+	Step2DSW stepper(1);
+
+	// Let the pile settle, so there are contacts and sleeping bodies. The impulse
+	// at step 400 wakes some of them up again.
+	step_scene(scene, stepper, 0, 350);
+	const Vector<uint8_t> saved = scene.space_sw->save_state();
+
+	step_scene(scene, stepper, 350, 150);
+	const Vector<uint8_t> first_run = scene.space_sw->save_state();
+
+	CHECK(scene.space_sw->restore_state(saved) == OK);
+	CHECK_MESSAGE(scene.space_sw->save_state() == saved, "Saving right after restoring should give the same state.");
+
+	step_scene(scene, stepper, 350, 150);
+	const Vector<uint8_t> second_run = scene.space_sw->save_state();
+
+	CHECK_MESSAGE(second_run == first_run, "Stepping from a restored state should give bit identical results.");
+
+	free_scene(scene);
+}
+
+} // namespace TestPhysics2DDeterminism
+
+#endif // TEST_PHYSICS_2D_DETERMINISM_H
@@ -76,6 +76,10 @@ class TestPhysics3DMainLoop : public MainLoop {
 
 	bool quit;
 
+	bool benchmark = false;
+	int benchmark_frames = 0;
+	uint64_t benchmark_ticks = 0;
+
 protected:
 	RID create_body(PhysicsServer3D::ShapeType p_shape, PhysicsServer3D::BodyMode p_body, const Transform3D p_location, bool p_active_default = true, const Transform3D &p_shape_xform = Transform3D()) {
 		RenderingServer *vs = RenderingServer::get_singleton();
@@ -310,7 +314,11 @@ public:
 		gxf.basis.scale(Vector3(1.4, 0.4, 1.4));
 		gxf.origin = Vector3(-2, 1, -2);
 		make_grid(5, 5, 2.5, 1, gxf);
-		test_fall();
+		if (OS::get_singleton()->get_cmdline_args().find("--sleeping-islands")) {
+			test_sleeping_islands();
+		} else {
+			test_fall();
+		}
 		quit = false;
 	}
 	virtual bool physics_process(float p_time) override {
@@ -329,6 +337,17 @@ public:
 		RenderingServer *vs = RenderingServer::get_singleton();
 		vs->camera_set_transform(camera, cameratr);
 
+		if (benchmark) {
+			benchmark_frames++;
+			if (benchmark_frames == 120) {
+				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+				PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+				print_line(vformat("%.2f ms per frame, %d active objects, %d islands.", (ticks - benchmark_ticks) / 120000.0, ps->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS), ps->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT)));
+				benchmark_ticks = ticks;
+				benchmark_frames = 0;
+			}
+		}
+
 		return quit;
 	}
 	virtual void finalize() override {
@@ -394,6 +413,32 @@ public:
 		create_static_plane(Plane(Vector3(0, 1, 0), -1));
 	}
 
+	void test_sleeping_islands() {
+		// 50k boxes resting in stacks that start asleep, and 500 boxes falling on a few of them.
+		// Frame times should stay close to what a scene with only the 500 moving boxes costs.
+		const int stack_count = 5000;
+		const int stack_height = 10;
+		const int stacks_per_row = 71;
+
+		for (int i = 0; i < stack_count; i++) {
+			real_t x = (i % stacks_per_row - stacks_per_row / 2) * 2.0;
+			real_t z = (i / stacks_per_row - stacks_per_row / 2) * 2.0;
+			for (int j = 0; j < stack_height; j++) {
+				create_body(PhysicsServer3D::SHAPE_BOX, PhysicsServer3D::BODY_MODE_DYNAMIC, Transform3D(Basis(), Vector3(x, -0.5 + j, z)), false);
+			}
+		}
+
+		for (int i = 0; i < 500; i++) {
+			Vector3 pos((i % 10 - 5) * 2.0, stack_height + 2.0 + (i / 10) * 1.1, 0.0);
+			create_body(PhysicsServer3D::SHAPE_BOX, PhysicsServer3D::BODY_MODE_DYNAMIC, Transform3D(Basis(), pos), true);
+		}
+
+		create_static_plane(Plane(Vector3(0, 1, 0), -1));
+
+		benchmark = true;
+		benchmark_ticks = OS::get_singleton()->get_ticks_usec();
+	}
+
 	void test_activate() {
 		create_body(PhysicsServer3D::SHAPE_BOX, PhysicsServer3D::BODY_MODE_DYNAMIC, Transform3D(Basis(), Vector3(0, 2, 0)), true);
 		create_static_plane(Plane(Vector3(0, 1, 0), -1));
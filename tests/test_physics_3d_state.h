@@ -0,0 +1,123 @@
+/*************************************************************************/
+/*  test_physics_3d_state.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_3D_STATE_H
+#define TEST_PHYSICS_3D_STATE_H
+
+#include "servers/physics_3d/physics_server_3d_sw.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics3DState {
+
+TEST_CASE("[Physics3D] Restoring a saved state replays the same simulation") {
+	PhysicsServer3DSW *server = memnew(PhysicsServer3DSW(false));
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+	server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID ground_shape = server->box_shape_create();
+	server->shape_set_data(ground_shape, Vector3(50, 1, 50));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = server->sphere_shape_create();
+	server->shape_set_data(sphere_shape, 0.4);
+
+	RID ground = server->body_create();
+	server->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(ground, ground_shape);
+	server->body_set_state(ground, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	server->body_set_space(ground, space);
+
+	// Two piles, so there are several islands.
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 40; i++) {
+		RID body = server->body_create();
+		server->body_add_shape(body, (i % 3) ? box_shape : sphere_shape);
+		Vector3 origin((i % 2) * 10.0 + (i % 4) * 0.3, 0.5 + (i / 2) * 1.1, (i % 5) * 0.2);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), i * 0.1), origin));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	RID joint = server->joint_create();
+	server->joint_make_pin(joint, bodies[0], Vector3(0, 0.5, 0), bodies[2], Vector3(0, -0.5, 0));
+
+	const real_t delta = 1.0 / 60.0;
+
+	// Let the piles fall and settle a bit, so there are contacts and some bodies
+	// are asleep, then knock one of them over after saving.
+	for (int i = 0; i < 240; i++) {
+		server->step(delta);
+	}
+	const Vector<uint8_t> saved = server->space_save_state(space);
+
+	for (int i = 0; i < 120; i++) {
+		if (i == 30) {
+			server->body_apply_central_impulse(bodies[1], Vector3(3, 0, 0));
+		}
+		server->step(delta);
+	}
+	const Vector<uint8_t> first_run = server->space_save_state(space);
+
+	CHECK(server->space_restore_state(space, saved) == OK);
+	CHECK_MESSAGE(server->space_save_state(space) == saved, "Saving right after restoring should give the same state.");
+
+	for (int i = 0; i < 120; i++) {
+		if (i == 30) {
+			server->body_apply_central_impulse(bodies[1], Vector3(3, 0, 0));
+		}
+		server->step(delta);
+	}
+	const Vector<uint8_t> second_run = server->space_save_state(space);
+
+	CHECK_MESSAGE(second_run == first_run, "Stepping from a restored state should give bit identical results.");
+
+	server->free(joint);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		server->free(bodies[i]);
+	}
+	server->free(ground);
+	server->free(ground_shape);
+	server->free(box_shape);
+	server->free(sphere_shape);
+	server->free(space);
+
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestPhysics3DState
+
+#endif // TEST_PHYSICS_3D_STATE_H
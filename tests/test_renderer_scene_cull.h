@@ -0,0 +1,232 @@
+/*************************************************************************/
+/*  test_renderer_scene_cull.h                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+typedef RendererSceneCull::InstanceBounds InstanceBounds;
+typedef RendererSceneCull::InstanceBoundsArray InstanceBoundsArray;
+typedef RendererSceneCull::Frustum Frustum;
+
+static InstanceBounds random_bounds(RandomPCG &r_rng, real_t p_extents) {
+	Vector3 position = Vector3(r_rng.randf() * 2.0 - 1.0, r_rng.randf() * 2.0 - 1.0, r_rng.randf() * 2.0 - 1.0) * p_extents;
+	Vector3 size = Vector3(r_rng.randf(), r_rng.randf(), r_rng.randf()) * 4.0;
+	return InstanceBounds(AABB(position, size));
+}
+
+static Frustum camera_frustum(const Vector3 &p_position, real_t p_yaw) {
+	CameraMatrix projection;
+	projection.set_perspective(70.0, 16.0 / 9.0, 0.05, 500.0);
+	Transform3D transform = Transform3D(Basis(Vector3(0, 1, 0), p_yaw), p_position);
+	return Frustum(projection.get_projection_planes(transform));
+}
+
+static uint32_t cull_frustum_scalar(const InstanceBoundsArray &p_array, uint64_t p_block, const Frustum &p_frustum) {
+	uint32_t inside = 0;
+	for (uint32_t i = 0; i < InstanceBoundsArray::BLOCK_SIZE; i++) {
+		uint64_t index = p_block * InstanceBoundsArray::BLOCK_SIZE + i;
+		if (index < p_array.size() && p_array[index].in_frustum(p_frustum)) {
+			inside |= 1 << i;
+		}
+	}
+	return inside;
+}
+
+static bool bounds_equal(const InstanceBounds &p_a, const InstanceBounds &p_b) {
+	for (int i = 0; i < 6; i++) {
+		if (p_a.bounds[i] != p_b.bounds[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[RendererSceneCull] Instance bounds blocks match per instance frustum tests") {
+	PagedArrayPool<InstanceBoundsArray::Block> page_pool;
+	InstanceBoundsArray array;
+	array.set_page_pool(&page_pool);
+
+	RandomPCG rng(42);
+	LocalVector<InstanceBounds> reference;
+	for (int i = 0; i < 1001; i++) {
+		InstanceBounds bounds = random_bounds(rng, 100.0);
+		array.push_back(bounds, 1);
+		reference.push_back(bounds);
+	}
+
+	// Remove the same way instances are unpaired, swapping in the last one.
+	for (int i = 0; i < 100; i++) {
+		uint64_t index = rng.rand() % array.size();
+		array.copy(array.size() - 1, index);
+		reference[index] = reference[reference.size() - 1];
+		array.pop_back();
+		reference.resize(reference.size() - 1);
+	}
+	array.set(7, random_bounds(rng, 100.0));
+	reference[7] = array[7];
+
+	REQUIRE(array.size() == reference.size());
+	bool all_equal = true;
+	for (uint32_t i = 0; i < reference.size(); i++) {
+		all_equal = all_equal && bounds_equal(array[i], reference[i]);
+	}
+	CHECK_MESSAGE(all_equal, "Bounds should survive being moved around the blocks.");
+
+	uint64_t block_count = (array.size() + InstanceBoundsArray::BLOCK_SIZE - 1) / InstanceBoundsArray::BLOCK_SIZE;
+	uint64_t last_block_mask = (1 << (array.size() - (block_count - 1) * InstanceBoundsArray::BLOCK_SIZE)) - 1;
+	int mismatches = 0;
+	int inside = 0;
+	for (int f = 0; f < 8; f++) {
+		Frustum frustum = camera_frustum(Vector3(0, 0, 0), Math_TAU * f / 8.0);
+		for (uint64_t i = 0; i < block_count; i++) {
+			uint32_t expected = cull_frustum_scalar(array, i, frustum);
+			uint32_t result = array.cull_frustum(i, frustum);
+			if (i == block_count - 1) {
+				result &= last_block_mask; // Unused lanes are never read.
+			}
+			if (result != expected) {
+				mismatches++;
+			}
+			inside += __builtin_popcount(expected);
+		}
+	}
+	CHECK_MESSAGE(inside > 0, "Some instances should be inside the test frustums.");
+	CHECK(mismatches == 0);
+
+	array.reset();
+}
+
+TEST_CASE("[RendererSceneCull] Instance bounds blocks test layer masks") {
+	PagedArrayPool<InstanceBoundsArray::Block> page_pool;
+	InstanceBoundsArray array;
+	array.set_page_pool(&page_pool);
+
+	for (int i = 0; i < 6; i++) {
+		array.push_back(InstanceBounds(AABB()), 1 << i);
+	}
+	CHECK(array.cull_layers(0, 1 | 4) == 0b0101);
+	CHECK(array.cull_layers(1, 0xFFFFFFFF) == 0b0011);
+	CHECK(array.cull_layers(1, 1 << 5) == 0b0010);
+
+	array.set_layer_mask(2, 1 << 5);
+	CHECK(array.cull_layers(0, 1 << 5) == 0b0100);
+
+	array.copy(5, 0);
+	CHECK(array.cull_layers(0, 1 << 5) == 0b0101);
+
+	array.reset();
+}
+
+TEST_CASE("[RendererSceneCull] HLOD proxies switch where their error reaches the LOD threshold") {
+	CameraMatrix projection;
+	projection.set_perspective(70.0, 16.0 / 9.0, 0.05, 500.0);
+	const float threshold = 1.0 / 1024.0;
+	const float error = 0.25;
+
+	float switch_distance = error * RendererSceneCull::_get_hlod_distance_scale(projection, threshold);
+	CHECK(switch_distance > 0.0);
+	// At the switch distance the error projects to exactly the threshold, like mesh LOD selection.
+	CHECK(error / (switch_distance * projection.get_lod_multiplier()) == doctest::Approx(threshold));
+
+	CHECK_MESSAGE(
+			error * RendererSceneCull::_get_hlod_distance_scale(projection, 0.0) > 1e6,
+			"Proxies should never be used when mesh LOD is disabled.");
+}
+
+static void benchmark_cull(int p_count, int p_cascades) {
+	PagedArrayPool<InstanceBoundsArray::Block> page_pool;
+	InstanceBoundsArray array;
+	array.set_page_pool(&page_pool);
+
+	RandomPCG rng(1234);
+	for (int i = 0; i < p_count; i++) {
+		array.push_back(random_bounds(rng, 1000.0), 1);
+	}
+
+	Frustum camera = camera_frustum(Vector3(), 0.0);
+	LocalVector<Frustum> cascades;
+	for (int i = 0; i < p_cascades; i++) {
+		// Directional shadow cascades are orthogonal boxes of growing size.
+		CameraMatrix projection;
+		projection.set_orthogonal(50.0 * (i + 1), 1.0, 0.0, 500.0);
+		Transform3D transform = Transform3D(Basis(Vector3(1, 0, 0), -Math_PI / 3.0), Vector3(0, 200, 0));
+		cascades.push_back(Frustum(projection.get_projection_planes(transform)));
+	}
+
+	uint64_t block_count = (array.size() + InstanceBoundsArray::BLOCK_SIZE - 1) / InstanceBoundsArray::BLOCK_SIZE;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t visible_scalar = 0;
+	for (uint64_t i = 0; i < array.size(); i++) {
+		InstanceBounds bounds = array[i];
+		if (bounds.in_frustum(camera)) {
+			visible_scalar++;
+		}
+		for (uint32_t j = 0; j < cascades.size(); j++) {
+			if (bounds.in_frustum(cascades[j])) {
+				visible_scalar++;
+			}
+		}
+	}
+	uint64_t scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t visible_blocks = 0;
+	for (uint64_t i = 0; i < block_count; i++) {
+		visible_blocks += __builtin_popcount(array.cull_layers(i, 1) & array.cull_frustum(i, camera));
+		for (uint32_t j = 0; j < cascades.size(); j++) {
+			visible_blocks += __builtin_popcount(array.cull_frustum(i, cascades[j]));
+		}
+	}
+	uint64_t block_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(p_count, " instances, ", p_cascades, " cascades: ", scalar_usec, " usec testing each instance, ", block_usec, " usec testing blocks of ", InstanceBoundsArray::BLOCK_SIZE, ".");
+	CHECK(visible_scalar == visible_blocks);
+
+	array.reset();
+}
+
+// Benchmarks, run them with `--test --no-skip`.
+TEST_CASE_PENDING("[RendererSceneCull] Benchmark culling 1M instances") {
+	benchmark_cull(1000000, 0);
+	benchmark_cull(1000000, 4);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  test_stream_texture_2d.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_STREAM_TEXTURE_2D_H
+#define TEST_STREAM_TEXTURE_2D_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/image.h"
+#include "core/os/os.h"
+#include "scene/resources/texture.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStreamTexture2D {
+
+static String save_image_data(const Ref<Image> &p_image) {
+	// Same layout as the uncompressed / VRAM compressed data written by the texture importer.
+	const String path = OS::get_singleton()->get_cache_path().plus_file("stream_texture_mipmaps.bin");
+	FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_32(StreamTexture2D::DATA_FORMAT_IMAGE);
+	f->store_16(p_image->get_width());
+	f->store_16(p_image->get_height());
+	f->store_32(p_image->get_mipmap_count());
+	f->store_32(p_image->get_format());
+	Vector<uint8_t> data = p_image->get_data();
+	f->store_buffer(data.ptr(), data.size());
+	f->close();
+	return path;
+}
+
+TEST_CASE("[StreamTexture2D] Size limit reads only the mipmaps that fit") {
+	Ref<Image> image;
+	image.instantiate();
+	image->create(256, 128, false, Image::FORMAT_RGBA8);
+	image->fill(Color(1, 0, 0));
+	image->generate_mipmaps();
+	const String path = save_image_data(image);
+
+	FileAccessRef f = FileAccess::open(path, FileAccess::READ);
+	Ref<Image> full = StreamTexture2D::load_image_from_file(f, 0);
+	REQUIRE(full.is_valid());
+	CHECK(full->get_width() == 256);
+	CHECK(full->get_height() == 128);
+	CHECK(full->get_data() == image->get_data());
+
+	f->seek(0);
+	Ref<Image> limited = StreamTexture2D::load_image_from_file(f, 64);
+	REQUIRE(limited.is_valid());
+	CHECK_MESSAGE(limited->get_width() == 64, "The largest mipmap that fits the limit should be loaded.");
+	CHECK(limited->get_height() == 32);
+	CHECK(limited->has_mipmaps());
+	Vector<uint8_t> data = image->get_data();
+	CHECK_MESSAGE(
+			limited->get_data() == data.subarray(image->get_mipmap_offset(2), data.size() - 1),
+			"The loaded mipmaps should match the tail of the original mipmap chain.");
+
+	f->close();
+	DirAccess::remove_file_or_error(path);
+}
+
+} // namespace TestStreamTexture2D
+
+#endif // TEST_STREAM_TEXTURE_2D_H